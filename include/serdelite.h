@@ -28,16 +28,23 @@
 
 // Base Interfaces
 #include "serdelite/Serializable.h"
+#include "serdelite/Optional.h"
+#include "serdelite/ChangeTracking.h"
+#include "serdelite/Schema.h"
+#include "serdelite/Decimal.h"
 
 // Memory & Storage
 #include "serdelite/ByteBuffer.h"
+#include "serdelite/BufferStorage.h"
 
 // Binary Streaming Logic
 #include "serdelite/ByteStream.h"
+#include "serdelite/Migration.h"
 
-// JSON Construction & Visualization
+// JSON Construction, Decoding & Visualization
 #include "serdelite/JsonBuffer.h"
 #include "serdelite/JsonStream.h"
+#include "serdelite/JsonReader.h"
 
 /**
  * @mainpage SerDeLite Serialization Library
@@ -0,0 +1,158 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#ifndef SERDELITE_BUFFERSTORAGE_H
+#define SERDELITE_BUFFERSTORAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+
+/**
+ * @enum BufferMemory
+ * @brief The kinds of memory a @ref BufferStorage can allocate.
+ *
+ * `CacheAligned`: Heap memory starting on a 64-byte cache line boundary.
+ *
+ * `PageAligned`: An anonymous mapping starting on a page boundary, with the
+ * capacity rounded up to whole pages, as required for `O_DIRECT` file I/O.
+ *
+ * `HugePages`: A mapping backed by 2 MB pages, which cuts TLB misses when
+ * large snapshot buffers are walked end to end.
+ */
+enum class BufferMemory : uint8_t { CacheAligned, PageAligned, HugePages };
+
+/**
+ * @name Memory Allocation
+ * Owning storage for the memory a ByteBuffer operates on.
+ * @{
+ */
+
+/**
+ * @class BufferStorage
+ * @brief Allocates aligned memory for a `ByteBuffer` and frees it on destruction.
+ *
+ * `ByteBuffer` never allocates; this class is the optional owner for callers
+ * that want aligned or huge-page memory rather than a plain array:
+ *
+ * @code
+ * serdelite::BufferStorage storage(64 << 20, serdelite::BufferMemory::HugePages);
+ * serdelite::ByteBuffer buffer(storage.getBytes(), storage.getCapacity(),
+ * 								serdelite::Endian::Big, serdelite::ZeroPolicy::None);
+ * @endcode
+ *
+ * Huge pages are requested with `MAP_HUGETLB` first. When none are reserved,
+ * a 2 MB aligned mapping is advised with `madvise(MADV_HUGEPAGE)` so that
+ * transparent huge pages can back it; failing that, plain pages are used.
+ * On Windows, `VirtualAlloc` with `MEM_LARGE_PAGES` is tried instead.
+ * Building the library with `SERDELITE_NO_HUGE_PAGES` skips huge pages
+ * altogether and always takes the plain page fallback.
+ *
+ * @note Mapped memory (`PageAligned` and `HugePages`) comes zeroed from the
+ * 		 operating system, so pair it with `ZeroPolicy::None`.
+ * @note The storage must outlive every `ByteBuffer` built on it.
+ */
+class BufferStorage {
+public:
+	/**
+	 * @name Lifecycle
+	 * @{
+	 */
+
+	/**
+	 * @brief Allocates at least `capacity` bytes of the given kind.
+	 * @param capacity The minimum number of bytes needed.
+	 * @param memory The preferred kind of memory; huge pages fall back to
+	 * 				 plain pages when the system has none to give.
+	 * @note Check `isValid()`: on failure no memory is held.
+	 */
+	BufferStorage(size_t capacity,
+				  BufferMemory memory = BufferMemory::CacheAligned);
+
+	/**
+	 * @brief Takes over the memory of another storage, leaving it empty.
+	 */
+	BufferStorage(BufferStorage&& other);
+
+	/**
+	 * @brief Frees the held memory, then takes over that of `other`.
+	 */
+	BufferStorage& operator=(BufferStorage&& other);
+
+	/**
+	 * @brief Returns the memory to the system.
+	 */
+	~BufferStorage();
+
+	BufferStorage(const BufferStorage&) = delete;
+	BufferStorage& operator=(const BufferStorage&) = delete;
+
+	/** @} */
+
+
+	/**
+	 * @name Getters & Inspection
+	 * @{
+	 */
+
+	/**
+	 * @brief Check if the allocation succeeded
+	 * @return Returns `true` if memory is held
+	 */
+	bool isValid() const;
+
+	/**
+	 * @brief Getter method which gives read/write access to the memory
+	 * @return Returns the aligned start of the memory, or `nullptr`
+	 */
+	uint8_t* getBytes();
+
+	/**
+	 * @brief Getter method which gives read-only access to the memory
+	 * @return Returns the aligned start of the memory, or `nullptr`
+	 */
+	const uint8_t* getBytes() const;
+
+	/**
+	 * @brief Getter method which gives the usable size of the memory
+	 * @return Returns the requested capacity rounded up to the alignment
+	 * 		   (cache line, page or huge page), or `0` if invalid
+	 */
+	size_t getCapacity() const;
+
+	/**
+	 * @brief Getter method which gives the kind of memory actually obtained
+	 * @return Returns `HugePages` only if huge pages were mapped or advised,
+	 * 		   `PageAligned` after falling back
+	 */
+	BufferMemory getMemory() const;
+
+	/**
+	 * @brief Getter method which gives the page size of the system
+	 * @return Returns the size of a regular page in bytes
+	 */
+	static size_t getPageSize();
+
+	/** @} */
+
+private:
+	uint8_t* bytes;
+	size_t capacity;
+	BufferMemory memory;
+	bool isMapped;	// Released with munmap/VirtualFree rather than the heap
+
+	void release();
+};
+
+/** @} */
+
+} // namespace serdelite
+
+#endif
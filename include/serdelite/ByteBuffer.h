@@ -13,6 +13,7 @@
 #include "Common.h"
 #include <stddef.h>
 #include <stdint.h>
+#include <functional>
 
 namespace serdelite {
 
@@ -23,6 +24,34 @@ namespace serdelite {
  * @{
  */
 
+/**
+ * @enum Base64Alphabet
+ * @brief The Base64 alphabets of RFC 4648, which differ in the characters
+ * 		  for the values 62 and 63.
+ * 
+ * `Standard`: `+` and `/`, as used by MIME and most JSON APIs.
+ * 
+ * `UrlSafe`: `-` and `_`, safe in URLs, file names and HTTP headers.
+ */
+enum class Base64Alphabet : uint8_t { Standard, UrlSafe };
+
+/**
+ * @enum ZeroPolicy
+ * @brief Controls when a `ByteBuffer` clears its memory to zero.
+ * 
+ * `Full`: The whole capacity is zeroed at construction and by `erase()`.
+ * 
+ * `WrittenPrefix`: Nothing is zeroed at construction; `erase()` zeroes only the
+ * bytes that were ever written (up to the largest length reached). Old message
+ * bytes never survive an erase, without paying for untouched capacity.
+ * 
+ * `None`: Nothing is ever zeroed; `erase()` only resets the cursor like `clear()`.
+ * 
+ * Bytes beyond the length are never read by the library, so skipping the
+ * zeroing is safe; only code peeking at them through `getRawBytes()` can tell.
+ */
+enum class ZeroPolicy : uint8_t { Full, WrittenPrefix, None };
+
 /**
  * @class ByteBuffer
  * @brief A wrapper for raw memory buffers providing safe access and data conversion.
@@ -48,13 +77,18 @@ public:
 	 * @param bufferCapacity The maximum capacity of memory
 	 * @param endianOrder The endian order in which data should be written and
 	 * 					  retrieved
+	 * @param zeroPolicy When the memory is zeroed, see @ref ZeroPolicy. Pick
+	 * 					 `None` or `WrittenPrefix` for large buffers on hot
+	 * 					 paths, where zeroing the capacity costs a full write
+	 * 					 of it per construction
 	 * 
 	 * @note The `ByteBuffer` object is not reponsible for the lifecycle of the
 	 * 		 raw-memory buffer
 	 */
 	ByteBuffer(uint8_t* buffer,
                size_t bufferCapacity,
-               Endian endianOrder = Endian::Big);
+               Endian endianOrder = Endian::Big,
+               ZeroPolicy zeroPolicy = ZeroPolicy::Full);
 
 	/**
 	 * @brief Set the Endian Order of `ByteBuffer` object
@@ -110,6 +144,7 @@ public:
 	 * 		 is going to take 2-hex characters
 	 * 		 For e.g to represent the bytes "1001 1010" the hexadecimal
 	 * 		 representation for this will be "9A"
+	 * 		 The conversion runs 16 (SSSE3) or 32 (AVX2) bytes per step
 	 */
 	bool toHex(char* dest, size_t destCapacity) const;
 
@@ -117,9 +152,95 @@ public:
 	 * @brief This function writes the bytes into buffer from the given hexadecimal string
 	 * @param hexStr The hexadecimal string
 	 * @return Returns `true` if the write operation is successful, `false` otherwise
+	 * 
+	 * @note Digits may be in either case; spaces, colons and dashes between
+	 * 		 pairs are skipped. Runs of digits are decoded 16 or 32 at a time
 	 */
 	bool fromHex(const char* hexStr);
 
+	/**
+	 * @brief Writes the bytes of a hexadecimal string into the buffer and
+	 * 		  reports where decoding failed
+	 * 
+	 * @param hexStr The hexadecimal string
+	 * @param errorIndex Receives the index in `hexStr` of the first invalid
+	 * 					 character, of a dangling last digit, or of the first
+	 * 					 pair that did not fit; set to the string length on
+	 * 					 success
+	 * 
+	 * @return Returns `true` if the write operation is successful, `false`
+	 * 		   otherwise (the buffer is left untouched then)
+	 */
+	bool fromHex(const char* hexStr, size_t& errorIndex);
+
+	/**
+	 * @brief Getter method which gives the length of the text written by `toBase64()`
+	 * @param padded `true` if the text is padded to 4-character groups with `=`
+	 * @return Returns the number of characters, without the null terminator
+	 */
+	size_t getBase64Length(bool padded = true) const;
+
+	/**
+	 * @brief Converts the raw bytes into a Base64 string into the provided buffer
+	 * 
+	 * @param dest The destination buffer where the converted value
+	 * 			   is going to be stored
+	 * @param destCapacity The maximum capacity of destination buffer
+	 * @param alphabet The characters to use for the values 62 and 63
+	 * @param padded `true` to pad the last group with `=`
+	 * 
+	 * @return Returns `true` if the conversion is successfull, `false` if the 
+	 * 		   `dest` is not valid or `destCapacity` is insufficient
+	 * 
+	 * @note The required capacity is `getBase64Length(padded) + 1`, about 4/3
+	 * 		 of the length instead of the 2x of `toHex()`. The conversion runs
+	 * 		 12 (SSSE3) or 24 (AVX2) bytes per step
+	 */
+	bool toBase64(char* dest, size_t destCapacity,
+				  Base64Alphabet alphabet = Base64Alphabet::Standard,
+				  bool padded = true) const;
+
+	/**
+	 * @brief This function writes the bytes into buffer from the given Base64 string
+	 * @param text The Base64 string
+	 * @param alphabet The alphabet the string is written in
+	 * @param padded `true` if the string must be padded to 4-character groups,
+	 * 				 `false` if it must not contain any `=`
+	 * @return Returns `true` if the write operation is successful, `false` otherwise
+	 * 
+	 * @note Decoding is strict: characters of the other alphabet, whitespace,
+	 * 		 misplaced padding and non-zero bits after the last byte are all
+	 * 		 rejected, so every byte sequence has exactly one accepted encoding
+	 */
+	bool fromBase64(const char* text,
+					Base64Alphabet alphabet = Base64Alphabet::Standard,
+					bool padded = true);
+
+	/**
+	 * @brief Writes the bytes of a Base64 string into the buffer and reports
+	 * 		  where decoding failed
+	 * 
+	 * @param text The Base64 string
+	 * @param errorIndex Receives the index in `text` of the first invalid
+	 * 					 character, of an incomplete last group, or of the first
+	 * 					 group that did not fit; set to the string length on
+	 * 					 success
+	 * @param alphabet The alphabet the string is written in
+	 * @param padded `true` if the string must be padded to 4-character groups
+	 * 
+	 * @return Returns `true` if the write operation is successful, `false`
+	 * 		   otherwise (the length of the buffer is left untouched then)
+	 */
+	bool fromBase64(const char* text, size_t& errorIndex,
+					Base64Alphabet alphabet = Base64Alphabet::Standard,
+					bool padded = true);
+
+	/**
+	 * @brief Receives the text of a hex dump in pieces of whole lines.
+	 * @return The sink returns `false` to stop the dump.
+	 */
+	typedef std::function<bool(const char* text, size_t len)> TextSink;
+
 	/**
 	 * @brief Outputs a formatted hexadecimal and ASCII representation of the buffer
 	 * 		  to the console.
@@ -128,10 +249,49 @@ public:
 	 * wide table. Each row displays the memory offset, the hexadecimal values of the bytes,
 	 * and a "sanitized" ASCII string where non-printable characters are replaced by dots (.).
 	 * 
-	 * @note This function prints directly to stdout (standard output).
+	 * @note This function prints directly to stdout (standard output), see
+	 * 		 `hexDump()` for the formatting.
 	 */
 	void dump() const;
 
+	/**
+	 * @brief Getter method which gives the length of the text written by `hexDump()`
+	 * @return Returns the number of characters, or `0` for an empty buffer
+	 */
+	size_t getHexDumpLength() const;
+
+	/**
+	 * @brief Appends a hex dump of the buffer to another `ByteBuffer`
+	 * 
+	 * Every 16 bytes become one line holding the offset, the bytes in hex and
+	 * their printable characters, e.g.
+	 * `00000010: 48 65 6C 6C 6F 00 ...  | Hello.`. The offset column is 8
+	 * digits wide, or 16 for buffers above 4 GiB. Whole rows are formatted
+	 * in one pass through lookup tables (`pshufb` with SSSE3), never with
+	 * `printf`.
+	 * 
+	 * @param dest The buffer receiving the text (no null terminator is added)
+	 * 
+	 * @return Returns `true` if the dump is written, `false` if `dest` is this
+	 * 		   buffer or lacks the `getHexDumpLength()` characters needed (`dest`
+	 * 		   is left untouched then)
+	 */
+	bool hexDump(ByteBuffer& dest) const;
+
+	/**
+	 * @brief Streams a hex dump of the buffer to a sink
+	 * 
+	 * The lines of `hexDump(ByteBuffer&)` are formatted into a small stack
+	 * buffer and handed over a few kilobytes at a time, so dumps of any size
+	 * need no allocation.
+	 * 
+	 * @param sink Receives the text, e.g. a socket or log writer
+	 * 
+	 * @return Returns `true` if the whole dump was accepted, `false` if the
+	 * 		   sink stopped it
+	 */
+	bool hexDump(const TextSink& sink) const;
+
 	/** @} */
 
 	/**
@@ -169,9 +329,55 @@ public:
 	/**
 	 * @brief Erase the data and resets the cursor of `ByteBuffer`
 	 * @warning If you want to just resets the cursor use `clear()` method
+	 * @note How much is zeroed depends on the @ref ZeroPolicy: the whole
+	 * 		 capacity, the bytes written so far, or nothing
 	 */
 	void erase();
 
+	/**
+	 * @brief Gives a view of a sub-range of the data, without copying it
+	 *
+	 * The view is a `ByteBuffer` over the same memory whose data (and capacity)
+	 * is exactly the requested range, so a `ByteStream` built on it reads within
+	 * those bounds only. It keeps the endian order and never zeroes anything:
+	 *
+	 * @code
+	 * serdelite::ByteBuffer frame = batch;
+	 * if (batch.slice(offset, frameLength, frame)) {
+	 * 	serdelite::ByteStream message(frame);
+	 * 	// ... read one message
+	 * }
+	 * @endcode
+	 *
+	 * @param offset The index of the first byte of the range
+	 * @param len The number of bytes in the range
+	 * @param[out] view Receives the view
+	 * @return Returns `true` if the view is given, `false` if the range goes
+	 * 		   beyond the data of this buffer (`view` is untouched then)
+	 *
+	 * @note The memory is shared: writing through the view (after `clear()`)
+	 * 		 overwrites the range in place, and the view must not outlive the
+	 * 		 memory of this buffer.
+	 */
+	bool slice(size_t offset, size_t len, ByteBuffer& view);
+
+	/**
+	 * @brief Gives a view of a sub-range of the data of a read-only buffer
+	 *
+	 * Same as the non-const overload, for buffers received by const reference.
+	 *
+	 * @param offset The index of the first byte of the range
+	 * @param len The number of bytes in the range
+	 * @param[out] view Receives the view
+	 * @return Returns `true` if the view is given, `false` if the range goes
+	 * 		   beyond the data of this buffer (`view` is untouched then)
+	 *
+	 * @warning The view can only be read: `ByteBuffer` has no read-only form,
+	 * 			so nothing stops writes through it, but they would modify
+	 * 			memory the caller handed over as const.
+	 */
+	bool slice(size_t offset, size_t len, ByteBuffer& view) const;
+
 	/** @} */
 
 	/**
@@ -237,6 +443,12 @@ public:
 	 */
 	Endian getEndianOrder() const;
 
+	/**
+	 * @brief Getter method which gives the zeroing policy of `ByteBuffer`
+	 * @return Returns the @ref ZeroPolicy given at construction
+	 */
+	ZeroPolicy getZeroPolicy() const;
+
 	/** @} */
 
 
@@ -245,6 +457,10 @@ private:
 	size_t length;
 	size_t capacity;
 	Endian order;
+	ZeroPolicy zeroing;
+	size_t highWaterMark;	// Largest length left behind by a shrink
+
+	void recordHighWater();
 
 	/**
 	 * @brief This function converts the a single hexadecimal character into a nibble(4-bit)
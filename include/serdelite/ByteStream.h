@@ -13,8 +13,19 @@
 #include "Version.h"
 #include "ByteBuffer.h"
 #include "Serializable.h"
+#include "Optional.h"
+#include "Schema.h"
+#include "Decimal.h"
 
 #include <stddef.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace serdelite {
 
@@ -25,6 +36,29 @@ namespace serdelite {
  * @{
  */
 
+/**
+ * @brief Trait selecting the element types that container helpers copy in bulk.
+ * 
+ * Arithmetic types are stored as raw scalars in the buffer's endian order;
+ * `bool` is excluded because `std::vector<bool>` has no contiguous storage.
+ */
+template <typename T>
+struct IsBulkScalar
+	: std::integral_constant<bool, std::is_arithmetic<T>::value &&
+								   !std::is_same<T, bool>::value> {};
+
+/**
+ * @enum IntArrayCodec
+ * @brief Encodings available for the packed integer array methods of `ByteStream`.
+ * 
+ * `FrameOfReference`: Every block stores its minimum value and bit-packs the
+ * offsets from it. Best for values clustered in a narrow range (e.g. item IDs).
+ * 
+ * `Delta`: Every block bit-packs the differences between consecutive values.
+ * Best for sorted data (e.g. sorted entity IDs); unsorted data still round-trips.
+ */
+enum class IntArrayCodec : uint8_t { FrameOfReference = 1, Delta = 2 };
+
 /**
  * @class ByteStream
  * @brief A stream-oriented interface for reading and writing binary data.
@@ -126,6 +160,62 @@ public:
 	 */
 	bool readObject(ByteSerializable& obj);
 
+	/**
+	 * @brief Writes the presence header of an object with optional fields.
+	 * 
+	 * The mask takes `ceil(fieldCount / 8)` bytes and should be written before
+	 * the object's fields; afterwards only the present optional fields are written.
+	 * 
+	 * @param mask The mask describing which optional fields follow.
+	 * @return Returns `true` if the mask was written, `false` if buffer is full.
+	 */
+	bool writePresenceMask(const PresenceMask& mask);
+
+	/**
+	 * @brief Reads the presence header written by `writePresenceMask`.
+	 * @param[in,out] mask A mask constructed with the same field count as the
+	 * 					   writer's; its bits are replaced by the stored ones.
+	 * @return Returns `true` if the mask was read, `false` if the stream is
+	 * 		   truncated or bits beyond the field count are set.
+	 */
+	bool readPresenceMask(PresenceMask& mask);
+
+	/**
+	 * @brief Serializes an array of objects, collapsing runs of identical elements.
+	 * 
+	 * Each run of identical elements is stored once after a varint header, where
+	 * two elements are identical when their encoded bytes match. Elements that
+	 * do not repeat are grouped into literal runs of up to 63 elements behind a
+	 * one-byte header, so unrepeated data grows by at most one byte per 63
+	 * elements. Arrays dominated by repeated records, such as empty inventory
+	 * slots or tile maps, shrink accordingly.
+	 * 
+	 * @tparam T A ByteSerializable type.
+	 * @param items Pointer to the array of objects.
+	 * @param count Number of objects in the array.
+	 * @return Returns `true` if the array was successfully written, `false` otherwise.
+	 * @note Elements are compared outside the buffer, so a buffer that exactly
+	 * 		 fits the encoding is enough.
+	 */
+	template <typename T>
+	bool writeRunLengthArray(const T* items, size_t count);
+
+	/**
+	 * @brief Deserializes an array written by `writeRunLengthArray`.
+	 * 
+	 * A repeated run is decoded once and then copied into the remaining slots of
+	 * the run; a literal run is decoded element by element.
+	 * 
+	 * @tparam T A ByteSerializable type that is copy-assignable.
+	 * @param[out] dest Pointer to the array that receives the objects.
+	 * @param destCapacity The maximum number of objects `dest` can hold.
+	 * @param[out] outCount The number of objects that were read.
+	 * @return Returns `true` if the array was successfully read, `false` if the
+	 * 		   data is malformed or `dest` is too small.
+	 */
+	template <typename T>
+	bool readRunLengthArray(T* dest, size_t destCapacity, size_t& outCount);
+
 	/** @} */
 
 
@@ -215,6 +305,32 @@ public:
 	 */
 	bool writeDouble(double val);
 
+#if defined(SERDELITE_HAS_INT128)
+	/**
+	 * @brief Writes an unsigned 128-bit integer.
+	 * @param val The uint128_t value to write.
+	 * @return true if successful, false if buffer is full.
+	 * @note Uses buffer's(passed to constructor) endian order for conversion.
+	 */
+	bool writeUint128(uint128_t val);
+
+	/**
+	 * @brief Writes a signed 128-bit integer.
+	 * @param val The int128_t value to write.
+	 * @return true if successful, false if buffer is full.
+	 * @note Uses buffer's(passed to constructor) endian order for conversion.
+	 */
+	bool writeInt128(int128_t val);
+
+	/**
+	 * @brief Writes a fixed-point decimal as its scale (1 byte) followed by its
+	 * 		  128-bit units.
+	 * @param val The Decimal value to write.
+	 * @return true if successful, false if buffer is full.
+	 */
+	bool writeDecimal(const Decimal& val);
+#endif
+
 	/**
 	 * @brief Writes a raw sequence of characters without a length prefix.
 	 * @param str Pointer to the character array.
@@ -243,6 +359,116 @@ public:
 
 	/** @} */
 
+
+	/**
+	 * @name Packed Integer Arrays
+	 * 
+	 * Compressed codecs for arrays of unsigned integers. Values are grouped into
+	 * blocks of 128 which are bit-packed with SIMD kernels at the smallest width
+	 * that fits the block, so ID lists typically shrink 3-5x compared to writing
+	 * every value at full width.
+	 * 
+	 * @{
+	 */
+
+	/**
+	 * @brief Writes an array of unsigned 32-bit integers in packed form.
+	 * @param values Pointer to the values to write.
+	 * @param count Number of values.
+	 * @param codec The packing strategy, see @ref IntArrayCodec.
+	 * @return true if successful, false if buffer overflow occurs.
+	 * @note The element count is stored in the stream, the codec too, so the
+	 * 		 reader does not need to know either in advance.
+	 */
+	bool writePackedUint32Array(const uint32_t* values, size_t count,
+								IntArrayCodec codec = IntArrayCodec::FrameOfReference);
+
+	/**
+	 * @brief Writes an array of unsigned 64-bit integers in packed form.
+	 * @param values Pointer to the values to write.
+	 * @param count Number of values.
+	 * @param codec The packing strategy, see @ref IntArrayCodec.
+	 * @return true if successful, false if buffer overflow occurs.
+	 */
+	bool writePackedUint64Array(const uint64_t* values, size_t count,
+								IntArrayCodec codec = IntArrayCodec::FrameOfReference);
+
+	/**
+	 * @brief Reads an array written by `writePackedUint32Array`.
+	 * @param[out] dest Pointer to the memory where values will be stored.
+	 * @param destCapacity The maximum number of values `dest` can hold.
+	 * @param[out] outCount The number of values that were read.
+	 * @return true if successful, false if the data is truncated or malformed,
+	 * 		   or if `dest` is too small. The read cursor is left untouched on failure.
+	 */
+	bool readPackedUint32Array(uint32_t* dest, size_t destCapacity,
+							   size_t& outCount);
+
+	/**
+	 * @brief Reads an array written by `writePackedUint64Array`.
+	 * @param[out] dest Pointer to the memory where values will be stored.
+	 * @param destCapacity The maximum number of values `dest` can hold.
+	 * @param[out] outCount The number of values that were read.
+	 * @return true if successful, false if the data is truncated or malformed,
+	 * 		   or if `dest` is too small. The read cursor is left untouched on failure.
+	 */
+	bool readPackedUint64Array(uint64_t* dest, size_t destCapacity,
+							   size_t& outCount);
+
+	/** @} */
+
+
+	/**
+	 * @name Sparse Arrays
+	 * 
+	 * Encoding for arrays that are mostly filled with a default value. A presence
+	 * bitmap (one bit per element) is followed by the non-default elements only,
+	 * so a 256-slot inventory with 12 used slots costs 32 bytes of bitmap plus
+	 * the 12 items.
+	 * 
+	 * @{
+	 */
+
+	/**
+	 * @brief Writes an array, skipping every element equal to `defaultValue`.
+	 * 
+	 * Arithmetic elements (integers and floating point) are compared bitwise with
+	 * SIMD compares and written in the buffer's endian order. ByteSerializable
+	 * elements are compared by their encoded bytes.
+	 * 
+	 * @tparam T An arithmetic type or a ByteSerializable type.
+	 * @param values Pointer to the array.
+	 * @param count Number of elements in the array.
+	 * @param defaultValue The value that is left out of the stream.
+	 * @return true if successful, false if buffer overflow occurs.
+	 * @note ByteSerializable elements are compared outside the buffer, so a
+	 * 		 buffer that exactly fits the encoding is enough.
+	 */
+	template <typename T>
+	bool writeSparseArray(const T* values, size_t count,
+						  const T& defaultValue = T());
+
+	/**
+	 * @brief Reads an array written by `writeSparseArray`.
+	 * 
+	 * Every slot is set to `defaultValue` and the stored elements are then
+	 * scattered into place by walking the presence bitmap.
+	 * 
+	 * @tparam T An arithmetic type or a ByteSerializable type that is copy-assignable.
+	 * @param[out] dest Pointer to the array that receives the elements.
+	 * @param destCapacity The maximum number of elements `dest` can hold.
+	 * @param[out] outCount The number of elements (present or default) that were read.
+	 * @param defaultValue The value used for the absent elements; it should match
+	 * 					   the one used when writing.
+	 * @return true if successful, false if the data is truncated or malformed,
+	 * 		   or if `dest` is too small.
+	 */
+	template <typename T>
+	bool readSparseArray(T* dest, size_t destCapacity, size_t& outCount,
+						 const T& defaultValue = T());
+
+	/** @} */
+
 	
 	/**
 	 * @name Read Primitives
@@ -328,6 +554,30 @@ public:
 	 */
 	bool readDouble(double& out);
 
+#if defined(SERDELITE_HAS_INT128)
+	/**
+	 * @brief Reads an unsigned 128-bit integer and handles endianness.
+	 * @param[out] out Reference to store the retrieved uint128_t value.
+	 * @return true if successful, false if there are not enough bytes left.
+	 */
+	bool readUint128(uint128_t& out);
+
+	/**
+	 * @brief Reads a signed 128-bit integer and handles endianness.
+	 * @param[out] out Reference to store the retrieved int128_t value.
+	 * @return true if successful, false if there are not enough bytes left.
+	 */
+	bool readInt128(int128_t& out);
+
+	/**
+	 * @brief Reads a fixed-point decimal written by `writeDecimal`.
+	 * @param[out] out Reference to store the retrieved Decimal value.
+	 * @return true if successful, false if there are not enough bytes left or
+	 * 		   the stored scale is invalid.
+	 */
+	bool readDecimal(Decimal& out);
+#endif
+
 	/**
 	 * @brief Reads a raw sequence of characters into a destination buffer.
 	 * @param[out] dest Pointer to the memory where characters will be copied.
@@ -358,6 +608,183 @@ public:
 	/** @} */
 
 
+	/**
+	 * @name Standard Containers
+	 * 
+	 * Helpers for the common standard library containers. Elements may be any
+	 * arithmetic type, `bool`, `std::string`, a ByteSerializable type or another
+	 * supported container. Arithmetic elements are copied in bulk; reads reserve
+	 * the final capacity up front, after checking the length prefix against the
+	 * bytes left in the stream.
+	 * 
+	 * @note These helpers allocate through the containers themselves; the rest of
+	 * 		 the library remains allocation-free.
+	 * 
+	 * @{
+	 */
+
+	/**
+	 * @brief Writes a `std::string` with a 16-bit length prefix.
+	 * @param str The string to write; it may contain embedded `'\0'` characters.
+	 * @return true if successful, false if buffer overflow occurs or the string
+	 * 		   is longer than 65535 bytes.
+	 * @note Uses the same format as `writeString(const char*)`.
+	 */
+	bool writeString(const std::string& str);
+
+	/**
+	 * @brief Reads a length-prefixed string into a `std::string`.
+	 * @param[out] out The string receiving the data, unchanged on failure.
+	 * @return true if successful, false if the stream is truncated.
+	 */
+	bool readString(std::string& out);
+
+	/**
+	 * @brief Writes a `std::vector` with a 32-bit element count prefix.
+	 * @param vec The vector to write.
+	 * @return true if successful, false if buffer overflow occurs.
+	 */
+	template <typename T, typename A>
+	bool writeVector(const std::vector<T, A>& vec);
+
+	/**
+	 * @brief Reads a vector written by `writeVector`.
+	 * @param[out] out The vector receiving the elements, unchanged on failure.
+	 * @return true if successful, false if the data is truncated or malformed.
+	 */
+	template <typename T, typename A>
+	bool readVector(std::vector<T, A>& out);
+
+	/**
+	 * @brief Writes a `std::array`; no count is stored since the size is fixed.
+	 * @param arr The array to write.
+	 * @return true if successful, false if buffer overflow occurs.
+	 */
+	template <typename T, size_t N>
+	bool writeArray(const std::array<T, N>& arr);
+
+	/**
+	 * @brief Reads an array written by `writeArray`.
+	 * @param[out] out The array receiving the elements.
+	 * @return true if successful, false if the data is truncated or malformed.
+	 */
+	template <typename T, size_t N>
+	bool readArray(std::array<T, N>& out);
+
+	/**
+	 * @brief Writes a `std::unordered_map` as a 32-bit count followed by
+	 * 		  key/value pairs.
+	 * @param map The map to write.
+	 * @return true if successful, false if buffer overflow occurs.
+	 * @note Pairs are written in the map's iteration order.
+	 */
+	template <typename K, typename V, typename H, typename E, typename A>
+	bool writeMap(const std::unordered_map<K, V, H, E, A>& map);
+
+	/**
+	 * @brief Reads a map written by `writeMap`.
+	 * @param[out] out The map receiving the pairs, unchanged on failure.
+	 * @return true if successful, false if the data is truncated, malformed, or
+	 * 		   contains a duplicate key.
+	 */
+	template <typename K, typename V, typename H, typename E, typename A>
+	bool readMap(std::unordered_map<K, V, H, E, A>& out);
+
+	/** @} */
+
+
+	/**
+	 * @name Runtime Schemas
+	 * 
+	 * Table-driven serialization of plain structs described by a
+	 * @ref MessageDescriptor. Each field is encoded exactly like the matching
+	 * primitive (`writeUint32`, `writeString`, ...), in table order; scalar arrays
+	 * are copied in bulk.
+	 * 
+	 * @{
+	 */
+
+	/**
+	 * @brief Serializes a described struct.
+	 * @param obj Pointer to the struct instance.
+	 * @param descriptor The layout of the struct.
+	 * @return Returns `true` if the struct was written, `false` if the buffer is
+	 * 		   full or a string member is not NUL-terminated (nothing is written then).
+	 */
+	bool writeMessage(const void* obj, const MessageDescriptor& descriptor);
+
+	/**
+	 * @brief Deserializes a described struct.
+	 * @param[out] obj Pointer to the struct instance to fill.
+	 * @param descriptor The layout of the struct.
+	 * @return Returns `true` if the struct was read, `false` if the stream is
+	 * 		   truncated or a string does not fit its member (the read cursor is
+	 * 		   restored then, but `obj` may be partially filled).
+	 */
+	bool readMessage(void* obj, const MessageDescriptor& descriptor);
+
+	/** @} */
+
+
+	/**
+	 * @name Direct Buffer Access
+	 * 
+	 * Functions for specialized encoders that check the capacity of a whole
+	 * fixed-size region once and then write or read it through a raw pointer,
+	 * e.g. with @ref storeScalar / @ref loadScalar.
+	 * 
+	 * @{
+	 */
+
+	/**
+	 * @brief Reserves bytes at the write cursor and advances past them.
+	 * @param bytesCount The number of bytes to reserve.
+	 * @return Returns a pointer to the reserved bytes, or `nullptr` if the buffer
+	 * 		   does not have enough space left (nothing is reserved then).
+	 * @note The caller must fill every reserved byte.
+	 */
+	uint8_t* reserveBytes(size_t bytesCount);
+
+	/**
+	 * @brief Consumes bytes at the read cursor.
+	 * @param bytesCount The number of bytes to consume.
+	 * @return Returns a pointer to the consumed bytes, or `nullptr` if fewer bytes
+	 * 		   are left to read (the cursor does not move then).
+	 */
+	const uint8_t* consumeBytes(size_t bytesCount);
+
+	/**
+	 * @brief Consumes bytes at the read cursor as a view, without copying them.
+	 *
+	 * Framed messages in a batch can each be handed to their own stream, which
+	 * is bounded by the frame:
+	 *
+	 * @code
+	 * serdelite::ByteBuffer frame = batch;	// Replaced by each readSlice()
+	 * uint32_t frameLength;
+	 * while (stream.readUint32(frameLength) && stream.readSlice(frameLength, frame)) {
+	 * 	serdelite::ByteStream message(frame);
+	 * 	// ... read one message
+	 * }
+	 * @endcode
+	 *
+	 * @param bytesCount The number of bytes to consume.
+	 * @param[out] view Receives a view of the consumed bytes, see
+	 * 				   `ByteBuffer::slice()`.
+	 * @return Returns `false` if fewer bytes are left to read (the cursor does
+	 * 		   not move and `view` is untouched then).
+	 */
+	bool readSlice(size_t bytesCount, ByteBuffer& view);
+
+	/**
+	 * @brief Getter method which gives the endian order of the underlying buffer.
+	 * @return Returns the byte order used for all multi-byte values.
+	 */
+	Endian getEndianOrder() const;
+
+	/** @} */
+
+
 	/**
 	 * @name Stream Management & Safety
 	 * Functions used to manage the internal state of the stream and verify 
@@ -374,6 +801,24 @@ public:
 	 */
 	void resetReadCursor();
 
+	/**
+	 * @brief Getter method which gives the position of the read cursor.
+	 * @return Returns the offset of the next byte to be read.
+	 */
+	size_t getReadCursor() const;
+
+	/**
+	 * @brief Moves the read cursor to an absolute position.
+	 * 
+	 * Together with `getReadCursor()` this lets callers restore the cursor after
+	 * a read sequence that failed halfway.
+	 * 
+	 * @param pos The new offset of the read cursor.
+	 * @return Returns `true` if the cursor was moved, `false` if `pos` lies past
+	 * 		   the end of the written data.
+	 */
+	bool seekReadCursor(size_t pos);
+
 	/**
 	 * @brief Checks if there are enough bytes left in the buffer to perform a read.
 	 * @param bytesCount The number of bytes you intend to read.
@@ -401,10 +846,617 @@ private:
 	bool writeBits(uint64_t val, uint8_t bitSize = 64);
 
 	bool readBits(uint64_t& out, uint8_t bitSize = 64);
+
+	bool writeScalars(const void* src, size_t elemSize, size_t count);
+
+	bool readScalars(void* dest, size_t elemSize, size_t count);
+
+	bool writeDescribed(const uint8_t* base, const MessageDescriptor& descriptor);
+
+	bool readDescribed(uint8_t* base, const MessageDescriptor& descriptor);
+
+	bool writeVarint(uint64_t val);
+
+	bool readVarint(uint64_t& val);
+
+	bool writeSparseScalars(const void* values, size_t count,
+							size_t elemSize, const void* defaultValue);
+
+	bool readSparseScalars(void* dest, size_t destCapacity,
+						   size_t elemSize, const void* defaultValue,
+						   size_t& outCount);
+
+	bool reserveBitmap(size_t count, size_t& bitmapPos);
+
+	bool readBitmap(size_t count, size_t& bitmapPos);
+
+	uint64_t bitmapWord(size_t bitmapPos, size_t count, size_t wordIndex) const;
+
+	bool encodeDetached(const ByteSerializable& obj,
+						uint8_t* scratch, size_t scratchSize,
+						std::vector<uint8_t>& spill,
+						const uint8_t*& encoded, size_t& encodedLen) const;
+
+	template <typename T>
+	bool writeSparseArray(const T* values, size_t count,
+						  const T& defaultValue, std::true_type);
+
+	template <typename T>
+	bool writeSparseArray(const T* values, size_t count,
+						  const T& defaultValue, std::false_type);
+
+	template <typename T>
+	bool readSparseArray(T* dest, size_t destCapacity, size_t& outCount,
+						 const T& defaultValue, std::true_type);
+
+	template <typename T>
+	bool readSparseArray(T* dest, size_t destCapacity, size_t& outCount,
+						 const T& defaultValue, std::false_type);
+
+	template <typename T>
+	bool writePackedArray(const T* values, size_t count, IntArrayCodec codec);
+
+	template <typename T>
+	bool readPackedArray(T* dest, size_t destCapacity, size_t& outCount);
+
+	bool readCount(size_t minElemSize, uint32_t& count);
+
+	bool writeElement(bool val);
+	bool writeElement(const std::string& val);
+
+	template <typename T>
+	bool writeElement(const T& val);
+
+	template <typename T>
+	bool writeElement(const T& val, std::true_type);
+
+	template <typename T>
+	bool writeElement(const T& val, std::false_type);
+
+	template <typename T, typename A>
+	bool writeElement(const std::vector<T, A>& val);
+
+	template <typename T, size_t N>
+	bool writeElement(const std::array<T, N>& val);
+
+	template <typename K, typename V, typename H, typename E, typename A>
+	bool writeElement(const std::unordered_map<K, V, H, E, A>& val);
+
+	bool readElement(bool& out);
+	bool readElement(std::string& out);
+
+	template <typename T>
+	bool readElement(T& out);
+
+	template <typename T>
+	bool readElement(T& out, std::true_type);
+
+	template <typename T>
+	bool readElement(T& out, std::false_type);
+
+	template <typename T, typename A>
+	bool readElement(std::vector<T, A>& out);
+
+	template <typename T, size_t N>
+	bool readElement(std::array<T, N>& out);
+
+	template <typename K, typename V, typename H, typename E, typename A>
+	bool readElement(std::unordered_map<K, V, H, E, A>& out);
+
+	template <typename C>
+	bool writeSequence(const C& items, std::true_type);
+
+	template <typename C>
+	bool writeSequence(const C& items, std::false_type);
+
+	template <typename T, typename A>
+	bool readSequence(std::vector<T, A>& out, uint32_t count, std::true_type);
+
+	template <typename T, typename A>
+	bool readSequence(std::vector<T, A>& out, uint32_t count, std::false_type);
+
+	template <typename T, size_t N>
+	bool readSequence(std::array<T, N>& out, uint32_t count, std::true_type);
+
+	template <typename T, size_t N>
+	bool readSequence(std::array<T, N>& out, uint32_t count, std::false_type);
+
+	// Smallest number of bytes one encoded element can take, used to bound
+	// untrusted length prefixes before reserving memory. Never 0: even an
+	// empty std::array counts as one byte, or the bound would not hold
+	template <typename T>
+	static size_t minElementSize(const T*);
+
+	static size_t minElementSize(const bool*) { return 1; }
+	static size_t minElementSize(const std::string*) { return sizeof(uint16_t); }
+
+	template <typename T, typename A>
+	static size_t minElementSize(const std::vector<T, A>*) { return sizeof(uint32_t); }
+
+	template <typename T, size_t N>
+	static size_t minElementSize(const std::array<T, N>*) {
+		return (N > 0) ? N * minElementSize(static_cast<const T*>(nullptr)) : 1;
+	}
+
+	template <typename K, typename V, typename H, typename E, typename A>
+	static size_t minElementSize(const std::unordered_map<K, V, H, E, A>*) {
+		return sizeof(uint32_t);
+	}
 };
 
 /** @} */
 
+
+template <typename T>
+bool ByteStream::writeRunLengthArray(const T* items, size_t count) {
+	static_assert(std::is_base_of<ByteSerializable, T>::value,
+				  "writeRunLengthArray requires a ByteSerializable type");
+
+	if (!items && count > 0) return false;
+	if (count > 0xFFFFFFFFULL) return false;
+
+	size_t startLen = this->buffer.getSize();
+	if (!writeUint32(static_cast<uint32_t>(count))) return false;
+
+	// Elements are encoded outside the output, two at a time: the one whose
+	// run is being counted and the candidate for extending it
+	uint8_t scratch[2][256];
+	std::vector<uint8_t> spill[2];
+	const uint8_t* encoded[2] = { nullptr, nullptr };
+	size_t encodedLen[2] = { 0, 0 };
+	int current = 0;
+
+	if (count > 0 &&
+		!encodeDetached(items[0], scratch[current], sizeof(scratch[current]),
+						spill[current], encoded[current], encodedLen[current])) {
+		this->buffer.setLength(startLen);
+		return false;
+	}
+
+	// A literal run keeps its header in a single byte, so it is capped at
+	// 63 elements and its header is rewritten in place as it grows
+	const size_t maxLiteralRun = 63;
+	size_t literalPos = 0;
+	size_t literalRun = 0;
+
+	size_t i = 0;
+	while (i < count) {
+		const int candidate = 1 - current;
+		size_t run = 1;
+
+		while (i + run < count) {
+			if (!encodeDetached(items[i + run], scratch[candidate],
+								sizeof(scratch[candidate]), spill[candidate],
+								encoded[candidate], encodedLen[candidate])) {
+				this->buffer.setLength(startLen);
+				return false;
+			}
+
+			if (encodedLen[candidate] != encodedLen[current] ||
+				memcmp(encoded[candidate], encoded[current],
+					   encodedLen[current]) != 0) break;
+			run++;
+		}
+
+		bool success;
+		if (run > 1) {
+			literalRun = 0;
+			success = writeVarint((static_cast<uint64_t>(run) << 1) | 1);
+		} else if (literalRun == 0 || literalRun == maxLiteralRun) {
+			literalPos = this->buffer.getSize();
+			literalRun = 1;
+			success = writeUint8(static_cast<uint8_t>(literalRun << 1));
+		} else {
+			literalRun++;
+			this->buffer.getRawBytes()[literalPos] =
+				static_cast<uint8_t>(literalRun << 1);
+			success = true;
+		}
+
+		uint8_t* dst = success ? reserveBytes(encodedLen[current]) : nullptr;
+		if (!dst) {
+			this->buffer.setLength(startLen);
+			return false;
+		}
+		if (encodedLen[current] > 0)
+			memcpy(dst, encoded[current], encodedLen[current]);
+
+		// The candidate that ended the run starts the next one
+		i += run;
+		current = candidate;
+	}
+
+	return true;
+}
+
+template <typename T>
+bool ByteStream::readRunLengthArray(T* dest,
+									size_t destCapacity,
+									size_t& outCount) {
+	static_assert(std::is_base_of<ByteSerializable, T>::value,
+				  "readRunLengthArray requires a ByteSerializable type");
+
+	size_t startPos = this->readPos;
+
+	uint32_t count;
+	if (!readUint32(count) || count > destCapacity ||
+		(!dest && count > 0)) {
+		this->readPos = startPos;
+		return false;
+	}
+
+	size_t i = 0;
+	while (i < count) {
+		uint64_t header;
+		if (!readVarint(header)) {
+			this->readPos = startPos;
+			return false;
+		}
+
+		const uint64_t run = header >> 1;
+		const bool repeated = (header & 1) != 0;
+		if (run == 0 || run > count - i) {
+			this->readPos = startPos;
+			return false;
+		}
+
+		for (size_t k = 0; k < (repeated ? 1 : run); k++) {
+			if (!readObject(dest[i + k])) {
+				this->readPos = startPos;
+				return false;
+			}
+		}
+
+		if (repeated) std::fill_n(dest + i + 1, run - 1, dest[i]);
+		i += run;
+	}
+
+	outCount = count;
+	return true;
+}
+
+template <typename T>
+bool ByteStream::writeSparseArray(const T* values, size_t count,
+								  const T& defaultValue) {
+	return writeSparseArray(values, count, defaultValue,
+							std::is_arithmetic<T>());
+}
+
+template <typename T>
+bool ByteStream::readSparseArray(T* dest, size_t destCapacity,
+								 size_t& outCount,
+								 const T& defaultValue) {
+	return readSparseArray(dest, destCapacity, outCount, defaultValue,
+						   std::is_arithmetic<T>());
+}
+
+template <typename T>
+bool ByteStream::writeSparseArray(const T* values, size_t count,
+								  const T& defaultValue, std::true_type) {
+	return writeSparseScalars(values, count, sizeof(T), &defaultValue);
+}
+
+template <typename T>
+bool ByteStream::readSparseArray(T* dest, size_t destCapacity,
+								 size_t& outCount,
+								 const T& defaultValue, std::true_type) {
+	return readSparseScalars(dest, destCapacity, sizeof(T),
+							 &defaultValue, outCount);
+}
+
+template <typename T>
+bool ByteStream::writeSparseArray(const T* values, size_t count,
+								  const T& defaultValue, std::false_type) {
+	static_assert(std::is_base_of<ByteSerializable, T>::value,
+				  "writeSparseArray requires an arithmetic or ByteSerializable type");
+
+	if (!values && count > 0) return false;
+	if (count > 0xFFFFFFFFULL) return false;
+
+	size_t startLen = this->buffer.getSize();
+	size_t bitmapPos;
+
+	if (!writeUint32(static_cast<uint32_t>(count)) ||
+		!reserveBitmap(count, bitmapPos)) {
+		this->buffer.setLength(startLen);
+		return false;
+	}
+
+	// The default and each element are encoded outside the output, and only
+	// the elements that differ are copied in; small encodings stay on the stack
+	uint8_t defaultScratch[256];
+	std::vector<uint8_t> defaultSpill;
+	const uint8_t* defaultBytes;
+	size_t defaultLen;
+	if (!encodeDetached(defaultValue, defaultScratch, sizeof(defaultScratch),
+						defaultSpill, defaultBytes, defaultLen)) {
+		this->buffer.setLength(startLen);
+		return false;
+	}
+
+	uint8_t scratch[256];
+	std::vector<uint8_t> spill;
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t* elemBytes;
+		size_t elemLen;
+		if (!encodeDetached(values[i], scratch, sizeof(scratch), spill,
+							elemBytes, elemLen)) {
+			this->buffer.setLength(startLen);
+			return false;
+		}
+
+		if (elemLen == defaultLen &&
+			memcmp(elemBytes, defaultBytes, defaultLen) == 0) continue;
+
+		uint8_t* dst = reserveBytes(elemLen);
+		if (!dst) {
+			this->buffer.setLength(startLen);
+			return false;
+		}
+		if (elemLen > 0) memcpy(dst, elemBytes, elemLen);
+
+		uint8_t* bitmap = this->buffer.getRawBytes() + bitmapPos;
+		bitmap[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+	}
+	return true;
+}
+
+template <typename T>
+bool ByteStream::readSparseArray(T* dest, size_t destCapacity,
+								 size_t& outCount,
+								 const T& defaultValue, std::false_type) {
+	static_assert(std::is_base_of<ByteSerializable, T>::value,
+				  "readSparseArray requires an arithmetic or ByteSerializable type");
+
+	size_t startPos = this->readPos;
+	size_t bitmapPos;
+
+	uint32_t count;
+	if (!readUint32(count) || count > destCapacity ||
+		(!dest && count > 0) ||
+		!readBitmap(count, bitmapPos)) {
+		this->readPos = startPos;
+		return false;
+	}
+
+	std::fill_n(dest, count, defaultValue);
+
+	const size_t words = (static_cast<size_t>(count) + 63) / 64;
+	for (size_t w = 0; w < words; w++) {
+		uint64_t bits = bitmapWord(bitmapPos, count, w);
+		while (bits) {
+			size_t index = w * 64 + countTrailingZeros64(bits);
+			if (!readObject(dest[index])) {
+				this->readPos = startPos;
+				return false;
+			}
+			bits &= bits - 1;
+		}
+	}
+
+	outCount = count;
+	return true;
+}
+
+template <typename T>
+size_t ByteStream::minElementSize(const T*) {
+	return std::is_arithmetic<T>::value ? sizeof(T) : 1;
+}
+
+template <typename T>
+bool ByteStream::writeElement(const T& val) {
+	return writeElement(val, std::is_arithmetic<T>());
+}
+
+template <typename T>
+bool ByteStream::writeElement(const T& val, std::true_type) {
+	return writeScalars(&val, sizeof(T), 1);
+}
+
+template <typename T>
+bool ByteStream::writeElement(const T& val, std::false_type) {
+	static_assert(std::is_base_of<ByteSerializable, T>::value,
+				  "Container elements must be arithmetic, std::string, "
+				  "ByteSerializable or a supported container");
+	return writeObject(val);
+}
+
+template <typename T>
+bool ByteStream::readElement(T& out) {
+	return readElement(out, std::is_arithmetic<T>());
+}
+
+template <typename T>
+bool ByteStream::readElement(T& out, std::true_type) {
+	return readScalars(&out, sizeof(T), 1);
+}
+
+template <typename T>
+bool ByteStream::readElement(T& out, std::false_type) {
+	static_assert(std::is_base_of<ByteSerializable, T>::value,
+				  "Container elements must be arithmetic, std::string, "
+				  "ByteSerializable or a supported container");
+	return readObject(out);
+}
+
+template <typename T, typename A>
+bool ByteStream::writeElement(const std::vector<T, A>& val) {
+	return writeVector(val);
+}
+
+template <typename T, size_t N>
+bool ByteStream::writeElement(const std::array<T, N>& val) {
+	return writeArray(val);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool ByteStream::writeElement(const std::unordered_map<K, V, H, E, A>& val) {
+	return writeMap(val);
+}
+
+template <typename T, typename A>
+bool ByteStream::readElement(std::vector<T, A>& out) {
+	return readVector(out);
+}
+
+template <typename T, size_t N>
+bool ByteStream::readElement(std::array<T, N>& out) {
+	return readArray(out);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool ByteStream::readElement(std::unordered_map<K, V, H, E, A>& out) {
+	return readMap(out);
+}
+
+template <typename C>
+bool ByteStream::writeSequence(const C& items, std::true_type) {
+	return writeScalars(items.data(),
+						sizeof(typename C::value_type),
+						items.size());
+}
+
+template <typename C>
+bool ByteStream::writeSequence(const C& items, std::false_type) {
+	for (typename C::const_iterator it = items.begin();
+		 it != items.end(); ++it) {
+		if (!writeElement(static_cast<const typename C::value_type&>(*it)))
+			return false;
+	}
+	return true;
+}
+
+template <typename T, typename A>
+bool ByteStream::readSequence(std::vector<T, A>& out,
+							  uint32_t count, std::true_type) {
+	out.resize(count);
+	return readScalars(out.data(), sizeof(T), count);
+}
+
+template <typename T, typename A>
+bool ByteStream::readSequence(std::vector<T, A>& out,
+							  uint32_t count, std::false_type) {
+	out.reserve(count);
+	for (uint32_t i = 0; i < count; i++) {
+		T item;
+		if (!readElement(item)) return false;
+		out.push_back(std::move(item));
+	}
+	return true;
+}
+
+template <typename T, size_t N>
+bool ByteStream::readSequence(std::array<T, N>& out,
+							  uint32_t, std::true_type) {
+	return readScalars(out.data(), sizeof(T), N);
+}
+
+template <typename T, size_t N>
+bool ByteStream::readSequence(std::array<T, N>& out,
+							  uint32_t, std::false_type) {
+	for (size_t i = 0; i < N; i++) {
+		if (!readElement(out[i])) return false;
+	}
+	return true;
+}
+
+template <typename T, typename A>
+bool ByteStream::writeVector(const std::vector<T, A>& vec) {
+	if (vec.size() > 0xFFFFFFFFULL) return false;
+
+	size_t startLen = this->buffer.getSize();
+	if (!writeUint32(static_cast<uint32_t>(vec.size())) ||
+		!writeSequence(vec, IsBulkScalar<T>())) {
+		this->buffer.setLength(startLen);
+		return false;
+	}
+	return true;
+}
+
+template <typename T, typename A>
+bool ByteStream::readVector(std::vector<T, A>& out) {
+	size_t startPos = this->readPos;
+
+	uint32_t count;
+	if (!readCount(minElementSize(static_cast<const T*>(nullptr)), count))
+		return false;
+
+	std::vector<T, A> result;
+	if (!readSequence(result, count, IsBulkScalar<T>())) {
+		this->readPos = startPos;
+		return false;
+	}
+
+	out.swap(result);
+	return true;
+}
+
+template <typename T, size_t N>
+bool ByteStream::writeArray(const std::array<T, N>& arr) {
+	size_t startLen = this->buffer.getSize();
+	if (!writeSequence(arr, IsBulkScalar<T>())) {
+		this->buffer.setLength(startLen);
+		return false;
+	}
+	return true;
+}
+
+template <typename T, size_t N>
+bool ByteStream::readArray(std::array<T, N>& out) {
+	size_t startPos = this->readPos;
+	if (!readSequence(out, N, IsBulkScalar<T>())) {
+		this->readPos = startPos;
+		return false;
+	}
+	return true;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool ByteStream::writeMap(const std::unordered_map<K, V, H, E, A>& map) {
+	if (map.size() > 0xFFFFFFFFULL) return false;
+
+	size_t startLen = this->buffer.getSize();
+	bool success = writeUint32(static_cast<uint32_t>(map.size()));
+
+	for (typename std::unordered_map<K, V, H, E, A>::const_iterator
+			 it = map.begin(); success && it != map.end(); ++it) {
+		success = writeElement(it->first) && writeElement(it->second);
+	}
+
+	if (!success) this->buffer.setLength(startLen);
+	return success;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool ByteStream::readMap(std::unordered_map<K, V, H, E, A>& out) {
+	size_t startPos = this->readPos;
+
+	const size_t minPairSize = minElementSize(static_cast<const K*>(nullptr)) +
+							   minElementSize(static_cast<const V*>(nullptr));
+
+	uint32_t count;
+	if (!readCount(minPairSize, count)) return false;
+
+	std::unordered_map<K, V, H, E, A> result;
+	result.reserve(count);
+
+	bool success = true;
+	for (uint32_t i = 0; success && i < count; i++) {
+		K key;
+		V value;
+		success = readElement(key) && readElement(value) &&
+				  result.emplace(std::move(key), std::move(value)).second;
+	}
+
+	if (!success) {
+		this->readPos = startPos;
+		return false;
+	}
+
+	out.swap(result);
+	return true;
+}
+
 } // namespace serdelite
 
 #endif
\ No newline at end of file
@@ -0,0 +1,152 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#ifndef SERDELITE_CHANGETRACKING_H
+#define SERDELITE_CHANGETRACKING_H
+
+#include "Optional.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+
+/**
+ * @name Change Tracking
+ * Types used to remember which members of an object changed since it was
+ * last emitted, so that only those are sent again.
+ * @{
+ */
+
+/**
+ * @class DirtyMask
+ * @brief A packed bitmask recording which fields of an object were modified.
+ *
+ * Field `i` is the `i`-th field the object's `serializeToJson()` writes. A new
+ * mask starts with every field dirty, so the first patch carries the whole
+ * object; `JsonStream::writeMergePatch` cleans it after each successful emit.
+ *
+ * The bits are those of a @ref PresenceMask, so a dirty mask can also be sent
+ * with `ByteStream::writePresenceMask` ahead of the modified fields.
+ *
+ * @note A mask tracks up to 64 fields.
+ */
+class DirtyMask : public PresenceMask {
+public:
+	/**
+	 * @brief Construct a `DirtyMask` with every field dirty.
+	 * @param fieldCount The number of tracked fields (clamped to 64).
+	 */
+	explicit DirtyMask(uint8_t fieldCount);
+
+	/**
+	 * @brief Marks a field as modified.
+	 * @param index Zero-based index of the field.
+	 * @return Returns `true` if the index is valid, `false` otherwise.
+	 */
+	bool markDirty(uint8_t index);
+
+	/**
+	 * @brief Checks whether a field was modified since the last clean.
+	 * @param index Zero-based index of the field.
+	 * @return Returns `true` if the field is dirty, `false` if it is clean
+	 * 		   or the index is out of range.
+	 */
+	bool isDirty(uint8_t index) const;
+
+	/** @brief Marks every field as modified, e.g. to resend a full snapshot. */
+	void markAllDirty();
+
+	/** @brief Marks every field as clean. */
+	void clean();
+
+	/**
+	 * @brief Check if no field was modified.
+	 * @return Returns `true` if every field is clean.
+	 */
+	bool isClean() const;
+};
+
+
+/**
+ * @class Trackable
+ * @brief A base class holding the @ref DirtyMask of an object.
+ *
+ * Derive from it alongside `JsonSerializable` and declare the tracked members
+ * with @ref SERDELITE_TRACKED_FIELD, whose setters keep the mask up to date.
+ *
+ * @code
+ * class Player : public JsonSerializable, public Trackable {
+ * 	SERDELITE_TRACKED_FIELD(uint32_t, hp, Hp, 0);
+ * 	SERDELITE_TRACKED_FIELD(std::string, name, Name, 1);
+ * public:
+ * 	Player() : Trackable(2), hp(100) {}
+ * protected:
+ * 	bool serializeToJson(JsonStream& s) const override {
+ * 		return s.writeUint32("hp", hp) && s.writeString("name", name);
+ * 	}
+ * };
+ *
+ * player.setHp(90);
+ * stream.writeMergePatch(player, player.getDirtyMask());   // {"hp":90}
+ * @endcode
+ */
+class Trackable {
+public:
+	/**
+	 * @brief Read/write access to the dirty mask.
+	 * @return Returns the mask of the fields modified since the last emit.
+	 */
+	DirtyMask& getDirtyMask() { return this->dirtyFields; }
+
+	/**
+	 * @brief Read-only access to the dirty mask.
+	 * @return Returns the mask of the fields modified since the last emit.
+	 */
+	const DirtyMask& getDirtyMask() const { return this->dirtyFields; }
+
+protected:
+	/**
+	 * @brief Construct a `Trackable` with every field dirty.
+	 * @param fieldCount The number of tracked fields.
+	 */
+	explicit Trackable(uint8_t fieldCount) : dirtyFields(fieldCount) {}
+
+	DirtyMask dirtyFields;
+};
+
+/**
+ * @brief Declares a private tracked member with a public getter and setter.
+ *
+ * `set##Name` marks field `index` dirty only when the value actually changes,
+ * so writing the same value again does not grow the next patch.
+ *
+ * @param Type The member type; must be copyable and equality-comparable. Wrap
+ * 			   types containing commas in a `typedef`.
+ * @param member The member name.
+ * @param Name The suffix of the accessors, e.g. `Hp` for `getHp`/`setHp`.
+ * @param index The position of the field in `serializeToJson()`.
+ * @note The macro leaves the class in `private` access.
+ */
+#define SERDELITE_TRACKED_FIELD(Type, member, Name, index)		\
+public:															\
+	const Type& get##Name() const { return this->member; }		\
+	void set##Name(const Type& value) {							\
+		if (this->member == value) return;						\
+		this->member = value;									\
+		this->dirtyFields.markDirty(index);						\
+	}															\
+private:														\
+	Type member
+
+/** @} */
+
+} // namespace serdelite
+
+#endif
@@ -10,7 +10,9 @@
 #ifndef SERDELITE_COMMON_H
 #define SERDELITE_COMMON_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 namespace serdelite {
 
@@ -32,6 +34,23 @@ namespace serdelite {
 enum class Endian { Little, Big };
 
 
+#if defined(__SIZEOF_INT128__)
+/**
+ * @brief Defined to `1` when the compiler provides 128-bit integers
+ * 		  (GCC and Clang on 64-bit targets).
+ * 
+ * The 128-bit stream primitives and @ref Decimal are only available then.
+ */
+#define SERDELITE_HAS_INT128 1
+
+/** @brief Unsigned 128-bit integer. */
+__extension__ typedef unsigned __int128 uint128_t;
+
+/** @brief Signed 128-bit integer. */
+__extension__ typedef __int128 int128_t;
+#endif
+
+
 /**
  * @brief Detects the current CPU architecture's endianness at runtime.
  * 
@@ -87,6 +106,117 @@ static inline bool interpretAsSigned(uint64_t num, uint8_t bitSize, int64_t& des
     return true;
 }
 
+/**
+ * @brief Counts the number of set bits in a 64-bit word.
+ * @param val The word to inspect.
+ * @return The number of bits set to 1.
+ */
+static inline uint32_t popCount64(uint64_t val) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_popcountll(val));
+#else
+    uint32_t count = 0;
+    while (val) {
+        val &= val - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Finds the index of the lowest set bit of a 64-bit word.
+ * @param val The word to inspect, must not be `0`.
+ * @return The zero-based index of the least significant set bit.
+ */
+static inline uint32_t countTrailingZeros64(uint64_t val) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(val));
+#else
+    uint32_t count = 0;
+    while ((val & 1) == 0) {
+        val >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Stores an unsigned integer into raw memory in the given byte order.
+ * 
+ * The order is a template argument so that specialized encoders (such as the
+ * code emitted by the schema compiler) pay no per-field endianness branch;
+ * compilers reduce the loop to a plain or byte-swapped store.
+ * 
+ * @tparam Order The byte order to write in.
+ * @tparam T An unsigned integer type.
+ * @param dst Destination of `sizeof(T)` bytes; no bounds check is performed.
+ * @param val The value to store.
+ */
+template <Endian Order, typename T>
+inline void storeScalar(uint8_t* dst, T val) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+        const size_t shift = (Order == Endian::Big)
+                             ? (sizeof(T) - 1 - i) * 8
+                             : i * 8;
+        dst[i] = static_cast<uint8_t>(val >> shift);
+    }
+}
+
+/**
+ * @brief Loads an unsigned integer from raw memory in the given byte order.
+ * @tparam Order The byte order to read in.
+ * @tparam T An unsigned integer type.
+ * @param src Source of `sizeof(T)` bytes; no bounds check is performed.
+ * @return The decoded value.
+ */
+template <Endian Order, typename T>
+inline T loadScalar(const uint8_t* src) {
+    T val = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        const size_t shift = (Order == Endian::Big)
+                             ? (sizeof(T) - 1 - i) * 8
+                             : i * 8;
+        val |= static_cast<T>(static_cast<T>(src[i]) << shift);
+    }
+    return val;
+}
+
+/** @brief Stores a `float` by its IEEE-754 bits, see @ref storeScalar. */
+template <Endian Order>
+inline void storeFloat(uint8_t* dst, float val) {
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(float));
+    storeScalar<Order>(dst, bits);
+}
+
+/** @brief Stores a `double` by its IEEE-754 bits, see @ref storeScalar. */
+template <Endian Order>
+inline void storeDouble(uint8_t* dst, double val) {
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(double));
+    storeScalar<Order>(dst, bits);
+}
+
+/** @brief Loads a `float` stored by @ref storeFloat. */
+template <Endian Order>
+inline float loadFloat(const uint8_t* src) {
+    uint32_t bits = loadScalar<Order, uint32_t>(src);
+    float val;
+    memcpy(&val, &bits, sizeof(float));
+    return val;
+}
+
+/** @brief Loads a `double` stored by @ref storeDouble. */
+template <Endian Order>
+inline double loadDouble(const uint8_t* src) {
+    uint64_t bits = loadScalar<Order, uint64_t>(src);
+    double val;
+    memcpy(&val, &bits, sizeof(double));
+    return val;
+}
+
 /** @} */
     
 } // namespace serdelite
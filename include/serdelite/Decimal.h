@@ -0,0 +1,110 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#ifndef SERDELITE_DECIMAL_H
+#define SERDELITE_DECIMAL_H
+
+#include "Common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(SERDELITE_HAS_INT128)
+
+namespace serdelite {
+
+/**
+ * @name Fixed-Point Decimals
+ * Exact decimal values for currencies and other quantities that must not
+ * suffer binary floating-point rounding.
+ * @{
+ */
+
+/**
+ * @class Decimal
+ * @brief A signed 128-bit fixed-point decimal.
+ *
+ * The value is `units / 10^scale`, e.g. `Decimal(1250, 2)` is `12.50`. Text
+ * conversion is exact in both directions and works on integers only; no
+ * `double` is involved at any point.
+ *
+ * @note Only available when @ref SERDELITE_HAS_INT128 is defined.
+ */
+class Decimal {
+public:
+	/** @brief Largest supported number of fractional digits. */
+	static const uint8_t MAX_SCALE = 38;
+
+	/** @brief Longest text `format()` can produce ("-0." followed by 38 digits). */
+	static const size_t MAX_STRING_LENGTH = 41;
+
+	/** @brief Construct a zero with scale `0`. */
+	Decimal();
+
+	/**
+	 * @brief Construct a decimal from its scaled integer representation.
+	 * @param units The value multiplied by `10^scale`.
+	 * @param scale Number of fractional digits (clamped to @ref MAX_SCALE).
+	 */
+	Decimal(int128_t units, uint8_t scale);
+
+	/**
+	 * @brief Parses a decimal number (JSON number syntax) at a fixed scale.
+	 *
+	 * Accepts an optional `-`, digits, an optional fraction and an optional
+	 * exponent, e.g. `"-12.5"` or `"1.25e3"`. The result must be representable
+	 * exactly at `scale`: `"12.345"` parsed at scale 2 fails instead of rounding.
+	 *
+	 * @param str The text to parse (need not be NUL-terminated).
+	 * @param len Number of characters in `str`.
+	 * @param scale The scale of the result.
+	 * @param[out] out Receives the parsed value.
+	 * @return Returns `true` if the whole text was parsed, `false` on malformed
+	 * 		   input, overflow or precision loss.
+	 */
+	static bool parse(const char* str, size_t len, uint8_t scale, Decimal& out);
+
+	/**
+	 * @brief Writes the exact decimal text, e.g. `"-0.05"` or `"12.50"`.
+	 * @param[out] dest Destination of at least @ref MAX_STRING_LENGTH bytes.
+	 * @return The number of characters written (no terminator).
+	 */
+	size_t format(char* dest) const;
+
+	/**
+	 * @brief Converts the decimal into a NUL-terminated string.
+	 * @param dest The destination buffer.
+	 * @param destCapacity The capacity of `dest`.
+	 * @return Returns `true` if the text fit, `false` otherwise.
+	 */
+	bool toString(char* dest, size_t destCapacity) const;
+
+	/**
+	 * @brief Getter method which gives the scaled integer value.
+	 * @return Returns the value multiplied by `10^scale`.
+	 */
+	int128_t getUnits() const;
+
+	/**
+	 * @brief Getter method which gives the number of fractional digits.
+	 * @return Returns the scale.
+	 */
+	uint8_t getScale() const;
+
+private:
+	int128_t units;
+	uint8_t scale;
+};
+
+/** @} */
+
+} // namespace serdelite
+
+#endif // SERDELITE_HAS_INT128
+
+#endif
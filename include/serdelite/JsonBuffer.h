@@ -40,6 +40,12 @@ public:
     const char* data;
     size_t length;
 
+    /** @brief Maximum number of pointers `find()` resolves in one pass. */
+    static const size_t MAX_POINTERS = 64;
+
+    /** @brief Construct an empty `JsonBuffer` (`data` is `nullptr`). */
+    JsonBuffer();
+
     /**
      * @brief Construct a new `JsonBuffer` object.
      * @param _data A pointer to the existing JSON string (must be null-terminated or match len).
@@ -58,6 +64,49 @@ public:
      */
     void printPretty(int tabWidth = 2) const;
 
+    /**
+     * @brief Checks that the buffer holds exactly one well-formed JSON value.
+     * 
+     * The check follows RFC 8259 strictly (no trailing commas, comments or
+     * invalid UTF-8) and does not allocate.
+     * 
+     * @return Returns `true` if the content is valid JSON, `false` otherwise.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Looks up a value by RFC 6901 JSON Pointer, e.g. `"/player/stats/xp"`.
+     * 
+     * The text is scanned once, without building a DOM: members and elements
+     * that are not on the path are skipped by searching for quotes and
+     * brackets 16 or 32 bytes at a time, and the scan stops as soon as the
+     * value is found. Array elements are addressed by index (`"/items/0"`)
+     * and `""` refers to the whole document.
+     * 
+     * @param pointer The JSON Pointer.
+     * @param[out] value Receives a view of the raw value text (strings keep
+     * 					 their quotes and escapes), pointing into this buffer.
+     * @return Returns `true` if the pointer resolved, `false` otherwise.
+     * @note The document is assumed to be well-formed; use `isValid()` first
+     * 		 for untrusted input.
+     */
+    bool find(const char* pointer, JsonBuffer& value) const;
+
+    /**
+     * @brief Looks up several JSON Pointers in a single pass over the text.
+     * 
+     * Only the subtrees some pointer still needs are entered, so extracting a
+     * few fields costs one partial scan however many pointers are given.
+     * 
+     * @param pointers The JSON Pointers.
+     * @param count Number of pointers (at most @ref MAX_POINTERS).
+     * @param[out] values Array of `count` views receiving the raw value text;
+     * 					  views of pointers that do not resolve are left empty.
+     * @return Returns the number of pointers that resolved.
+     */
+    size_t find(const char* const* pointers, size_t count,
+                JsonBuffer* values) const;
+
 private:
     void printIndent(int level, int tabWidth) const;
 };
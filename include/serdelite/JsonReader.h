@@ -0,0 +1,515 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#ifndef SERDELITE_JSONREADER_H
+#define SERDELITE_JSONREADER_H
+
+#include "JsonBuffer.h"
+#include "Serializable.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace serdelite {
+
+/**
+ * @brief Computes the match signature of a key: its length and its first and
+ * 		  last characters packed into one word.
+ * @param key The key text.
+ * @param length Number of characters in `key`.
+ * @return Returns the signature, `0` for an empty key.
+ */
+constexpr uint32_t jsonKeySignature(const char* key, size_t length) {
+	return length == 0 ? 0 :
+		   (static_cast<uint32_t>(length & 0xFFFF) << 16) |
+		   (static_cast<uint32_t>(static_cast<uint8_t>(key[0])) << 8) |
+		   static_cast<uint32_t>(static_cast<uint8_t>(key[length - 1]));
+}
+
+/**
+ * @struct JsonKey
+ * @brief One entry of the compile-time field list used by `JsonReader::nextField`.
+ *
+ * Build tables with @ref SERDELITE_JSON_KEY so that the signature is computed
+ * by the compiler.
+ */
+struct JsonKey {
+	const char* text;	///< The member name, e.g. `"hp"`
+	size_t length;		///< Length of `text`
+	uint32_t signature;	///< `jsonKeySignature(text, length)`
+};
+
+/**
+ * @brief Builds a @ref JsonKey entry from a string literal.
+ *
+ * Index the table by field, e.g.
+ * `static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("hp"), SERDELITE_JSON_KEY("name") };`
+ */
+#define SERDELITE_JSON_KEY(literal) \
+	{ literal, sizeof(literal) - 1, \
+	  ::serdelite::jsonKeySignature(literal, sizeof(literal) - 1) }
+
+/**
+ * @name JSON Reading
+ * This is the "Textual Deserializer," decoding JSON text straight into objects.
+ * @{
+ */
+
+/**
+ * @class JsonReader
+ * @brief A single forward pass over JSON text that decodes values directly
+ * 		  into typed members.
+ *
+ * No DOM is built: each value is parsed where it lies in the text and written
+ * to its destination. Object members are matched against a compile-time
+ * @ref JsonKey list by comparing one packed signature (length, first and last
+ * character) per candidate and confirming a hit with a single `memcmp`;
+ * unknown members are skipped with the SIMD scanner.
+ *
+ * @code
+ * bool deserializeFromJson(JsonReader& r) override {
+ *     static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("hp"),
+ *                                     SERDELITE_JSON_KEY("name") };
+ *     size_t field;
+ *     while (r.nextField(KEYS, field)) {
+ *         switch (field) {
+ *         case 0: if (!r.readUint32(hp)) return false; break;
+ *         case 1: if (!r.readString(name)) return false; break;
+ *         }
+ *     }
+ *     return !r.hasError();
+ * }
+ * @endcode
+ *
+ * Errors are sticky: after the first malformed or mismatched value every call
+ * fails, so a decoder can simply propagate `false`.
+ *
+ * @sa JsonSerializable
+ * @sa JsonStream
+ */
+class JsonReader {
+public:
+	/**
+	 * @name Lifecycle & Status
+	 * @{
+	 */
+
+	/**
+	 * @brief Construct a new `JsonReader` over a JSON document.
+	 * @param json The text to read; it must outlive the reader.
+	 */
+	explicit JsonReader(const JsonBuffer& json);
+
+	/**
+	 * @brief Construct a new `JsonReader` over a JSON document.
+	 * @param text The text to read (need not be NUL-terminated).
+	 * @param len Number of characters in `text`.
+	 */
+	JsonReader(const char* text, size_t len);
+
+	/**
+	 * @brief Construct a new `JsonReader` over a writable JSON document.
+	 * 
+	 * Same as the read-only overload, but lets `readStringView()` decode
+	 * escaped strings in place, inside the document itself.
+	 * 
+	 * @param text The text to read; escaped strings are overwritten as they are read.
+	 * @param len Number of characters in `text`.
+	 */
+	JsonReader(char* text, size_t len);
+
+	/**
+	 * @brief Decodes the escapes of a JSON string body (`\"`, `\n`, `\uXXXX`,
+	 * 		  surrogate pairs, ...) into UTF-8.
+	 * 
+	 * Clean runs are copied a whole SIMD block (32 bytes with AVX2) at a time
+	 * while searching for the next backslash; escapes are decoded on the side.
+	 * 
+	 * @param src The characters between the quotes.
+	 * @param len Number of characters in `src`.
+	 * @param[out] dest Destination of at least `len` bytes. It may be `src`
+	 * 					itself: decoding never lengthens the text.
+	 * @param[out] outLen Receives the decoded length.
+	 * @return Returns `true` if successful, `false` on a malformed escape.
+	 */
+	static bool unescape(const char* src, size_t len, char* dest, size_t& outLen);
+
+	/**
+	 * @brief Check if a read failed.
+	 * @return Returns `true` once malformed text or a mismatched value was met.
+	 */
+	bool hasError() const;
+
+	/**
+	 * @brief Check if the whole document was consumed.
+	 * @return Returns `true` if no error occurred and only whitespace is left.
+	 */
+	bool isComplete() const;
+
+	/** @} */
+
+
+	/**
+	 * @name Objects & Arrays
+	 * Functions for walking structured values.
+	 * @{
+	 */
+
+	/**
+	 * @brief Decodes an object into a `JsonSerializable`, see `JsonSerializable::fromJson`.
+	 * @param obj The object to fill.
+	 * @return true if the object was decoded.
+	 */
+	bool readObject(JsonSerializable& obj);
+
+	/**
+	 * @brief Consumes the opening brace of an object.
+	 * @return true if the next value is an object.
+	 */
+	bool beginObject();
+
+	/**
+	 * @brief Advances to the next member whose key is in `keys`.
+	 *
+	 * Members with other keys are skipped, as is the value of the previous
+	 * match if it was not read.
+	 *
+	 * @param keys The accepted member names.
+	 * @param keyCount Number of entries in `keys`.
+	 * @param[out] index Receives the position of the matching key in `keys`.
+	 * @return true if positioned at a value, false at the end of the object or
+	 * 		   on error (see `hasError()`).
+	 * @note Escaped member names longer than 128 characters as written,
+	 * 		 escapes included, never match.
+	 */
+	bool nextField(const JsonKey* keys, size_t keyCount, size_t& index);
+
+	/** @brief Convenience overload taking a key table by reference. */
+	template <size_t N>
+	bool nextField(const JsonKey (&keys)[N], size_t& index) {
+		return nextField(keys, N, index);
+	}
+
+	/**
+	 * @brief Skips the remaining members and consumes the closing brace.
+	 * @return true if the object was closed without error.
+	 */
+	bool endObject();
+
+	/**
+	 * @brief Consumes the opening bracket of an array.
+	 * @return true if the next value is an array.
+	 */
+	bool beginArray();
+
+	/**
+	 * @brief Advances to the next element of the current array.
+	 * @param[in,out] isFirst Set to `true` before the first call for an array.
+	 * @return true if positioned at an element, false after the closing bracket
+	 * 		   or on error.
+	 */
+	bool nextElement(bool& isFirst);
+
+	/** @} */
+
+
+	/**
+	 * @name JSON Primitives
+	 * Functions for reading the current value into typed destinations. Integers
+	 * must be written without fraction, exponent or leading zeros and fit the
+	 * destination; unsigned ones refuse any minus sign, `-0` included.
+	 * @{
+	 */
+
+	/**
+	 * @brief Reads an unsigned 8-bit integer.
+	 * @param[out] out Receives the value.
+	 * @return true if successful, false if the value is not an integer in range.
+	 */
+	bool readUint8(uint8_t& out);
+
+	/** @brief Reads an unsigned 16-bit integer, see `readUint8()`. */
+	bool readUint16(uint16_t& out);
+
+	/** @brief Reads an unsigned 32-bit integer, see `readUint8()`. */
+	bool readUint32(uint32_t& out);
+
+	/** @brief Reads an unsigned 64-bit integer, see `readUint8()`. */
+	bool readUint64(uint64_t& out);
+
+	/** @brief Reads a signed 8-bit integer, see `readUint8()`. */
+	bool readInt8(int8_t& out);
+
+	/** @brief Reads a signed 16-bit integer, see `readUint8()`. */
+	bool readInt16(int16_t& out);
+
+	/** @brief Reads a signed 32-bit integer, see `readUint8()`. */
+	bool readInt32(int32_t& out);
+
+	/** @brief Reads a signed 64-bit integer, see `readUint8()`. */
+	bool readInt64(int64_t& out);
+
+	/**
+	 * @brief Reads a number as a float.
+	 * @param[out] out Receives the value; `null` reads as NaN, matching how
+	 * 				   `JsonStream` writes non-finite values.
+	 * @return true if successful.
+	 */
+	bool readFloat(float& out);
+
+	/** @brief Reads a number as a double, see `readFloat()`. */
+	bool readDouble(double& out);
+
+	/**
+	 * @brief Reads `true` or `false`.
+	 * @param[out] out Receives the value.
+	 * @return true if successful.
+	 */
+	bool readBool(bool& out);
+
+	/**
+	 * @brief Reads a string, decoding its escapes.
+	 * @param[out] dest The destination buffer, NUL-terminated on success.
+	 * @param destCapacity The capacity of `dest`, terminator included.
+	 * @return true if successful, false if the value is not a string or does
+	 * 		   not fit.
+	 */
+	bool readString(char* dest, size_t destCapacity);
+
+	/**
+	 * @brief Reads a string into a `std::string`, decoding its escapes.
+	 * @param[out] out The string receiving the text.
+	 * @return true if successful.
+	 */
+	bool readString(std::string& out);
+
+	/**
+	 * @brief Reads a string as a view into the document, without copying.
+	 * 
+	 * Strings without escapes are always returned in place. Escaped strings are
+	 * decoded in place, which requires the writable-document constructor.
+	 * 
+	 * @param[out] out Receives the decoded text (not NUL-terminated).
+	 * @return true if successful, false if the value is not a string or is
+	 * 		   escaped in a read-only document.
+	 */
+	bool readStringView(JsonBuffer& out);
+
+	/**
+	 * @brief Reads an array into a `std::vector`.
+	 * @param[out] out The vector receiving the elements, unchanged on failure.
+	 * @return true if successful.
+	 * @note Elements may be arithmetic, `bool`, `std::string`, a
+	 * 		 default-constructible `JsonSerializable` or another vector.
+	 */
+	template <typename T, typename A>
+	bool readVector(std::vector<T, A>& out);
+
+	/**
+	 * @brief Consumes the current value if it is `null`.
+	 * @return Returns `true` if a `null` was consumed, `false` otherwise (no
+	 * 		   error is raised).
+	 */
+	bool readNull();
+
+	/**
+	 * @brief Gives the raw text of the current value without decoding it.
+	 * @param[out] out Receives a view into the document.
+	 * @return true if successful.
+	 */
+	bool readRawJson(JsonBuffer& out);
+
+	/**
+	 * @brief Skips the current value.
+	 * @return true if successful.
+	 */
+	bool skipValue();
+
+	/** @} */
+
+
+	/**
+	 * @name Parallel Arrays
+	 * Multi-threaded decoding of a document that is one large top-level array.
+	 * A sequential structural pass locates the element boundaries (skipping
+	 * each element with the SIMD bracket and quote scanner), then chunks of
+	 * elements are decoded on worker threads, each with its own reader.
+	 * @{
+	 */
+
+	/**
+	 * @brief Handles one element of a parallel array parse.
+	 * 
+	 * Receives a reader positioned at the element and the element's index. It is
+	 * called concurrently from several threads and must be thread-safe.
+	 */
+	typedef std::function<bool(JsonReader& element, size_t index)> ElementHandler;
+
+	/**
+	 * @brief Locates the top-level elements of an array document.
+	 * @param json A document holding one array.
+	 * @param[out] elements Receives a view of each element's raw text; left
+	 * 					  empty on failure.
+	 * @return true if the document is an array, false otherwise.
+	 */
+	static bool splitArray(const JsonBuffer& json, std::vector<JsonBuffer>& elements);
+
+	/**
+	 * @brief Calls `handler` for every element of an array document, in parallel.
+	 * @param json A document holding one array.
+	 * @param handler The element handler; elements are passed in no particular order.
+	 * @param threadCount Number of threads, `0` for one per hardware thread.
+	 * @return true if the document is an array and every call succeeded and
+	 * 		   consumed its element; the first failure stops the remaining work.
+	 * @note An exception thrown by `handler` also stops the remaining work and
+	 * 		 is rethrown on the calling thread once every thread has finished.
+	 */
+	static bool forEachElement(const JsonBuffer& json,
+							   const ElementHandler& handler,
+							   size_t threadCount = 0);
+
+	/**
+	 * @brief Decodes an array document into a vector of objects, in parallel.
+	 * @param json A document holding one array of objects.
+	 * @param[out] out The vector receiving the objects, unchanged on failure.
+	 * @param threadCount Number of threads, `0` for one per hardware thread.
+	 * @return true if every element was decoded.
+	 * @note `T` must be a default-constructible `JsonSerializable`.
+	 */
+	template <typename T, typename A>
+	static bool readArrayParallel(const JsonBuffer& json,
+								  std::vector<T, A>& out,
+								  size_t threadCount = 0);
+
+	/** @} */
+
+private:
+	const char* p;
+	const char* end;
+	bool error;
+	bool isFirstMember;
+	bool isObjectEnd;
+	bool isValuePending;
+	bool isMutable;
+
+	bool fail();
+
+	// Runs `work(first, last)` over chunks of [0, count) on a thread pool;
+	// the first exception of `work` is rethrown after all threads joined
+	static bool runChunks(size_t count, size_t threadCount,
+						  const std::function<bool(size_t, size_t)>& work);
+
+	bool beginValue();
+
+	bool readIntBits(uint64_t& out, uint8_t bitSize, bool isSigned);
+
+	bool readReal(double& out);
+
+	bool matchKey(const char* key, const char* keyEnd, bool hasEscapes,
+				  const JsonKey* keys, size_t keyCount, size_t& index) const;
+
+	bool readValue(bool& out);
+	bool readValue(float& out);
+	bool readValue(double& out);
+	bool readValue(std::string& out);
+	bool readValue(JsonSerializable& obj);
+
+	template <typename T>
+	bool readValue(T& out);
+
+	template <typename T>
+	bool readValue(T& out, std::true_type);
+
+	template <typename T>
+	bool readValue(T& out, std::false_type);
+
+	template <typename T, typename A>
+	bool readValue(std::vector<T, A>& out);
+};
+
+/** @} */
+
+
+template <typename T>
+bool JsonReader::readValue(T& out) {
+	return readValue(out, std::is_integral<T>());
+}
+
+template <typename T>
+bool JsonReader::readValue(T& out, std::true_type) {
+	uint64_t raw = 0;
+	if (!readIntBits(raw, sizeof(T) * 8, std::is_signed<T>::value)) return false;
+
+	out = static_cast<T>(raw);
+	return true;
+}
+
+template <typename T>
+bool JsonReader::readValue(T& out, std::false_type) {
+	static_assert(std::is_base_of<JsonSerializable, T>::value,
+				  "Vector elements must be arithmetic, std::string, "
+				  "JsonSerializable or a vector");
+	return readValue(static_cast<JsonSerializable&>(out));
+}
+
+template <typename T, typename A>
+bool JsonReader::readValue(std::vector<T, A>& out) {
+	return readVector(out);
+}
+
+template <typename T, typename A>
+bool JsonReader::readVector(std::vector<T, A>& out) {
+	std::vector<T, A> items;
+	if (!beginArray()) return false;
+
+	bool isFirst = true;
+	while (nextElement(isFirst)) {
+		T item = T();
+		if (!readValue(item)) return false;
+		items.push_back(std::move(item));
+	}
+
+	if (this->error) return false;
+	out.swap(items);
+	return true;
+}
+
+template <typename T, typename A>
+bool JsonReader::readArrayParallel(const JsonBuffer& json,
+								   std::vector<T, A>& out,
+								   size_t threadCount) {
+	static_assert(std::is_base_of<JsonSerializable, T>::value,
+				  "readArrayParallel requires a JsonSerializable type");
+
+	std::vector<JsonBuffer> elements;
+	if (!splitArray(json, elements)) return false;
+
+	std::vector<T, A> items(elements.size());
+	bool success = runChunks(elements.size(), threadCount,
+		[&elements, &items](size_t first, size_t last) {
+			for (size_t i = first; i < last; i++) {
+				JsonReader reader(elements[i]);
+				if (!items[i].fromJson(reader) || !reader.isComplete())
+					return false;
+			}
+			return true;
+		});
+
+	if (!success) return false;
+	out.swap(items);
+	return true;
+}
+
+} // namespace serdelite
+
+#endif
@@ -12,11 +12,56 @@
 
 #include "ByteBuffer.h"
 #include "JsonBuffer.h"
+#include "Schema.h"
+#include "Decimal.h"
+#include "ChangeTracking.h"
 #include "Serializable.h"
 #include <stddef.h>
+#include <array>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace serdelite {
 
+class ByteStream;
+
+/**
+ * @struct EnumName
+ * @brief A precomputed JSON string (quotes included) naming one enumerator.
+ * 
+ * Build tables with @ref SERDELITE_ENUM_NAME so that `JsonStream::writeEnum`
+ * can copy the name verbatim, without quoting or escaping it at run time.
+ */
+struct EnumName {
+	const char* text;	///< Quoted name, e.g. `"\"Red\""`
+	size_t length;		///< Length of `text`
+};
+
+/**
+ * @brief Builds an @ref EnumName entry from an enumerator identifier.
+ * 
+ * Index the table by enumerator value, e.g.
+ * `static const EnumName COLOR_NAMES[] = { SERDELITE_ENUM_NAME(Red), SERDELITE_ENUM_NAME(Green) };`
+ */
+#define SERDELITE_ENUM_NAME(name) \
+	{ "\"" #name "\"", sizeof("\"" #name "\"") - 1 }
+
+/**
+ * @enum JsonDocument
+ * @brief The top-level shape of the text written by a `JsonStream`.
+ * 
+ * `Object`: A single object, filled with the keyed `write...` methods.
+ * 
+ * `Array`: A single array, filled with `JsonStream::writeElement`. Batch
+ * responses of many objects are built in one pass, without joining strings.
+ * 
+ * `Lines`: Objects separated by newlines (JSON Lines), each one filled like
+ * `Object` and ended by `JsonStream::nextDocument`.
+ */
+enum class JsonDocument : uint8_t { Object, Array, Lines };
+
 /**
  * @name JSON Streaming
  * This is the "Textual Serializer," turning objects into formatted JSON strings.
@@ -47,17 +92,50 @@ public:
 	/**
 	 * @brief Construct a new `JsonStream` object.
 	 * @param _buffer The ByteBuffer where the JSON string will be constructed.
-	 * @note This constructor automatically writes the opening brace '{' to the buffer.
+	 * @param _document The top-level shape of the output, see @ref JsonDocument.
+	 * @note This constructor automatically writes the opening brace '{' (or
+	 * 		 bracket '[' for an array) to the buffer.
 	 */
-	JsonStream(ByteBuffer& _buffer);
+	JsonStream(ByteBuffer& _buffer, JsonDocument _document = JsonDocument::Object);
 
 	/**
 	 * @brief Finalizes the JSON object by adding the closing brace.
 	 * @return true if the closing brace was successfully written, false otherwise.
 	 * @note Once closed, no more data should be written to this stream.
+	 * 		 An `Array` document is closed with ']' instead.
 	 */
 	bool close();
 
+	/**
+	 * @brief Ends the current document of a `Lines` stream and opens the next.
+	 * 
+	 * Closes the current object if needed, then writes a newline and a new
+	 * opening brace, so the fields written next belong to a fresh document.
+	 * 
+	 * @return true if successful, false if capacity exceeded or the stream is
+	 * 		   not a `Lines` stream (nothing is written then).
+	 */
+	bool nextDocument();
+
+	/**
+	 * @brief Discards everything written so far and starts over.
+	 * 
+	 * The buffer is truncated back to its size at construction and the opening
+	 * brace or bracket is written again, so one stream and buffer can produce
+	 * any number of documents without being reconstructed. The document mode
+	 * and the fixed precision are kept.
+	 * 
+	 * @return true if successful, false if the opening character does not fit.
+	 * @note Copy out (or send) the previous document first; its bytes are reused.
+	 */
+	bool reset();
+
+	/**
+	 * @brief Getter method which gives the top-level shape of the output.
+	 * @return Returns the @ref JsonDocument mode given at construction.
+	 */
+	JsonDocument getDocument() const;
+
 	/**
 	 * @brief Retrieves the constructed JSON as a JsonBuffer object.
 	 * @return A JsonBuffer containing a pointer to the string and its total length.
@@ -156,6 +234,33 @@ public:
 	 */
 	bool writeDouble(const char* key, double val);
 
+#if defined(SERDELITE_HAS_INT128)
+	/**
+	 * @brief Writes an unsigned 128-bit integer as a JSON key-value pair.
+	 * @param key The JSON field name (string).
+	 * @param val The uint128_t value to convert to text (all digits, exact).
+	 * @return true if successfully written to the buffer, false if capacity exceeded.
+	 */
+	bool writeUint128(const char* key, uint128_t val);
+
+	/**
+	 * @brief Writes a signed 128-bit integer as a JSON key-value pair.
+	 * @param key The JSON field name (string).
+	 * @param val The int128_t value to convert to text (all digits, exact).
+	 * @return true if successfully written to the buffer, false if capacity exceeded.
+	 */
+	bool writeInt128(const char* key, int128_t val);
+
+	/**
+	 * @brief Writes a fixed-point decimal as an exact JSON number, e.g. `12.50`.
+	 * @param key The JSON field name (string).
+	 * @param val The Decimal value to convert to text.
+	 * @return true if successfully written to the buffer, false if capacity exceeded.
+	 * @note Parse it back with `Decimal::parse` to avoid a round trip through `double`.
+	 */
+	bool writeDecimal(const char* key, const Decimal& val);
+#endif
+
 	/**
 	 * @brief Writes a boolean value as 'true' or 'false' text.
 	 * @param key The JSON field name.
@@ -172,6 +277,191 @@ public:
 	 */
 	bool writeString(const char* key, const char* val);
 
+	/**
+	 * @brief Writes a `std::string` value enclosed in double quotes.
+	 * @param key The JSON field name.
+	 * @param val The string value; embedded `'\0'` characters are escaped.
+	 * @return true if successful.
+	 */
+	bool writeString(const char* key, const std::string& val);
+
+	/** @} */
+
+
+	/**
+	 * @name Fixed-Precision Reals
+	 * Functions for writing floating point values with a bounded number of
+	 * decimals, e.g. for charts and telemetry that need only 2-4 places. The
+	 * value is scaled, rounded and printed with integer arithmetic instead of
+	 * `snprintf`, and trailing zeros are dropped (`2.50` is written as `2.5`).
+	 * @{
+	 */
+
+	/** @brief Largest supported number of decimals. */
+	static const uint8_t MAX_FIXED_DIGITS = 15;
+
+	/** @brief Precision value selecting the default round-trip formatting. */
+	static const uint8_t FULL_PRECISION = 0xFF;
+
+	/**
+	 * @brief Sets the number of decimals of every real written by this stream,
+	 * 		  including container elements and nested objects.
+	 * @param fractionDigits At most @ref MAX_FIXED_DIGITS decimals, or
+	 * 						 @ref FULL_PRECISION for `%.9g`/`%.17g` output.
+	 * @return Returns `false` if the digit count is out of range.
+	 */
+	bool setFixedPrecision(uint8_t fractionDigits);
+
+	/**
+	 * @brief Getter method which gives the stream-wide precision.
+	 * @return Returns the number of decimals, or @ref FULL_PRECISION.
+	 */
+	uint8_t getFixedPrecision() const;
+
+	/**
+	 * @brief Writes a real number rounded to a fixed number of decimals.
+	 * @param key The JSON field name.
+	 * @param val The value; NaN and infinities are written as `null`.
+	 * @param fractionDigits At most @ref MAX_FIXED_DIGITS decimals.
+	 * @return true if successful, false if capacity exceeded or the digit count
+	 * 		   is out of range.
+	 * @note Values that scale past 2^53 are printed with `%.*f` instead, and
+	 * 		 with `%.17g` from 1e21 on. Scaling is done in binary floating
+	 * 		 point, so a value within one ulp of a rounding tie may round the
+	 * 		 other way than `printf`; exact ties round away from zero.
+	 */
+	bool writeFixed(const char* key, double val, uint8_t fractionDigits);
+
+	/** @} */
+
+
+	/**
+	 * @name Formatted Values
+	 * Functions for common string-typed values that are formatted directly into
+	 * the buffer. Their output never needs escaping, so none is performed.
+	 * @{
+	 */
+
+	/**
+	 * @brief Writes a UNIX timestamp as an RFC 3339 UTC string,
+	 * 		  e.g. `"2024-03-01T12:30:45.123456789Z"`.
+	 * @param key The JSON field name.
+	 * @param epochNanos Nanoseconds since 1970-01-01T00:00:00Z (may be negative).
+	 * @param fractionDigits Number of fractional second digits to keep (0-9,
+	 * 						 truncated, not rounded).
+	 * @return true if successful, false if capacity exceeded or `fractionDigits`
+	 * 		   is above 9.
+	 * @note The range of `epochNanos` covers 1677-09-21 to 2262-04-11.
+	 */
+	bool writeTimestamp(const char* key, int64_t epochNanos,
+						uint8_t fractionDigits = 9);
+
+	/**
+	 * @brief Writes a UUID in its canonical lowercase form,
+	 * 		  e.g. `"123e4567-e89b-12d3-a456-426614174000"`.
+	 * @param key The JSON field name.
+	 * @param bytes The 16 bytes of the UUID in network order.
+	 * @return true if successful, false if capacity exceeded.
+	 */
+	bool writeUuid(const char* key, const uint8_t* bytes);
+
+	/**
+	 * @brief Writes the name of an enumerator from a precomputed table.
+	 * @param key The JSON field name.
+	 * @param index The enumerator value, used as an index into `names`.
+	 * @param names Table built with @ref SERDELITE_ENUM_NAME.
+	 * @param count Number of entries in `names`.
+	 * @return true if successful, false if capacity exceeded or `index` has no
+	 * 		   entry.
+	 */
+	bool writeEnum(const char* key, size_t index,
+				   const EnumName* names, size_t count);
+
+	/**
+	 * @brief Writes the name of an enumerator from a precomputed table.
+	 * @tparam E The enumeration type.
+	 * @tparam N The number of entries in the table.
+	 * @param key The JSON field name.
+	 * @param value The enumerator to write.
+	 * @param names Table built with @ref SERDELITE_ENUM_NAME, indexed by value.
+	 * @return true if successful, false if capacity exceeded or `value` has no
+	 * 		   entry.
+	 */
+	template <typename E, size_t N>
+	bool writeEnum(const char* key, E value, const EnumName (&names)[N]) {
+		return writeEnum(key, static_cast<size_t>(value), names, N);
+	}
+
+	/** @} */
+
+
+	/**
+	 * @name Standard Containers
+	 * Functions for writing standard library containers as JSON arrays and objects.
+	 * Elements may be any arithmetic type, `bool`, `std::string`, a
+	 * JsonSerializable type or another supported container.
+	 * @{
+	 */
+
+	/**
+	 * @brief Writes a `std::vector` as a JSON array.
+	 * @param key The JSON field name.
+	 * @param vec The vector to write.
+	 * @return true if successful, false if capacity exceeded.
+	 */
+	template <typename T, typename A>
+	bool writeVector(const char* key, const std::vector<T, A>& vec);
+
+	/**
+	 * @brief Writes a `std::array` as a JSON array.
+	 * @param key The JSON field name.
+	 * @param arr The array to write.
+	 * @return true if successful, false if capacity exceeded.
+	 */
+	template <typename T, size_t N>
+	bool writeArray(const char* key, const std::array<T, N>& arr);
+
+	/**
+	 * @brief Writes a `std::unordered_map` with string keys as a JSON object.
+	 * @param key The JSON field name.
+	 * @param map The map to write; its keys become the member names.
+	 * @return true if successful, false if capacity exceeded.
+	 * @note Members are written in the map's iteration order.
+	 */
+	template <typename V, typename H, typename E, typename A>
+	bool writeMap(const char* key,
+				  const std::unordered_map<std::string, V, H, E, A>& map);
+
+	/** @} */
+
+
+	/**
+	 * @name Array Elements
+	 * Functions for filling a stream constructed with `JsonDocument::Array`.
+	 * Keyed writers fail at the top level of such a stream; objects written as
+	 * elements are filled by their own `serializeToJson` as usual.
+	 * @{
+	 */
+
+	/**
+	 * @brief Appends one element to the top-level array.
+	 * @tparam T Any arithmetic type, `bool`, `std::string`, a JsonSerializable
+	 * 			 type or a supported container.
+	 * @param val The element to write.
+	 * @return true if successful, false if capacity exceeded, the stream is
+	 * 		   closed or it is not an `Array` stream (nothing is written then).
+	 */
+	template <typename T>
+	bool writeElement(const T& val);
+
+	/**
+	 * @brief Appends a string element to the top-level array.
+	 * @param val The string value (null-terminated); `nullptr` is written as `null`.
+	 * @return true if successful, false if capacity exceeded or the stream is
+	 * 		   not an `Array` stream.
+	 */
+	bool writeElement(const char* val);
+
 	/** @} */
 
 
@@ -193,6 +483,128 @@ public:
 	 */
 	bool writeObject(const char* key, const JsonSerializable& obj);
 
+	/**
+	 * @brief Splices an already serialized JSON value in under the provided key.
+	 * 
+	 * The fragment (e.g. a cached sub-document) is copied verbatim with a single
+	 * `memcpy` instead of being regenerated.
+	 * 
+	 * @param key The JSON field name.
+	 * @param json The serialized value: an object, array, string, number or literal.
+	 * @param len Number of characters in `json`.
+	 * @return true if successful, false if capacity exceeded or (when validation
+	 * 		   is enabled) the fragment is not a single valid JSON value.
+	 * 
+	 * @note Validation is compiled in when the library is built without `NDEBUG`;
+	 * 		 define `SERDELITE_VALIDATE_RAW_JSON` to `0` or `1` to override. Release
+	 * 		 builds trust the caller, so only pass fragments from trusted sources.
+	 */
+	bool writeRawJson(const char* key, const char* json, size_t len);
+
+	/** @} */
+
+
+	/**
+	 * @name Runtime Schemas
+	 * Functions for writing structs described by a @ref MessageDescriptor, either
+	 * from memory or transcoded straight from their binary encoding. Fields with
+	 * a `count` above one are written as JSON arrays.
+	 * @{
+	 */
+
+	/**
+	 * @brief Writes a described struct as a nested JSON object.
+	 * @param key The JSON field name.
+	 * @param obj Pointer to the struct instance.
+	 * @param descriptor The layout of the struct.
+	 * @return true if successful, false if capacity exceeded.
+	 */
+	bool writeMessage(const char* key, const void* obj,
+					  const MessageDescriptor& descriptor);
+
+	/**
+	 * @brief Transcodes a struct encoded by `ByteStream::writeMessage` into a
+	 * 		  nested JSON object, without materializing the struct.
+	 * @param key The JSON field name.
+	 * @param in The binary stream, positioned at the encoded struct.
+	 * @param descriptor The layout of the struct.
+	 * @return true if successful, false if capacity exceeded or the binary data
+	 * 		   is truncated or malformed.
+	 * @note On failure the read cursor of `in` is left past the consumed bytes.
+	 */
+	bool writeMessage(const char* key, ByteStream& in,
+					  const MessageDescriptor& descriptor);
+
+	/**
+	 * @brief Writes the fields of a described struct into the current object.
+	 * 
+	 * Use this for a top-level struct, i.e. between construction and `close()`.
+	 * 
+	 * @param obj Pointer to the struct instance.
+	 * @param descriptor The layout of the struct.
+	 * @return true if successful, false if capacity exceeded.
+	 */
+	bool writeFields(const void* obj, const MessageDescriptor& descriptor);
+
+	/**
+	 * @brief Transcodes the fields of a binary-encoded struct into the current
+	 * 		  object, see `writeMessage(const char*, ByteStream&, const MessageDescriptor&)`.
+	 * @param in The binary stream, positioned at the encoded struct.
+	 * @param descriptor The layout of the struct.
+	 * @return true if successful, false if capacity exceeded or the binary data
+	 * 		   is truncated or malformed.
+	 */
+	bool writeFields(ByteStream& in, const MessageDescriptor& descriptor);
+
+	/** @} */
+
+
+	/**
+	 * @name Change Tracking
+	 * Functions for emitting only the fields modified since the last emit.
+	 * @{
+	 */
+
+	/**
+	 * @brief Writes an RFC 7396 merge patch holding only the dirty fields of `obj`.
+	 * 
+	 * Runs `obj.toJson()` on this stream while counting the top-level fields it
+	 * writes: field `i` is emitted only if `dirty.isDirty(i)`, the others are
+	 * skipped without touching the buffer. Nested objects and containers are
+	 * emitted whole. On success the mask is cleaned, so the next patch only
+	 * carries later changes; with nothing dirty the patch is `{}`.
+	 * 
+	 * @param obj The object to diff; its field order must match the mask indices.
+	 * @param dirty The fields modified since the last emit, see @ref Trackable.
+	 * @return true if successful, false if capacity exceeded or the stream
+	 * 		   already holds fields (the mask is left untouched then).
+	 * @note Call it on a freshly constructed stream; it closes the stream.
+	 * 		 The `ByteStream` transcoding writers cannot be skipped without
+	 * 		 decoding and fail while a patch is being written.
+	 */
+	bool writeMergePatch(const JsonSerializable& obj, DirtyMask& dirty);
+
+	/**
+	 * @brief Appends RFC 6902 JSON Patch operations for the dirty fields of `obj`.
+	 * 
+	 * Like `writeMergePatch()`, but every dirty top-level field becomes one
+	 * `{"op":"add","path":"<base>/<key>","value":...}` element of the
+	 * top-level array, so the patches of many objects can share one document.
+	 * `add` replaces a member the target already has and creates a missing
+	 * one, so the first, all-dirty patch also applies to an empty object.
+	 * Keys are escaped as JSON Pointer tokens (`~` as `~0`, `/` as `~1`).
+	 * On success the mask is cleaned; with nothing dirty nothing is written.
+	 * 
+	 * @param obj The object to diff; its field order must match the mask indices.
+	 * @param dirty The fields modified since the last emit, see @ref Trackable.
+	 * @param basePath JSON Pointer of `obj` inside the target document, e.g.
+	 * 				   `"/players/3"`; copied verbatim. Empty for the root.
+	 * @return true if successful, false if capacity exceeded or the stream is
+	 * 		   not an open `Array` stream (the mask is left untouched then).
+	 */
+	bool writeJsonPatch(const JsonSerializable& obj, DirtyMask& dirty,
+						const char* basePath = "");
+
 	/** @} */
 
 
@@ -213,21 +625,216 @@ public:
 
 private:
 	ByteBuffer& buffer;
+	size_t documentStart;			// Buffer size at construction, kept by reset()
+	JsonDocument document;
 	bool isFirstField;
 	bool isClosed;
+	bool isArrayLevel;				// At the top level of an Array document
+	uint8_t fixedDigits;
+	const DirtyMask* fieldFilter;	// Set while writing a merge patch
+	uint8_t fieldIndex;
+	const char* patchPath;			// Set while writing a JSON Patch
+	size_t patchPathLen;
+	bool isPatchOpOpen;
+
+	bool openDocument();
+
+	bool skipField();
 
 	bool writeIntBits(const char* key, uint64_t val,
 					  uint8_t bitSize, bool isSigned = true);
 
+	bool writeIntValue(uint64_t val, uint8_t bitSize, bool isSigned);
+
+	bool writeRawField(const char* key, const char* text, size_t len);
+
+	bool writeRealValue(double val, const char* format);
+
+	bool writeFixedValue(double val, uint8_t fractionDigits);
+
 	bool writeRaw(const char* str, size_t len);
 
-	bool writeEscaped(const char* str);
+	// Gives the raw write position if `maxLen` more bytes fit, else nullptr;
+	// callers write through it without further checks, then commit
+	char* reserveOutput(size_t maxLen);
+
+	bool commitOutput(const char* end);
+
+	size_t fieldPrefixSize(const char* key, size_t keyLen) const;
+
+	char* writeFieldPrefix(char* out, const char* key, size_t keyLen);
+
+	char* writePatchPrefix(char* out, const char* key, size_t keyLen);
+
+	bool writeEscaped(const char* str, size_t len);
+
+	bool writeQuoted(const char* str, size_t len);
 
 	bool startField(const char* key);
+
+	bool writeSeparator(bool& isFirst);
+
+	bool writeMapKey(const std::string& key);
+
+	bool writeDescribed(const uint8_t* base, ByteStream* in,
+						const MessageDescriptor& descriptor);
+
+	bool writeDescribedFields(const uint8_t* base, ByteStream* in,
+							  const MessageDescriptor& descriptor,
+							  bool& isFirst);
+
+	bool writeDescribedValue(const FieldDescriptor& field,
+							 const uint8_t* base, ByteStream* in,
+							 size_t index);
+
+	bool writeValue(bool val);
+	bool writeValue(float val);
+	bool writeValue(double val);
+	bool writeValue(const char* val);
+	bool writeValue(const std::string& val);
+	bool writeValue(const JsonSerializable& obj);
+
+	template <typename T>
+	bool writeValue(const T& val);
+
+	template <typename T>
+	bool writeValue(const T& val, std::true_type);
+
+	template <typename T>
+	bool writeValue(const T& val, std::false_type);
+
+	template <typename T, typename A>
+	bool writeValue(const std::vector<T, A>& vec);
+
+	template <typename T, size_t N>
+	bool writeValue(const std::array<T, N>& arr);
+
+	template <typename V, typename H, typename E, typename A>
+	bool writeValue(const std::unordered_map<std::string, V, H, E, A>& map);
+
+	template <typename C>
+	bool writeSequence(const C& items);
+
+	template <typename T>
+	bool writeField(const char* key, const T& val);
 };
 
 /** @} */
 
+
+template <typename T>
+bool JsonStream::writeValue(const T& val) {
+	return writeValue(val, std::is_integral<T>());
+}
+
+template <typename T>
+bool JsonStream::writeValue(const T& val, std::true_type) {
+	return writeIntValue(static_cast<uint64_t>(val),
+						 sizeof(T) * 8,
+						 std::is_signed<T>::value);
+}
+
+template <typename T>
+bool JsonStream::writeValue(const T& val, std::false_type) {
+	static_assert(std::is_base_of<JsonSerializable, T>::value,
+				  "Container elements must be arithmetic, std::string, "
+				  "JsonSerializable or a supported container");
+	return writeValue(static_cast<const JsonSerializable&>(val));
+}
+
+template <typename T, typename A>
+bool JsonStream::writeValue(const std::vector<T, A>& vec) {
+	return writeSequence(vec);
+}
+
+template <typename T, size_t N>
+bool JsonStream::writeValue(const std::array<T, N>& arr) {
+	return writeSequence(arr);
+}
+
+template <typename V, typename H, typename E, typename A>
+bool JsonStream::writeValue(const std::unordered_map<std::string, V, H, E, A>& map) {
+	size_t startLen = this->buffer.getSize();
+	bool isFirst = true;
+	bool success = this->buffer.addByte(static_cast<uint8_t>('{'));
+
+	for (typename std::unordered_map<std::string, V, H, E, A>::const_iterator
+			 it = map.begin(); success && it != map.end(); ++it) {
+		success = writeSeparator(isFirst) &&
+				  writeMapKey(it->first) &&
+				  writeValue(it->second);
+	}
+
+	success = success && this->buffer.addByte(static_cast<uint8_t>('}'));
+
+	if (!success) this->buffer.setLength(startLen);
+	return success;
+}
+
+template <typename C>
+bool JsonStream::writeSequence(const C& items) {
+	size_t startLen = this->buffer.getSize();
+	bool isFirst = true;
+	bool success = this->buffer.addByte(static_cast<uint8_t>('['));
+
+	for (typename C::const_iterator it = items.begin();
+		 success && it != items.end(); ++it) {
+		success = writeSeparator(isFirst) &&
+				  writeValue(static_cast<const typename C::value_type&>(*it));
+	}
+
+	success = success && this->buffer.addByte(static_cast<uint8_t>(']'));
+
+	if (!success) this->buffer.setLength(startLen);
+	return success;
+}
+
+template <typename T>
+bool JsonStream::writeField(const char* key, const T& val) {
+	size_t startLen = this->buffer.getSize();
+	bool parentFirst = this->isFirstField;
+	if (skipField()) return true;
+	if (!startField(key)) return false;
+
+	if (!writeValue(val)) {
+		this->buffer.setLength(startLen);
+		this->isFirstField = parentFirst;
+		return false;
+	}
+	return true;
+}
+
+template <typename T>
+bool JsonStream::writeElement(const T& val) {
+	if (this->isClosed || !this->isArrayLevel) return false;
+
+	size_t startLen = this->buffer.getSize();
+	bool parentFirst = this->isFirstField;
+
+	if (!writeSeparator(this->isFirstField) || !writeValue(val)) {
+		this->buffer.setLength(startLen);
+		this->isFirstField = parentFirst;
+		return false;
+	}
+	return true;
+}
+
+template <typename T, typename A>
+bool JsonStream::writeVector(const char* key, const std::vector<T, A>& vec) {
+	return writeField(key, vec);
+}
+
+template <typename T, size_t N>
+bool JsonStream::writeArray(const char* key, const std::array<T, N>& arr) {
+	return writeField(key, arr);
+}
+
+template <typename V, typename H, typename E, typename A>
+bool JsonStream::writeMap(const char* key,
+						  const std::unordered_map<std::string, V, H, E, A>& map) {
+	return writeField(key, map);
+}
+
 } // namespace serdelite
 
 #endif
\ No newline at end of file
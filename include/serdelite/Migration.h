@@ -0,0 +1,186 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#ifndef SERDELITE_MIGRATION_H
+#define SERDELITE_MIGRATION_H
+
+#include "Common.h"
+#include "Schema.h"
+#include "ByteStream.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+
+/**
+ * @name Schema Evolution
+ * Byte-level migration of records encoded with `ByteStream::writeMessage`
+ * from an old schema version to the current one, without decoding them into
+ * objects.
+ * @{
+ */
+
+/**
+ * @brief The kind of change a @ref MigrationRule declares.
+ */
+enum class MigrationOp : uint8_t {
+	AddField,		///< New field, filled with a default value
+	DropField,		///< Old field that is no longer stored
+	RenameField,	///< Field whose name changed
+	WidenField		///< Field whose type grew (e.g. `Int16` to `Int32`, `Float` to `Double`)
+};
+
+/**
+ * @struct MigrationRule
+ * @brief Declares one difference between two versions of a schema.
+ *
+ * Every difference between the old and the new descriptor must be declared,
+ * so that accidental layout changes are reported by `MigrationPlan::compile`
+ * instead of silently corrupting records. Fields are matched by name.
+ */
+struct MigrationRule {
+	MigrationOp op;				///< The kind of change
+	const char* field;			///< Field name (in the old schema for `DropField`)
+	const char* oldName;		///< `RenameField` only: the name in the old schema
+	const void* defaultValue;	///< `AddField` only: value laid out like the member, or `nullptr` for zero
+
+	/** @brief Declares a new field, filled with `defaultValue` in migrated records. */
+	static MigrationRule addField(const char* name,
+								  const void* defaultValue = nullptr) {
+		MigrationRule rule = { MigrationOp::AddField, name, nullptr, defaultValue };
+		return rule;
+	}
+
+	/** @brief Declares an old field that is dropped from migrated records. */
+	static MigrationRule dropField(const char* name) {
+		MigrationRule rule = { MigrationOp::DropField, name, nullptr, nullptr };
+		return rule;
+	}
+
+	/** @brief Declares that the old field `oldName` is now called `newName`. */
+	static MigrationRule renameField(const char* oldName, const char* newName) {
+		MigrationRule rule = { MigrationOp::RenameField, newName, oldName, nullptr };
+		return rule;
+	}
+
+	/** @brief Declares that the type of a field was widened. */
+	static MigrationRule widenField(const char* name) {
+		MigrationRule rule = { MigrationOp::WidenField, name, nullptr, nullptr };
+		return rule;
+	}
+};
+
+/**
+ * @class MigrationPlan
+ * @brief A precompiled transform from one schema version to another.
+ *
+ * `compile()` turns two descriptors and their declared rules into a short list
+ * of steps: copy a span of consecutive old fields, insert pre-encoded default
+ * bytes, or widen a scalar. Adjacent copies and inserts are merged, so an
+ * unchanged prefix or suffix of a record moves with a single `memcpy`.
+ * `apply()` locates the old fields of one record (walking only variable-length
+ * fields), reserves the output once, and runs the steps. Reordered fields are
+ * supported. Rules apply to top-level fields; a nested message that is kept
+ * must have the same wire layout in both versions.
+ *
+ * The plan holds all its state inline and never allocates.
+ */
+class MigrationPlan {
+public:
+	/** @brief Maximum number of top-level fields in the old schema. */
+	static const size_t MAX_FIELDS = 64;
+
+	/** @brief Maximum number of steps after merging. */
+	static const size_t MAX_STEPS = 64;
+
+	/** @brief Maximum total size of the encoded default values. */
+	static const size_t MAX_DEFAULT_BYTES = 256;
+
+	/** @brief Construct an empty (not compiled) plan. */
+	MigrationPlan();
+
+	/**
+	 * @brief Compiles the transform between two versions of a message.
+	 * @param from The descriptor of the archived records.
+	 * @param to The descriptor of the current version.
+	 * @param rules The declared differences.
+	 * @param ruleCount Number of rules.
+	 * @param recordOrder The byte order of the records.
+	 * @return Returns `true` if the plan was compiled, `false` if a difference is
+	 * 		   not declared, a widening is not lossless, or a limit is exceeded.
+	 */
+	bool compile(const MessageDescriptor& from,
+				 const MessageDescriptor& to,
+				 const MigrationRule* rules,
+				 size_t ruleCount,
+				 Endian recordOrder = Endian::Big);
+
+	/**
+	 * @brief Migrates one record.
+	 * @param in Stream positioned at a record of the old version.
+	 * @param out Stream that receives the record in the new version.
+	 * @return Returns `true` if the record was migrated, `false` if the plan is
+	 * 		   not compiled, the byte orders differ from the plan, the input is
+	 * 		   truncated or `out` is full (neither cursor moves then).
+	 */
+	bool apply(ByteStream& in, ByteStream& out) const;
+
+	/**
+	 * @brief Check if `compile()` succeeded.
+	 * @return Returns `true` if the plan can be applied.
+	 */
+	bool isCompiled() const;
+
+	/**
+	 * @brief Getter method which gives the number of compiled steps.
+	 * @return Returns the step count.
+	 */
+	size_t getStepCount() const;
+
+	/** @brief Getter method which gives the schema version the plan reads. */
+	uint16_t getFromVersion() const;
+
+	/** @brief Getter method which gives the schema version the plan writes. */
+	uint16_t getToVersion() const;
+
+private:
+	enum class StepOp : uint8_t { Copy, Insert, Widen };
+
+	struct Step {
+		StepOp op;
+		WireType fromType;	// Widen
+		WireType toType;	// Widen
+		uint16_t first;		// Copy: first old field; Widen: the old field
+		uint16_t last;		// Copy: one past the last old field
+		uint16_t count;		// Widen: number of elements
+		uint32_t offset;	// Insert: offset into `defaults`
+		uint32_t length;	// Insert: number of bytes
+	};
+
+	const MessageDescriptor* source;
+	Step steps[MAX_STEPS];
+	size_t stepCount;
+	uint32_t fieldSizes[MAX_FIELDS];	// 0 for variable-length fields
+	uint8_t defaults[MAX_DEFAULT_BYTES];
+	size_t defaultsLength;
+	Endian order;
+	bool compiled;
+	uint16_t fromVersion;
+	uint16_t toVersion;
+
+	bool addStep(const Step& step);
+
+	bool addDefault(const FieldDescriptor& field, const void* value);
+};
+
+/** @} */
+
+} // namespace serdelite
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#ifndef SERDELITE_OPTIONAL_H
+#define SERDELITE_OPTIONAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+
+/**
+ * @name Optional Fields
+ * Types used to describe members that may be absent from a serialized object.
+ * @{
+ */
+
+/**
+ * @class Optional
+ * @brief A value that may or may not be present.
+ * 
+ * Optional is a minimal, allocation-free holder intended for serializable
+ * members. Pair it with a @ref PresenceMask to emit only the members that
+ * are present.
+ * 
+ * @tparam T The type of the held value; must be default-constructible.
+ */
+template <typename T>
+class Optional {
+public:
+	/** @brief Construct an empty `Optional`. */
+	Optional() : present(false), val() {}
+
+	/**
+	 * @brief Construct an `Optional` holding a value.
+	 * @param value The value to hold.
+	 */
+	Optional(const T& value) : present(true), val(value) {}
+
+	/**
+	 * @brief Stores a value and marks it present.
+	 * @param value The value to hold.
+	 */
+	void set(const T& value) {
+		this->val = value;
+		this->present = true;
+	}
+
+	/** @brief Marks the value absent and restores the default value. */
+	void reset() {
+		this->val = T();
+		this->present = false;
+	}
+
+	/**
+	 * @brief Checks whether a value is held.
+	 * @return Returns `true` if present, `false` otherwise.
+	 */
+	bool hasValue() const { return this->present; }
+
+	/**
+	 * @brief Read-only access to the held value.
+	 * @return Returns the value, or a default-constructed `T` if absent.
+	 */
+	const T& value() const { return this->val; }
+
+	/**
+	 * @brief Read/write access to the held value.
+	 * @return Returns a reference to the value; it is typically used as the
+	 * 		   destination of a read and followed by `markPresent()`.
+	 */
+	T& value() { return this->val; }
+
+	/** @brief Marks the held value as present without changing it. */
+	void markPresent() { this->present = true; }
+
+private:
+	bool present;
+	T val;
+};
+
+
+/**
+ * @class PresenceMask
+ * @brief A packed bitmask recording which optional fields of an object are present.
+ * 
+ * The mask is written once at the start of an object, taking one bit per
+ * optional field (rounded up to whole bytes), instead of one `bool` byte in
+ * front of every optional value. Readers decode it once and branch on the bits.
+ * 
+ * @code
+ * bool toByteStream(ByteStream& s) const override {
+ *     PresenceMask mask(2);
+ *     mask.set(0, nickname.hasValue());
+ *     mask.set(1, guildId.hasValue());
+ * 
+ *     return s.writePresenceMask(mask) &&
+ *            (!mask.has(0) || s.writeString(nickname.value())) &&
+ *            (!mask.has(1) || s.writeUint32(guildId.value()));
+ * }
+ * @endcode
+ * 
+ * @note A mask holds up to 64 optional fields.
+ */
+class PresenceMask {
+public:
+	/** @brief The maximum number of fields a single mask can track. */
+	static const uint8_t MAX_FIELDS = 64;
+
+	/**
+	 * @brief Construct an empty `PresenceMask`.
+	 * @param fieldCount The number of optional fields tracked (clamped to 64).
+	 * 					 Reader and writer must agree on it.
+	 */
+	explicit PresenceMask(uint8_t fieldCount);
+
+	/**
+	 * @brief Marks a field as present or absent.
+	 * @param index Zero-based index of the optional field.
+	 * @param present Whether the field is present.
+	 * @return Returns `true` if the index is valid, `false` otherwise.
+	 */
+	bool set(uint8_t index, bool present = true);
+
+	/**
+	 * @brief Checks whether a field is present.
+	 * @param index Zero-based index of the optional field.
+	 * @return Returns `true` if the field is present, `false` if it is absent
+	 * 		   or the index is out of range.
+	 */
+	bool has(uint8_t index) const;
+
+	/** @brief Marks every field absent. */
+	void clear();
+
+	/**
+	 * @brief Replaces every bit at once.
+	 * @param bits The new mask; bit `i` corresponds to field `i`.
+	 * @return Returns `false` if bits beyond the field count are set.
+	 */
+	bool setBits(uint64_t bits);
+
+	/**
+	 * @brief Getter method which gives the raw mask.
+	 * @return Returns the mask, bit `i` corresponds to field `i`.
+	 */
+	uint64_t getBits() const;
+
+	/**
+	 * @brief Getter method which gives the number of tracked fields.
+	 * @return Returns the field count given at construction.
+	 */
+	uint8_t getFieldCount() const;
+
+	/**
+	 * @brief Calculates the number of bytes the mask takes in a stream.
+	 * @return Returns `ceil(fieldCount / 8)`.
+	 */
+	size_t byteSize() const;
+
+private:
+	uint64_t bits;
+	uint8_t fieldCount;
+};
+
+/** @} */
+
+} // namespace serdelite
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#ifndef SERDELITE_SCHEMA_H
+#define SERDELITE_SCHEMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+
+/**
+ * @name Runtime Schemas
+ * Descriptor tables that let `ByteStream` and `JsonStream` serialize plain
+ * structs whose layout is only known at runtime (plugins, inspection tools).
+ *
+ * A message is described by a constant array of @ref FieldDescriptor entries.
+ * The generic codec walks that table in a single loop that switches on the
+ * wire type, so hundreds of message types share the same few functions
+ * instead of each instantiating its own serializer. The wire format of every
+ * field is identical to the corresponding `ByteStream` primitive.
+ *
+ * @{
+ */
+
+/**
+ * @brief The encoding of a described field.
+ */
+enum class WireType : uint8_t {
+	Bool,		///< 1 byte, 0 or 1
+	Uint8,
+	Uint16,
+	Uint32,
+	Uint64,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	Float,
+	Double,
+	String,		///< `char[capacity]` member, written like `writeString()`
+	Message		///< Nested struct with its own descriptor
+};
+
+/**
+ * @brief Gives the number of bytes a fixed-size wire type occupies.
+ * @param type The wire type.
+ * @return The element size, or `0` for `String` and `Message`.
+ */
+inline size_t wireTypeSize(WireType type) {
+	switch (type) {
+	case WireType::Bool:
+	case WireType::Uint8:
+	case WireType::Int8:   return 1;
+	case WireType::Uint16:
+	case WireType::Int16:  return 2;
+	case WireType::Uint32:
+	case WireType::Int32:
+	case WireType::Float:  return 4;
+	case WireType::Uint64:
+	case WireType::Int64:
+	case WireType::Double: return 8;
+	default:               return 0;
+	}
+}
+
+struct MessageDescriptor;
+
+/**
+ * @struct FieldDescriptor
+ * @brief Describes one member of a struct.
+ *
+ * Prefer the `SERDELITE_*_FIELD` macros over filling the entries by hand.
+ */
+struct FieldDescriptor {
+	const char* name;					///< JSON key of the field
+	uint32_t offset;					///< Byte offset of the member in the struct
+	WireType type;						///< Encoding of each element
+	uint16_t count;						///< Number of elements (1 unless a fixed array)
+	uint16_t capacity;					///< `String` only: size of the char array
+	const MessageDescriptor* message;	///< `Message` only: nested descriptor
+};
+
+/**
+ * @struct MessageDescriptor
+ * @brief Describes a struct as an ordered table of fields.
+ */
+struct MessageDescriptor {
+	const char* name;				///< Name of the message type
+	const FieldDescriptor* fields;	///< Fields in wire order
+	uint16_t fieldCount;			///< Number of entries in `fields`
+	uint16_t version;				///< Schema version of this layout
+	uint32_t structSize;			///< `sizeof` the described struct
+};
+
+/** @} */
+
+} // namespace serdelite
+
+/**
+ * @brief Describes a scalar member of a standard-layout struct.
+ * @param Struct The struct type.
+ * @param member The member name (also used as the JSON key).
+ * @param wireType A @ref serdelite::WireType enumerator name, e.g. `Uint32`.
+ */
+#define SERDELITE_FIELD(Struct, member, wireType) \
+	{ #member, static_cast<uint32_t>(offsetof(Struct, member)), \
+	  serdelite::WireType::wireType, 1, 0, nullptr }
+
+/** @brief Describes a fixed-length array member, see @ref SERDELITE_FIELD. */
+#define SERDELITE_ARRAY_FIELD(Struct, member, wireType) \
+	{ #member, static_cast<uint32_t>(offsetof(Struct, member)), \
+	  serdelite::WireType::wireType, \
+	  static_cast<uint16_t>(sizeof(((Struct*)0)->member) / \
+							sizeof(((Struct*)0)->member[0])), \
+	  0, nullptr }
+
+/** @brief Describes a `char[N]` member holding a NUL-terminated string. */
+#define SERDELITE_STRING_FIELD(Struct, member) \
+	{ #member, static_cast<uint32_t>(offsetof(Struct, member)), \
+	  serdelite::WireType::String, 1, \
+	  static_cast<uint16_t>(sizeof(((Struct*)0)->member)), nullptr }
+
+/** @brief Describes a nested struct member with its own `descriptor`. */
+#define SERDELITE_MESSAGE_FIELD(Struct, member, descriptor) \
+	{ #member, static_cast<uint32_t>(offsetof(Struct, member)), \
+	  serdelite::WireType::Message, 1, 0, &(descriptor) }
+
+/** @brief Describes a fixed-length array of nested structs. */
+#define SERDELITE_MESSAGE_ARRAY_FIELD(Struct, member, descriptor) \
+	{ #member, static_cast<uint32_t>(offsetof(Struct, member)), \
+	  serdelite::WireType::Message, \
+	  static_cast<uint16_t>(sizeof(((Struct*)0)->member) / \
+							sizeof(((Struct*)0)->member[0])), \
+	  0, &(descriptor) }
+
+/**
+ * @brief Defines the descriptor of a struct from an array of fields.
+ * @param Struct The struct type.
+ * @param fieldTable A `FieldDescriptor` array built with the field macros.
+ * @param version The schema version.
+ */
+#define SERDELITE_MESSAGE(Struct, fieldTable, version) \
+	{ #Struct, fieldTable, \
+	  static_cast<uint16_t>(sizeof(fieldTable) / sizeof((fieldTable)[0])), \
+	  version, static_cast<uint32_t>(sizeof(Struct)) }
+
+#endif
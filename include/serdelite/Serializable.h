@@ -16,6 +16,7 @@ namespace serdelite {
 
 class ByteStream;
 class JsonStream;
+class JsonReader;
 
 /**
  * @name Binary Serialization Interface
@@ -89,6 +90,15 @@ public:
      */
     bool toJson(JsonStream& stream) const;
 
+    /**
+     * @brief Public entry point to decode the object from JSON text.
+     * @param reader The JsonReader positioned at the object.
+     * @return true if the object was decoded successfully.
+     * @note Consumes the braces around the call to deserializeFromJson, and
+     *       skips any members the object did not ask for.
+     */
+    bool fromJson(JsonReader& reader);
+
 protected:
     /**
      * @brief Pure virtual method that defines the specific JSON fields for the object.
@@ -97,6 +107,15 @@ protected:
      * @note This must be implemented by the derived class using JsonStream's write methods.
      */
     virtual bool serializeToJson(JsonStream& stream) const = 0;
+
+    /**
+     * @brief Defines how the JSON members are decoded into the object.
+     * @param reader The JsonReader, positioned inside the object.
+     * @return true if the members were decoded correctly.
+     * @note Override it with a `JsonReader::nextField` loop. The default
+     *       implementation fails, for objects that are only ever written.
+     */
+    virtual bool deserializeFromJson(JsonReader& reader);
 };
 
 /** @} */
@@ -0,0 +1,359 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "Base64.h"
+#include "Simd.h"
+
+namespace serdelite {
+namespace base64 {
+
+static const char STANDARD_CHARS[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char URL_SAFE_CHARS[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Value of one character, or 255 if it is outside the alphabet
+static inline uint8_t sextetValue(char c, char char62, char char63) {
+    if (c >= 'A' && c <= 'Z') return static_cast<uint8_t>(c - 'A');
+    if (c >= 'a' && c <= 'z') return static_cast<uint8_t>(c - 'a' + 26);
+    if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0' + 52);
+    if (c == char62) return 62;
+    if (c == char63) return 63;
+    return 255;
+}
+
+#if defined(SERDELITE_SSSE3)
+// Spreads 12 bytes (the low 12 of `in`) into 16 6-bit indices, one per byte
+static inline __m128i splitSextets(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4,
+                                            7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+// Maps indices to characters by adding a per-range shift: 0-25 select entry
+// 13, 26-51 entry 0, and 52-63 entries 1-12 after a saturating subtract
+static inline __m128i sextetChars(__m128i indices, __m128i shifts) {
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i isUpper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(isUpper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(shifts, range));
+}
+
+static inline __m128i shiftTable(const char* chars) {
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, static_cast<char>(chars[62] - 62),
+                         static_cast<char>(chars[63] - 63), 'A', 0, 0);
+}
+
+// Values of 16 characters; `valid` gets a bit per character in the alphabet
+static inline __m128i sextetValues(__m128i v, __m128i char62, __m128i char63,
+                                   int& valid) {
+    const __m128i upper = _mm_sub_epi8(v, _mm_set1_epi8('A'));
+    const __m128i lower = _mm_sub_epi8(v, _mm_set1_epi8('a'));
+    const __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+
+    // Unsigned range checks: x <= n exactly when min(x, n) == x
+    const __m128i isUpper = _mm_cmpeq_epi8(
+                                _mm_min_epu8(upper, _mm_set1_epi8(25)), upper);
+    const __m128i isLower = _mm_cmpeq_epi8(
+                                _mm_min_epu8(lower, _mm_set1_epi8(25)), lower);
+    const __m128i isDigit = _mm_cmpeq_epi8(
+                                _mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i is62 = _mm_cmpeq_epi8(v, char62);
+    const __m128i is63 = _mm_cmpeq_epi8(v, char63);
+
+    valid = _mm_movemask_epi8(
+                _mm_or_si128(_mm_or_si128(isUpper, isLower),
+                             _mm_or_si128(isDigit, _mm_or_si128(is62, is63))));
+
+    return _mm_or_si128(
+        _mm_or_si128(
+            _mm_and_si128(isUpper, upper),
+            _mm_and_si128(isLower, _mm_add_epi8(lower, _mm_set1_epi8(26)))),
+        _mm_or_si128(
+            _mm_and_si128(isDigit, _mm_add_epi8(digit, _mm_set1_epi8(52))),
+            _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(62)),
+                         _mm_and_si128(is63, _mm_set1_epi8(63)))));
+}
+
+// Merges 16 sextets into 12 bytes, left in the low 12 bytes
+static inline __m128i mergeSextets(__m128i values) {
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(triples, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9,
+                                                   8, 14, 13, 12, -1, -1, -1, -1));
+}
+#endif
+
+#if defined(SERDELITE_AVX2)
+static inline __m256i splitSextets(__m256i in) {
+    in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(
+             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t1, t3);
+}
+
+static inline __m256i sextetChars(__m256i indices, __m256i shifts) {
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range,
+                            _mm256_and_si256(isUpper, _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(indices, _mm256_shuffle_epi8(shifts, range));
+}
+
+static inline __m256i sextetValues(__m256i v, __m256i char62, __m256i char63,
+                                   uint32_t& valid) {
+    const __m256i upper = _mm256_sub_epi8(v, _mm256_set1_epi8('A'));
+    const __m256i lower = _mm256_sub_epi8(v, _mm256_set1_epi8('a'));
+    const __m256i digit = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+
+    const __m256i isUpper = _mm256_cmpeq_epi8(
+                                _mm256_min_epu8(upper, _mm256_set1_epi8(25)), upper);
+    const __m256i isLower = _mm256_cmpeq_epi8(
+                                _mm256_min_epu8(lower, _mm256_set1_epi8(25)), lower);
+    const __m256i isDigit = _mm256_cmpeq_epi8(
+                                _mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i is62 = _mm256_cmpeq_epi8(v, char62);
+    const __m256i is63 = _mm256_cmpeq_epi8(v, char63);
+
+    valid = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_or_si256(isUpper, isLower),
+                                _mm256_or_si256(isDigit,
+                                                _mm256_or_si256(is62, is63)))));
+
+    return _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_and_si256(isUpper, upper),
+            _mm256_and_si256(isLower,
+                             _mm256_add_epi8(lower, _mm256_set1_epi8(26)))),
+        _mm256_or_si256(
+            _mm256_and_si256(isDigit,
+                             _mm256_add_epi8(digit, _mm256_set1_epi8(52))),
+            _mm256_or_si256(_mm256_and_si256(is62, _mm256_set1_epi8(62)),
+                            _mm256_and_si256(is63, _mm256_set1_epi8(63)))));
+}
+
+// Merges 32 sextets into 24 bytes, left in the low 24 bytes
+static inline __m256i mergeSextets(__m256i values) {
+    const __m256i pairs = _mm256_maddubs_epi16(values,
+                                               _mm256_set1_epi32(0x01400140));
+    const __m256i triples = _mm256_madd_epi16(pairs,
+                                              _mm256_set1_epi32(0x00011000));
+    const __m256i packed = _mm256_shuffle_epi8(triples, _mm256_setr_epi8(
+                               2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                               2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+    // Each lane holds 12 bytes: close the gap between them
+    return _mm256_permutevar8x32_epi32(packed,
+                                       _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+#endif
+
+size_t encodedLength(size_t count, bool padded) {
+    const size_t full = (count / 3) * 4;
+    const size_t rest = count % 3;
+
+    if (rest == 0) return full;
+    return full + (padded ? 4 : rest + 1);
+}
+
+void encode(const uint8_t* src, size_t count, char* dest,
+            bool urlSafe, bool padded) {
+    const char* chars = urlSafe ? URL_SAFE_CHARS : STANDARD_CHARS;
+    size_t i = 0;
+
+#if defined(SERDELITE_AVX2)
+    const __m256i shifts32 = _mm256_broadcastsi128_si256(shiftTable(chars));
+
+    // 24 bytes per step, loaded as two overlapping 16-byte halves
+    for (; i + 28 <= count; i += 24) {
+        __m256i in = _mm256_inserti128_si256(
+                         _mm256_castsi128_si256(_mm_loadu_si128(
+                             reinterpret_cast<const __m128i*>(src + i))),
+                         _mm_loadu_si128(
+                             reinterpret_cast<const __m128i*>(src + i + 12)),
+                         1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest),
+                            sextetChars(splitSextets(in), shifts32));
+        dest += 32;
+    }
+#endif
+
+#if defined(SERDELITE_SSSE3)
+    const __m128i shifts = shiftTable(chars);
+
+    // 12 bytes per step; the load reads 4 bytes ahead
+    for (; i + 16 <= count; i += 12) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest),
+                         sextetChars(splitSextets(in), shifts));
+        dest += 16;
+    }
+#endif
+
+    for (; i + 3 <= count; i += 3) {
+        const uint32_t triple = (static_cast<uint32_t>(src[i]) << 16) |
+                                (static_cast<uint32_t>(src[i + 1]) << 8) |
+                                src[i + 2];
+        *dest++ = chars[triple >> 18];
+        *dest++ = chars[(triple >> 12) & 0x3F];
+        *dest++ = chars[(triple >> 6) & 0x3F];
+        *dest++ = chars[triple & 0x3F];
+    }
+
+    const size_t rest = count - i;
+    if (rest == 0) return;
+
+    const uint32_t partial = (static_cast<uint32_t>(src[i]) << 16) |
+                             (rest == 2 ? static_cast<uint32_t>(src[i + 1]) << 8 : 0);
+    *dest++ = chars[partial >> 18];
+    *dest++ = chars[(partial >> 12) & 0x3F];
+    if (rest == 2) {
+        *dest++ = chars[(partial >> 6) & 0x3F];
+    } else if (padded) {
+        *dest++ = '=';
+    }
+    if (padded) *dest++ = '=';
+}
+
+bool measure(const char* src, size_t len, bool padded,
+             size_t& bodyLen, size_t& outLen, size_t& errorIndex) {
+    size_t body = len;
+
+    if (padded) {
+        // Whole groups only, the last one ending in at most two '='
+        if (len % 4 != 0) {
+            errorIndex = len - len % 4;
+            return false;
+        }
+        if (body > 0 && src[body - 1] == '=') body--;
+        if (body > 0 && src[body - 1] == '=') body--;
+    } else if (len % 4 == 1) {
+        // A single character cannot carry a whole byte
+        errorIndex = len - 1;
+        return false;
+    }
+
+    bodyLen = body;
+    outLen = (body / 4) * 3 + (body % 4 == 0 ? 0 : body % 4 - 1);
+    return true;
+}
+
+// Position of the first character outside the alphabet at or after `i`
+static size_t findInvalid(const char* src, size_t i, size_t len,
+                          char char62, char char63) {
+    while (i < len && sextetValue(src[i], char62, char63) < 64) i++;
+    return i;
+}
+
+bool decode(const char* src, size_t len, uint8_t* dest,
+            bool urlSafe, size_t& errorIndex) {
+    const char* chars = urlSafe ? URL_SAFE_CHARS : STANDARD_CHARS;
+    const char char62 = chars[62];
+    const char char63 = chars[63];
+
+    size_t i = 0;
+    size_t o = 0;
+
+    // Full vectors are stored, so they need room past the 24 (12) bytes
+    // they produce; a block with an invalid character goes to the tail
+#if defined(SERDELITE_SSSE3)
+    const size_t outLen = (len / 4) * 3 + (len % 4 == 0 ? 0 : len % 4 - 1);
+#endif
+
+#if defined(SERDELITE_AVX2)
+    const __m256i wide62 = _mm256_set1_epi8(char62);
+    const __m256i wide63 = _mm256_set1_epi8(char63);
+
+    for (; i + 32 <= len && o + 32 <= outLen; i += 32, o += 24) {
+        uint32_t valid;
+        __m256i values = sextetValues(_mm256_loadu_si256(
+                             reinterpret_cast<const __m256i*>(src + i)),
+                             wide62, wide63, valid);
+        if (valid != 0xFFFFFFFFu) break;
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + o),
+                            mergeSextets(values));
+    }
+#endif
+
+#if defined(SERDELITE_SSSE3)
+    const __m128i narrow62 = _mm_set1_epi8(char62);
+    const __m128i narrow63 = _mm_set1_epi8(char63);
+
+    for (; i + 16 <= len && o + 16 <= outLen; i += 16, o += 12) {
+        int valid;
+        __m128i values = sextetValues(_mm_loadu_si128(
+                             reinterpret_cast<const __m128i*>(src + i)),
+                             narrow62, narrow63, valid);
+        if (valid != 0xFFFF) break;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + o),
+                         mergeSextets(values));
+    }
+#endif
+
+    for (; i + 4 <= len; i += 4) {
+        const uint8_t a = sextetValue(src[i], char62, char63);
+        const uint8_t b = sextetValue(src[i + 1], char62, char63);
+        const uint8_t c = sextetValue(src[i + 2], char62, char63);
+        const uint8_t d = sextetValue(src[i + 3], char62, char63);
+
+        if ((a | b | c | d) > 63) {
+            errorIndex = findInvalid(src, i, len, char62, char63);
+            return false;
+        }
+
+        dest[o++] = static_cast<uint8_t>((a << 2) | (b >> 4));
+        dest[o++] = static_cast<uint8_t>((b << 4) | (c >> 2));
+        dest[o++] = static_cast<uint8_t>((c << 6) | d);
+    }
+
+    const size_t rest = len - i;
+    if (rest == 0) return true;
+
+    const size_t invalid = findInvalid(src, i, len, char62, char63);
+    if (invalid < len) {
+        errorIndex = invalid;
+        return false;
+    }
+
+    const uint8_t a = sextetValue(src[i], char62, char63);
+    const uint8_t b = sextetValue(src[i + 1], char62, char63);
+    dest[o++] = static_cast<uint8_t>((a << 2) | (b >> 4));
+
+    // Strict decoding: the bits past the last byte must be zero
+    if (rest == 2) {
+        if (b & 0x0F) {
+            errorIndex = i + 1;
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t c = sextetValue(src[i + 2], char62, char63);
+    if (c & 0x03) {
+        errorIndex = i + 2;
+        return false;
+    }
+    dest[o] = static_cast<uint8_t>((b << 4) | (c >> 2));
+    return true;
+}
+
+} // namespace base64
+} // namespace serdelite
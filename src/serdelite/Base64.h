@@ -0,0 +1,84 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file Base64.h
+ * @brief Internal Base64 (RFC 4648) encoding and decoding kernels.
+ *
+ * Encoding splits 12 bytes (24 with AVX2) into 6-bit indices with one
+ * `pshufb` and two multiplies, then turns the indices into characters with a
+ * small shift table. Decoding classifies 16 (32) characters per step with
+ * range compares and merges the sextets back with `pmaddubsw`/`pmaddwd`.
+ * Both alphabets share the kernels: only the characters for 62 and 63
+ * differ. Other targets use a scalar loop with identical output.
+ *
+ * @note This header is private to the library sources and is not installed.
+ */
+
+#ifndef SERDELITE_BASE64_H
+#define SERDELITE_BASE64_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+namespace base64 {
+
+/**
+ * @brief Gives the number of characters `encode()` writes.
+ * @param count Number of bytes to encode.
+ * @param padded `true` to round up to whole 4-character groups with `=`.
+ */
+size_t encodedLength(size_t count, bool padded);
+
+/**
+ * @brief Writes the Base64 text of `count` bytes (no terminator).
+ * @param src The bytes to encode.
+ * @param count Number of bytes.
+ * @param[out] dest Destination of `encodedLength(count, padded)` characters.
+ * @param urlSafe `true` for the `-_` alphabet, `false` for `+/`.
+ * @param padded `true` to pad the last group with `=`.
+ */
+void encode(const uint8_t* src, size_t count, char* dest,
+            bool urlSafe, bool padded);
+
+/**
+ * @brief Checks the length and padding of Base64 text and sizes its bytes.
+ * @param src The text.
+ * @param len Number of characters in `src`.
+ * @param padded `true` if the text must be padded to whole groups, `false`
+ * 				 if it must carry no padding at all.
+ * @param[out] bodyLen Receives the number of characters before the padding.
+ * @param[out] outLen Receives the number of bytes the text decodes to.
+ * @param[out] errorIndex Receives the position of the offending character
+ * 						  on failure.
+ * @return Returns `false` if the text cannot be a complete encoding.
+ */
+bool measure(const char* src, size_t len, bool padded,
+             size_t& bodyLen, size_t& outLen, size_t& errorIndex);
+
+/**
+ * @brief Decodes Base64 characters (without padding) into bytes.
+ * @param src The characters, as reported by `measure()` in `bodyLen`.
+ * @param len Number of characters (not `1` modulo 4).
+ * @param[out] dest Destination of exactly the `outLen` bytes of `measure()`;
+ * 					nothing past them is written.
+ * @param urlSafe `true` for the `-_` alphabet, `false` for `+/`.
+ * @param[out] errorIndex Receives the position of the first character that is
+ * 						  outside the alphabet, or of a last character whose
+ * 						  unused bits are not zero.
+ * @return Returns `true` if every character is valid.
+ */
+bool decode(const char* src, size_t len, uint8_t* dest,
+            bool urlSafe, size_t& errorIndex);
+
+} // namespace base64
+} // namespace serdelite
+
+#endif
@@ -0,0 +1,328 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "BitPacking.h"
+#include "Simd.h"
+
+#include <string.h>
+
+namespace serdelite {
+namespace bitpacking {
+
+static inline uint8_t bitsNeeded(uint64_t val) {
+    uint8_t bits = 0;
+    while (val) {
+        bits++;
+        val >>= 1;
+    }
+    return bits;
+}
+
+uint8_t frameOfReference32(const uint32_t* in, size_t count,
+                           uint32_t* out, uint32_t& reference) {
+    if (count == 0) {
+        reference = 0;
+        return 0;
+    }
+
+    size_t i = 0;
+    uint32_t minVal = in[0];
+
+#if defined(SERDELITE_SSE41)
+    if (count >= 4) {
+        __m128i vmin = _mm_loadu_si128(
+                           reinterpret_cast<const __m128i*>(in));
+        for (i = 4; i + 4 <= count; i += 4) {
+            __m128i v = _mm_loadu_si128(
+                            reinterpret_cast<const __m128i*>(in + i));
+            vmin = _mm_min_epu32(vmin, v);
+        }
+        vmin = _mm_min_epu32(vmin, _mm_shuffle_epi32(vmin, 0x4E));
+        vmin = _mm_min_epu32(vmin, _mm_shuffle_epi32(vmin, 0xB1));
+        minVal = static_cast<uint32_t>(_mm_cvtsi128_si32(vmin));
+    }
+#endif
+    for (; i < count; i++) {
+        if (in[i] < minVal) minVal = in[i];
+    }
+
+    uint32_t bitsUsed = 0;
+    i = 0;
+
+#if defined(SERDELITE_SSE2)
+    const __m128i vref = _mm_set1_epi32(static_cast<int>(minVal));
+    __m128i vor = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_sub_epi32(
+                        _mm_loadu_si128(
+                            reinterpret_cast<const __m128i*>(in + i)),
+                        vref);
+        vor = _mm_or_si128(vor, v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+    }
+    vor = _mm_or_si128(vor, _mm_shuffle_epi32(vor, 0x4E));
+    vor = _mm_or_si128(vor, _mm_shuffle_epi32(vor, 0xB1));
+    bitsUsed = static_cast<uint32_t>(_mm_cvtsi128_si32(vor));
+#endif
+    for (; i < count; i++) {
+        out[i] = in[i] - minVal;
+        bitsUsed |= out[i];
+    }
+
+    reference = minVal;
+    return bitsNeeded(bitsUsed);
+}
+
+uint8_t frameOfReference64(const uint64_t* in, size_t count,
+                           uint64_t* out, uint64_t& reference) {
+    if (count == 0) {
+        reference = 0;
+        return 0;
+    }
+
+    uint64_t minVal = in[0];
+    for (size_t i = 1; i < count; i++) {
+        if (in[i] < minVal) minVal = in[i];
+    }
+
+    uint64_t bitsUsed = 0;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = in[i] - minVal;
+        bitsUsed |= out[i];
+    }
+
+    reference = minVal;
+    return bitsNeeded(bitsUsed);
+}
+
+void addReference32(uint32_t* values, size_t count, uint32_t reference) {
+    size_t i = 0;
+#if defined(SERDELITE_SSE2)
+    const __m128i vref = _mm_set1_epi32(static_cast<int>(reference));
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(values + i);
+        _mm_storeu_si128(p, _mm_add_epi32(_mm_loadu_si128(p), vref));
+    }
+#endif
+    for (; i < count; i++) values[i] += reference;
+}
+
+void addReference64(uint64_t* values, size_t count, uint64_t reference) {
+    for (size_t i = 0; i < count; i++) values[i] += reference;
+}
+
+void deltaEncode32(const uint32_t* in, size_t count,
+                   uint32_t prev, uint32_t* out) {
+    // Walk backwards so that `out` may alias `in`
+    for (size_t i = count; i > 1; i--) {
+        out[i - 1] = in[i - 1] - in[i - 2];
+    }
+    if (count > 0) out[0] = in[0] - prev;
+}
+
+void deltaEncode64(const uint64_t* in, size_t count,
+                   uint64_t prev, uint64_t* out) {
+    for (size_t i = count; i > 1; i--) {
+        out[i - 1] = in[i - 1] - in[i - 2];
+    }
+    if (count > 0) out[0] = in[0] - prev;
+}
+
+void deltaDecode32(uint32_t* values, size_t count, uint32_t prev) {
+    size_t i = 0;
+#if defined(SERDELITE_SSE2)
+    __m128i carry = _mm_set1_epi32(static_cast<int>(prev));
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(values + i);
+        __m128i v = _mm_loadu_si128(p);
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, carry);
+        _mm_storeu_si128(p, v);
+        carry = _mm_shuffle_epi32(v, 0xFF);
+    }
+    prev = static_cast<uint32_t>(_mm_cvtsi128_si32(carry));
+#endif
+    for (; i < count; i++) {
+        prev += values[i];
+        values[i] = prev;
+    }
+}
+
+void deltaDecode64(uint64_t* values, size_t count, uint64_t prev) {
+    for (size_t i = 0; i < count; i++) {
+        prev += values[i];
+        values[i] = prev;
+    }
+}
+
+#if defined(SERDELITE_SSE2)
+
+void pack128(const uint32_t* in, uint8_t bitWidth, uint32_t* out) {
+    if (bitWidth == 0) return;
+
+    __m128i* dst = reinterpret_cast<__m128i*>(out);
+    __m128i acc = _mm_setzero_si128();
+    uint32_t filled = 0;
+
+    for (size_t i = 0; i < 32; i++) {
+        __m128i v = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(in + i*4));
+
+        acc = _mm_or_si128(acc,
+                           _mm_sll_epi32(v, _mm_cvtsi32_si128(filled)));
+        filled += bitWidth;
+
+        if (filled >= 32) {
+            _mm_storeu_si128(dst++, acc);
+            filled -= 32;
+            acc = (filled > 0)
+                  ? _mm_srl_epi32(v, _mm_cvtsi32_si128(bitWidth - filled))
+                  : _mm_setzero_si128();
+        }
+    }
+}
+
+void unpack128(const uint32_t* in, uint8_t bitWidth, uint32_t* out) {
+    __m128i* dst = reinterpret_cast<__m128i*>(out);
+
+    if (bitWidth == 0) {
+        for (size_t i = 0; i < 32; i++)
+            _mm_storeu_si128(dst + i, _mm_setzero_si128());
+        return;
+    }
+
+    const __m128i mask = _mm_set1_epi32(
+                             bitWidth == 32
+                             ? -1
+                             : static_cast<int>((1u << bitWidth) - 1));
+
+    const __m128i* src = reinterpret_cast<const __m128i*>(in);
+    __m128i cur = _mm_loadu_si128(src++);
+    uint32_t consumed = 0;
+
+    for (size_t i = 0; i < 32; i++) {
+        __m128i v = _mm_srl_epi32(cur, _mm_cvtsi32_si128(consumed));
+        consumed += bitWidth;
+
+        if (consumed >= 32 && i < 31) {
+            consumed -= 32;
+            cur = _mm_loadu_si128(src++);
+            if (consumed > 0) {
+                v = _mm_or_si128(v,
+                        _mm_sll_epi32(cur,
+                            _mm_cvtsi32_si128(bitWidth - consumed)));
+            }
+        }
+
+        _mm_storeu_si128(dst + i, _mm_and_si128(v, mask));
+    }
+}
+
+#else
+
+void pack128(const uint32_t* in, uint8_t bitWidth, uint32_t* out) {
+    if (bitWidth == 0) return;
+
+    for (size_t lane = 0; lane < 4; lane++) {
+        uint64_t acc = 0;
+        uint32_t filled = 0;
+        size_t word = 0;
+
+        for (size_t i = 0; i < 32; i++) {
+            acc |= static_cast<uint64_t>(in[i*4 + lane]) << filled;
+            filled += bitWidth;
+
+            if (filled >= 32) {
+                out[word*4 + lane] = static_cast<uint32_t>(acc);
+                word++;
+                acc >>= 32;
+                filled -= 32;
+            }
+        }
+    }
+}
+
+void unpack128(const uint32_t* in, uint8_t bitWidth, uint32_t* out) {
+    if (bitWidth == 0) {
+        memset(out, 0, BLOCK_SIZE * sizeof(uint32_t));
+        return;
+    }
+
+    const uint64_t mask = (1ULL << bitWidth) - 1;
+
+    for (size_t lane = 0; lane < 4; lane++) {
+        uint64_t acc = 0;
+        uint32_t available = 0;
+        size_t word = 0;
+
+        for (size_t i = 0; i < 32; i++) {
+            if (available < bitWidth) {
+                acc |= static_cast<uint64_t>(in[word*4 + lane]) << available;
+                word++;
+                available += 32;
+            }
+            out[i*4 + lane] = static_cast<uint32_t>(acc & mask);
+            acc >>= bitWidth;
+            available -= bitWidth;
+        }
+    }
+}
+
+#endif
+
+void packTail(const uint64_t* in, size_t count,
+              uint8_t bitWidth, uint8_t* out) {
+    memset(out, 0, tailBytes(count, bitWidth));
+
+    size_t bitPos = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t val = in[i];
+        uint8_t remaining = bitWidth;
+
+        while (remaining > 0) {
+            const uint8_t offset = bitPos & 7;
+            uint8_t take = 8 - offset;
+            if (take > remaining) take = remaining;
+
+            out[bitPos >> 3] |= static_cast<uint8_t>(
+                                    (val & ((1u << take) - 1)) << offset);
+
+            val >>= take;
+            bitPos += take;
+            remaining -= take;
+        }
+    }
+}
+
+void unpackTail(const uint8_t* in, size_t count,
+                uint8_t bitWidth, uint64_t* out) {
+    size_t bitPos = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t val = 0;
+        uint8_t filled = 0;
+
+        while (filled < bitWidth) {
+            const uint8_t offset = bitPos & 7;
+            uint8_t take = 8 - offset;
+            if (take > bitWidth - filled) take = bitWidth - filled;
+
+            const uint64_t bits = (in[bitPos >> 3] >> offset) &
+                                  ((1u << take) - 1);
+            val |= bits << filled;
+
+            bitPos += take;
+            filled += take;
+        }
+        out[i] = val;
+    }
+}
+
+} // namespace bitpacking
+} // namespace serdelite
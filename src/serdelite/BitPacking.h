@@ -0,0 +1,121 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file BitPacking.h
+ * @brief Internal kernels behind the packed integer array codecs of `ByteStream`.
+ *
+ * Full blocks of 128 values are packed in a 4-lane interleaved layout: value
+ * `i` belongs to lane `i % 4` and every lane packs its 32 values LSB-first into
+ * consecutive 32-bit words, so word `k` of lane `l` lives at index `k*4 + l`.
+ * A block of bit width `b` therefore always occupies exactly `b*4` words and
+ * one 128-bit SIMD register moves one word of every lane at once. Partial
+ * blocks (the tail of an array) use a plain LSB-first bit stream.
+ *
+ * @note This header is private to the library sources and is not installed.
+ */
+
+#ifndef SERDELITE_BITPACKING_H
+#define SERDELITE_BITPACKING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+namespace bitpacking {
+
+/** @brief Number of values in one SIMD-packed block. */
+static const size_t BLOCK_SIZE = 128;
+
+/** @brief Number of 32-bit words a full block of the given bit width occupies. */
+static inline size_t blockWords(uint8_t bitWidth) {
+    return static_cast<size_t>(bitWidth) * 4;
+}
+
+/** @brief Number of bytes a tail of `count` values of the given bit width occupies. */
+static inline size_t tailBytes(size_t count, uint8_t bitWidth) {
+    return (count * bitWidth + 7) / 8;
+}
+
+/**
+ * @brief Subtracts the minimum of `in` from every value.
+ * @param in The source values.
+ * @param count Number of values.
+ * @param[out] out Destination of the offsets (may alias `in`).
+ * @param[out] reference The minimum that was subtracted.
+ * @return The number of bits needed to store the largest offset.
+ */
+uint8_t frameOfReference32(const uint32_t* in, size_t count,
+                           uint32_t* out, uint32_t& reference);
+
+/** @copydoc frameOfReference32 */
+uint8_t frameOfReference64(const uint64_t* in, size_t count,
+                           uint64_t* out, uint64_t& reference);
+
+/** @brief Adds `reference` back to every value (inverse of frameOfReference). */
+void addReference32(uint32_t* values, size_t count, uint32_t reference);
+
+/** @copydoc addReference32 */
+void addReference64(uint64_t* values, size_t count, uint64_t reference);
+
+/**
+ * @brief Replaces each value by its difference to the previous one.
+ * @param in The source values.
+ * @param count Number of values.
+ * @param prev The value preceding `in[0]`.
+ * @param[out] out Destination of the deltas (may alias `in`).
+ * @note Differences wrap around, so unsorted input still round-trips.
+ */
+void deltaEncode32(const uint32_t* in, size_t count,
+                   uint32_t prev, uint32_t* out);
+
+/** @copydoc deltaEncode32 */
+void deltaEncode64(const uint64_t* in, size_t count,
+                   uint64_t prev, uint64_t* out);
+
+/** @brief In-place prefix sum starting from `prev` (inverse of deltaEncode). */
+void deltaDecode32(uint32_t* values, size_t count, uint32_t prev);
+
+/** @copydoc deltaDecode32 */
+void deltaDecode64(uint64_t* values, size_t count, uint64_t prev);
+
+/**
+ * @brief Packs a full block of 128 values, each fitting in `bitWidth` bits.
+ * @param in 128 source values.
+ * @param bitWidth Bits per value (0-32).
+ * @param[out] out Destination of `blockWords(bitWidth)` words.
+ */
+void pack128(const uint32_t* in, uint8_t bitWidth, uint32_t* out);
+
+/**
+ * @brief Unpacks a full block of 128 values (inverse of pack128).
+ * @param in `blockWords(bitWidth)` packed words.
+ * @param bitWidth Bits per value (0-32).
+ * @param[out] out Destination of 128 values.
+ */
+void unpack128(const uint32_t* in, uint8_t bitWidth, uint32_t* out);
+
+/**
+ * @brief Packs fewer than a block of values into an LSB-first bit stream.
+ * @param in The source values, each fitting in `bitWidth` bits.
+ * @param count Number of values.
+ * @param bitWidth Bits per value (0-64).
+ * @param[out] out Destination of `tailBytes(count, bitWidth)` bytes.
+ */
+void packTail(const uint64_t* in, size_t count,
+              uint8_t bitWidth, uint8_t* out);
+
+/** @brief Unpacks an LSB-first bit stream (inverse of packTail). */
+void unpackTail(const uint8_t* in, size_t count,
+                uint8_t bitWidth, uint64_t* out);
+
+} // namespace bitpacking
+} // namespace serdelite
+
+#endif
@@ -0,0 +1,228 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "serdelite/BufferStorage.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <malloc.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <stdlib.h>
+#endif
+
+namespace serdelite {
+
+static const size_t CACHE_LINE_SIZE = 64;
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Rounds up to a power-of-two multiple; 0 on overflow
+static size_t roundUp(size_t value, size_t multiple) {
+    if (value > static_cast<size_t>(-1) - (multiple - 1)) return 0;
+    return (value + multiple - 1) & ~(multiple - 1);
+}
+
+static uint8_t* allocateHeap(size_t size) {
+#if defined(_WIN32)
+    return static_cast<uint8_t*>(_aligned_malloc(size, CACHE_LINE_SIZE));
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, CACHE_LINE_SIZE, size) != 0) return nullptr;
+    return static_cast<uint8_t*>(ptr);
+#endif
+}
+
+#if defined(_WIN32)
+
+static uint8_t* mapPages(size_t size, DWORD extraFlags) {
+    return static_cast<uint8_t*>(
+               VirtualAlloc(nullptr, size,
+                            MEM_RESERVE | MEM_COMMIT | extraFlags,
+                            PAGE_READWRITE));
+}
+
+#if !defined(SERDELITE_NO_HUGE_PAGES)
+
+// Large pages need the "Lock pages in memory" privilege; without it the
+// allocation fails and the caller falls back to regular pages
+static uint8_t* mapHugePages(size_t& size) {
+    const size_t largePage = GetLargePageMinimum();
+    if (largePage == 0) return nullptr;
+
+    const size_t largeSize = roundUp(size, largePage);
+    if (largeSize == 0) return nullptr;
+
+    uint8_t* bytes = mapPages(largeSize, MEM_LARGE_PAGES);
+    if (bytes) size = largeSize;
+    return bytes;
+}
+
+#endif
+
+#else
+
+static uint8_t* mapPages(size_t size, int extraFlags) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+    return (ptr == MAP_FAILED) ? nullptr : static_cast<uint8_t*>(ptr);
+}
+
+#if !defined(SERDELITE_NO_HUGE_PAGES)
+
+static uint8_t* mapHugePages(size_t& size) {
+    size = roundUp(size, HUGE_PAGE_SIZE);
+    if (size == 0) return nullptr;
+
+#if defined(MAP_HUGETLB)
+    // Explicit huge pages, from the pool reserved by the administrator
+    int hugeFlags = MAP_HUGETLB;
+    #if defined(MAP_HUGE_2MB)
+    hugeFlags |= MAP_HUGE_2MB;
+    #endif
+    uint8_t* bytes = mapPages(size, hugeFlags);
+    if (bytes) return bytes;
+#endif
+
+#if defined(MADV_HUGEPAGE)
+    // Transparent huge pages: over-map, trim to a 2 MB boundary and advise
+    if (size > static_cast<size_t>(-1) - HUGE_PAGE_SIZE) return nullptr;
+
+    uint8_t* raw = mapPages(size + HUGE_PAGE_SIZE, 0);
+    if (!raw) return nullptr;
+
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = (addr + HUGE_PAGE_SIZE - 1) &
+                              ~static_cast<uintptr_t>(HUGE_PAGE_SIZE - 1);
+    const size_t head = static_cast<size_t>(aligned - addr);
+    const size_t tail = HUGE_PAGE_SIZE - head;
+
+    if (head > 0) munmap(raw, head);
+    if (tail > 0) munmap(reinterpret_cast<uint8_t*>(aligned) + size, tail);
+
+    uint8_t* advised = reinterpret_cast<uint8_t*>(aligned);
+    if (madvise(advised, size, MADV_HUGEPAGE) == 0) return advised;
+
+    munmap(advised, size);
+#endif
+
+    return nullptr;
+}
+
+#endif
+
+#endif
+
+BufferStorage::BufferStorage(size_t _capacity, BufferMemory _memory)
+    : bytes(nullptr),
+      capacity(0),
+      memory(_memory),
+      isMapped(_memory != BufferMemory::CacheAligned)
+{
+    if (_capacity == 0) return;
+
+    size_t size = _capacity;
+
+    if (_memory == BufferMemory::CacheAligned) {
+        size = roundUp(size, CACHE_LINE_SIZE);
+        if (size > 0) this->bytes = allocateHeap(size);
+    } else {
+#if !defined(SERDELITE_NO_HUGE_PAGES)
+        if (_memory == BufferMemory::HugePages) {
+            this->bytes = mapHugePages(size);
+        }
+#endif
+
+        // Plain pages: requested, or the fallback for huge pages
+        if (!this->bytes) {
+            this->memory = BufferMemory::PageAligned;
+            size = roundUp(_capacity, getPageSize());
+            if (size > 0) this->bytes = mapPages(size, 0);
+        }
+    }
+
+    if (this->bytes) this->capacity = size;
+}
+
+BufferStorage::BufferStorage(BufferStorage&& other)
+    : bytes(other.bytes),
+      capacity(other.capacity),
+      memory(other.memory),
+      isMapped(other.isMapped)
+{
+    other.bytes = nullptr;
+    other.capacity = 0;
+}
+
+BufferStorage& BufferStorage::operator=(BufferStorage&& other) {
+    if (this == &other) return *this;
+
+    release();
+
+    this->bytes = other.bytes;
+    this->capacity = other.capacity;
+    this->memory = other.memory;
+    this->isMapped = other.isMapped;
+
+    other.bytes = nullptr;
+    other.capacity = 0;
+    return *this;
+}
+
+BufferStorage::~BufferStorage() {
+    release();
+}
+
+void BufferStorage::release() {
+    if (!this->bytes) return;
+
+#if defined(_WIN32)
+    if (this->isMapped) VirtualFree(this->bytes, 0, MEM_RELEASE);
+    else _aligned_free(this->bytes);
+#else
+    if (this->isMapped) munmap(this->bytes, this->capacity);
+    else free(this->bytes);
+#endif
+
+    this->bytes = nullptr;
+    this->capacity = 0;
+}
+
+bool BufferStorage::isValid() const {
+    return this->bytes != nullptr;
+}
+
+uint8_t* BufferStorage::getBytes() {
+    return this->bytes;
+}
+
+const uint8_t* BufferStorage::getBytes() const {
+    return this->bytes;
+}
+
+size_t BufferStorage::getCapacity() const {
+    return this->capacity;
+}
+
+BufferMemory BufferStorage::getMemory() const {
+    return this->memory;
+}
+
+size_t BufferStorage::getPageSize() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#else
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    return (pageSize > 0) ? static_cast<size_t>(pageSize) : 4096;
+#endif
+}
+
+}
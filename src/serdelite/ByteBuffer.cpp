@@ -8,6 +8,8 @@
  */
 
 #include "serdelite/ByteBuffer.h"
+#include "Base64.h"
+#include "Hex.h"
 
 #include <string.h>
 #include <assert.h>
@@ -17,18 +19,22 @@ namespace serdelite {
 
 ByteBuffer::ByteBuffer(uint8_t* buffer,
                        size_t bufferCapacity,
-                       Endian endianOrder)
+                       Endian endianOrder,
+                       ZeroPolicy zeroPolicy)
     : bytes(buffer),
       capacity(bufferCapacity),
       length(0),
-      order(endianOrder)
+      order(endianOrder),
+      zeroing(zeroPolicy),
+      highWaterMark(0)
 {
     assert(this->bytes != nullptr &&
            "ByteBuffer requires valid memory");
     assert(bufferCapacity > 0 &&
            "ByteBuffer requires a valid non-zero capacity");
 
-    memset(this->bytes, 0, bufferCapacity);
+    if (this->zeroing == ZeroPolicy::Full)
+        memset(this->bytes, 0, bufferCapacity);
 }
 
 bool ByteBuffer::toString(char* dest,
@@ -63,52 +69,138 @@ bool ByteBuffer::toHex(char* dest,
 
     if (!dest || destCapacity < minReqCapacity) return false;
 
-    const char hexChars[] = "0123456789ABCDEF";
+    hex::encode(this->bytes, this->length, dest, true);
 
-    size_t destIndex = 0;
-    for (size_t i=0; i<this->length; i++) {
-        // First 4-bits (High nibble)
-        const size_t highNibbleValue = (this->bytes[i] >> 4) & 0x0F;
+    dest[this->length << 1] = '\0';
+    return true;
+}
 
-        // Last 4-bits (Low nibbl)
-        const size_t lowNibbleValue = this->bytes[i] & 0x0F;
 
-        dest[destIndex++] = hexChars[highNibbleValue];
-        dest[destIndex++] = hexChars[lowNibbleValue];
-    }
+size_t ByteBuffer::getBase64Length(bool padded) const {
+    return base64::encodedLength(this->length, padded);
+}
 
-    dest[destIndex] = '\0';
+bool ByteBuffer::toBase64(char* dest,
+                          size_t destCapacity,
+                          Base64Alphabet alphabet,
+                          bool padded) const {
+    const size_t textLen = getBase64Length(padded);
+
+    if (!dest || destCapacity < textLen + 1) return false;
+
+    base64::encode(this->bytes, this->length, dest,
+                   alphabet == Base64Alphabet::UrlSafe, padded);
+
+    dest[textLen] = '\0';
     return true;
 }
 
+bool ByteBuffer::fromBase64(const char* text,
+                            Base64Alphabet alphabet,
+                            bool padded) {
+    size_t errorIndex;
+    return fromBase64(text, errorIndex, alphabet, padded);
+}
+
+bool ByteBuffer::fromBase64(const char* text,
+                            size_t& errorIndex,
+                            Base64Alphabet alphabet,
+                            bool padded) {
+    errorIndex = 0;
+    if (!text || !this->bytes) return false;
+
+    const size_t len = strlen(text);
+    size_t bodyLen, outLen;
+    if (!base64::measure(text, len, padded, bodyLen, outLen, errorIndex))
+        return false;
+
+    // The exact size is known up front: report the first group that overflows
+    if (outLen > getSpaceLeft()) {
+        errorIndex = (getSpaceLeft() / 3) * 4;
+        return false;
+    }
+
+    // A failed decode leaves bytes past the length: let erase() reach them
+    if (this->length + outLen > this->highWaterMark)
+        this->highWaterMark = this->length + outLen;
+
+    if (!base64::decode(text, bodyLen, this->bytes + this->length,
+                        alphabet == Base64Alphabet::UrlSafe, errorIndex))
+        return false;
+
+    this->length += outLen;
+    errorIndex = len;
+    return true;
+}
 
 void ByteBuffer::dump() const {
     printf("\n--- ByteBuffer Dump (Length: %zu) ---\n", length);
-    
-    for (size_t i = 0; i < length; i += 16) {
-        // 1. Print the memory offset (e.g., 0000, 0010)
-        printf("%04zx: ", i);
-
-        // 2. Print the Hex values
-        for (size_t j = 0; j < 16; j++) {
-            if (i + j < length)
-                printf("%02X ", bytes[i + j]);
-            else
-                printf("   "); // Space if the buffer ends early
-        }
 
-        printf(" | ");
+    hexDump([](const char* text, size_t len) {
+        return fwrite(text, 1, len, stdout) == len;
+    });
+
+    printf("--------------------------------------\n");
+}
+
+// Offset column width: 8 digits, or 16 once offsets exceed 32 bits
+static size_t dumpOffsetDigits(size_t length) {
+    return (static_cast<uint64_t>(length) > 0xFFFFFFFFULL) ? 16 : 8;
+}
+
+size_t ByteBuffer::getHexDumpLength() const {
+    const size_t offsetDigits = dumpOffsetDigits(this->length);
+    const size_t fullLines = this->length / hex::DUMP_WIDTH;
+    const size_t rest = this->length % hex::DUMP_WIDTH;
 
-        // 3. Print the printable characters (Sanitized String)
-        for (size_t j = 0; j < 16; j++) {
-            if (i + j < length) {
-                uint8_t b = bytes[i + j];
-                printf("%c", (b >= 32 && b <= 126) ? (char)b : '.');
-            }
+    size_t total = fullLines * hex::dumpLineLength(hex::DUMP_WIDTH, offsetDigits);
+    if (rest > 0) total += hex::dumpLineLength(rest, offsetDigits);
+    return total;
+}
+
+bool ByteBuffer::hexDump(ByteBuffer& dest) const {
+    if (&dest == this || !dest.bytes) return false;
+    if (dest.getSpaceLeft() < getHexDumpLength()) return false;
+
+    const size_t offsetDigits = dumpOffsetDigits(this->length);
+    char* out = reinterpret_cast<char*>(dest.bytes + dest.length);
+
+    for (size_t i = 0; i < this->length; i += hex::DUMP_WIDTH) {
+        const size_t count = (this->length - i < hex::DUMP_WIDTH)
+                             ? this->length - i
+                             : hex::DUMP_WIDTH;
+        out += hex::dumpLine(this->bytes + i, count, i, offsetDigits, out);
+    }
+
+    dest.length = static_cast<size_t>(
+                      reinterpret_cast<uint8_t*>(out) - dest.bytes);
+    return true;
+}
+
+bool ByteBuffer::hexDump(const TextSink& sink) const {
+    if (!sink) return false;
+
+    // Lines are flushed a few kilobytes at a time
+    const size_t LINES_PER_CHUNK = 32;
+    char chunk[LINES_PER_CHUNK * hex::MAX_DUMP_LINE];
+
+    const size_t offsetDigits = dumpOffsetDigits(this->length);
+    size_t used = 0;
+
+    for (size_t i = 0; i < this->length; i += hex::DUMP_WIDTH) {
+        if (sizeof(chunk) - used < hex::MAX_DUMP_LINE) {
+            if (!sink(chunk, used)) return false;
+            used = 0;
         }
-        printf("\n");
+
+        const size_t count = (this->length - i < hex::DUMP_WIDTH)
+                             ? this->length - i
+                             : hex::DUMP_WIDTH;
+        used += hex::dumpLine(this->bytes + i, count, i, offsetDigits,
+                              chunk + used);
     }
-    printf("--------------------------------------\n");
+
+    return used == 0 || sink(chunk, used);
 }
 
 bool ByteBuffer::addByte(uint8_t byte) {
@@ -119,6 +211,7 @@ bool ByteBuffer::addByte(uint8_t byte) {
 
 bool ByteBuffer::setLength(size_t newLength) {
     if (newLength > this->capacity) return false;
+    if (newLength < this->length) recordHighWater();
     this->length = newLength;
     return true;
 }
@@ -128,12 +221,50 @@ void ByteBuffer::setEndianOrder(Endian endianOrder) {
 }
 
 void ByteBuffer::clear() {
+    recordHighWater();
     this->length = 0;
 }
 
 void ByteBuffer::erase() {
-    memset(this->bytes, 0, this->capacity);
+    recordHighWater();
+
+    switch (this->zeroing) {
+    case ZeroPolicy::Full:
+        memset(this->bytes, 0, this->capacity);
+        break;
+    case ZeroPolicy::WrittenPrefix:
+        memset(this->bytes, 0, this->highWaterMark);
+        break;
+    case ZeroPolicy::None:
+        break;
+    }
+
     this->length=0;
+    this->highWaterMark = 0;
+}
+
+bool ByteBuffer::slice(size_t offset, size_t len, ByteBuffer& view) {
+    return static_cast<const ByteBuffer&>(*this).slice(offset, len, view);
+}
+
+bool ByteBuffer::slice(size_t offset, size_t len, ByteBuffer& view) const {
+    // Lengths come off the wire: compare without overflowing the sum
+    if (offset > this->length || len > this->length - offset) return false;
+
+    // Assign rather than construct: the constructor would reject an empty view
+    view.bytes = this->bytes + offset;
+    view.length = len;
+    view.capacity = len;
+    view.order = this->order;
+    view.zeroing = ZeroPolicy::None;
+    view.highWaterMark = 0;
+    return true;
+}
+
+// Shrinking hides written bytes from `length`; remember them for erase()
+void ByteBuffer::recordHighWater() {
+    if (this->length > this->highWaterMark)
+        this->highWaterMark = this->length;
 }
 
 bool ByteBuffer::isFull() const {
@@ -171,13 +302,24 @@ Endian ByteBuffer::getEndianOrder() const {
     return this->order; 
 }
 
+ZeroPolicy ByteBuffer::getZeroPolicy() const {
+    return this->zeroing;
+}
+
 bool ByteBuffer::fromHex(const char* hexStr) {
-    if (!hexStr) return false;
-    size_t i = 0;
+    size_t errorIndex;
+    return fromHex(hexStr, errorIndex);
+}
+
+bool ByteBuffer::fromHex(const char* hexStr, size_t& errorIndex) {
+    errorIndex = 0;
+    if (!hexStr || !this->bytes) return false;
 
-    size_t startLen = this->length;
+    const size_t len = strlen(hexStr);
+    const size_t startLen = this->length;
+    size_t i = 0;
 
-    while (hexStr[i] != '\0') {
+    while (i < len) {
         // Skip common separators like space, colon, or dash
         if (hexStr[i] == ' ' || 
             hexStr[i] == ':' || 
@@ -185,37 +327,35 @@ bool ByteBuffer::fromHex(const char* hexStr) {
             i++; continue;
         }
 
-        // We need at least two characters for one byte
-        if (hexStr[i + 1] == '\0') {
-            this->length = startLen;
-            return false;
-        }
-
-        uint8_t high = hexToNibble(hexStr[i]);
-        uint8_t low = hexToNibble(hexStr[i + 1]);
-
-        // If either character was not a valid hex digit (0-9, A-F)
-        if (high > 15 || low > 15) {
-            this->length = startLen;
-            return false;
-        }
-
-        // Combine nibbles and add to buffer
-        if (!addByte((high << 4) | low)) {
-            this->length = startLen;
-            return false;
+        // Decode the whole run of digit pairs that fits in one go
+        const size_t pairs = (len - i) / 2;
+        const size_t maxBytes = (pairs < getSpaceLeft()) ? pairs : getSpaceLeft();
+        const size_t decoded = hex::decode(hexStr + i, maxBytes,
+                                           this->bytes + this->length);
+        this->length += decoded;
+        i += decoded * 2;
+        if (decoded > 0) continue;
+
+        // The run ended on something that is not a pair of digits
+        if (i + 1 >= len || hexToNibble(hexStr[i]) > 15) {
+            errorIndex = i;
+        } else if (hexToNibble(hexStr[i + 1]) > 15) {
+            errorIndex = i + 1;
+        } else {
+            errorIndex = i;     // The buffer is full
         }
 
-        i += 2;
+        recordHighWater();      // The decoded bytes stay behind the length
+        this->length = startLen;
+        return false;
     }
+
+    errorIndex = len;
     return true;
 }
 
 uint8_t ByteBuffer::hexToNibble(char c) const {
-    if (c >= '0' && c <= '9') return c - '0';
-    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
-    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
-    return 255; // Invalid
+    return hex::digitValue(c); // 255 if invalid
 }
 
 
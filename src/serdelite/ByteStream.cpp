@@ -9,11 +9,201 @@
 
 #include "serdelite/ByteStream.h"
 #include "serdelite/Common.h"
+#include "BitPacking.h"
+#include "Simd.h"
 
 #include <string.h>
 
 namespace serdelite {
 
+/*
+ * Copies `count` scalars of `elemSize` bytes, reversing the bytes of every
+ * element when the buffer's endian order differs from the host's.
+ */
+static inline void copyScalars(uint8_t* dst, const uint8_t* src,
+                               size_t elemSize, size_t count,
+                               bool swapBytes) {
+    if (!swapBytes || elemSize == 1) {
+        memcpy(dst, src, elemSize * count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < elemSize; j++) {
+            dst[j] = src[elemSize - 1 - j];
+        }
+        dst += elemSize;
+        src += elemSize;
+    }
+}
+
+/*
+ * Sets bit `i` of `bitmap` for every element that differs bitwise from
+ * `defaultValue`, returning the number of set bits. Common element widths
+ * are compared 8 or 16 at a time with SIMD compares.
+ */
+static size_t buildPresenceBitmap(const uint8_t* values, size_t count,
+                                  size_t elemSize,
+                                  const uint8_t* defaultValue,
+                                  uint8_t* bitmap) {
+    const size_t bitmapBytes = (count + 7) / 8;
+    memset(bitmap, 0, bitmapBytes);
+
+    size_t i = 0;
+
+#if defined(SERDELITE_SSE2)
+    const __m128i* src = reinterpret_cast<const __m128i*>(values);
+
+    if (elemSize == 1) {
+        const __m128i vdef = _mm_set1_epi8(
+                                 static_cast<char>(defaultValue[0]));
+        for (; i + 16 <= count; i += 16) {
+            __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(src++), vdef);
+            uint32_t present = ~static_cast<uint32_t>(
+                                   _mm_movemask_epi8(eq));
+            bitmap[i >> 3] = static_cast<uint8_t>(present);
+            bitmap[(i >> 3) + 1] = static_cast<uint8_t>(present >> 8);
+        }
+    } else if (elemSize == 2) {
+        uint16_t def;
+        memcpy(&def, defaultValue, sizeof(def));
+        const __m128i vdef = _mm_set1_epi16(static_cast<short>(def));
+        for (; i + 8 <= count; i += 8) {
+            __m128i eq = _mm_cmpeq_epi16(_mm_loadu_si128(src++), vdef);
+            eq = _mm_packs_epi16(eq, _mm_setzero_si128());
+            bitmap[i >> 3] = static_cast<uint8_t>(
+                                 ~_mm_movemask_epi8(eq));
+        }
+    } else if (elemSize == 4) {
+        uint32_t def;
+        memcpy(&def, defaultValue, sizeof(def));
+        const __m128i vdef = _mm_set1_epi32(static_cast<int>(def));
+        for (; i + 8 <= count; i += 8) {
+            __m128i eq0 = _mm_cmpeq_epi32(_mm_loadu_si128(src++), vdef);
+            __m128i eq1 = _mm_cmpeq_epi32(_mm_loadu_si128(src++), vdef);
+            int same = _mm_movemask_ps(_mm_castsi128_ps(eq0)) |
+                       (_mm_movemask_ps(_mm_castsi128_ps(eq1)) << 4);
+            bitmap[i >> 3] = static_cast<uint8_t>(~same);
+        }
+    } else if (elemSize == 8) {
+        uint32_t def[2];
+        memcpy(def, defaultValue, sizeof(def));
+        const __m128i vdef = _mm_set_epi32(static_cast<int>(def[1]),
+                                           static_cast<int>(def[0]),
+                                           static_cast<int>(def[1]),
+                                           static_cast<int>(def[0]));
+        for (; i + 8 <= count; i += 8) {
+            int same = 0;
+            for (int k = 0; k < 4; k++) {
+                __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(src++), vdef);
+                // Both 32-bit halves must match for a 64-bit element
+                eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, 0xB1));
+                same |= _mm_movemask_pd(_mm_castsi128_pd(eq)) << (k * 2);
+            }
+            bitmap[i >> 3] = static_cast<uint8_t>(~same);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (memcmp(values + i * elemSize, defaultValue, elemSize) != 0)
+            bitmap[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+    }
+
+    size_t present = 0;
+    for (size_t b = 0; b < bitmapBytes; b++)
+        present += popCount64(bitmap[b]);
+    return present;
+}
+
+/*
+ * Width specific steps of the packed integer array codecs. A block is first
+ * (optionally) delta encoded, then reduced to offsets from its minimum.
+ */
+static uint8_t encodeBlock(const uint32_t* values, size_t count,
+                           IntArrayCodec codec, uint32_t prev,
+                           uint32_t* offsets, uint32_t& reference) {
+    const uint32_t* src = values;
+    if (codec == IntArrayCodec::Delta) {
+        bitpacking::deltaEncode32(values, count, prev, offsets);
+        src = offsets;
+    }
+    return bitpacking::frameOfReference32(src, count, offsets, reference);
+}
+
+static uint8_t encodeBlock(const uint64_t* values, size_t count,
+                           IntArrayCodec codec, uint64_t prev,
+                           uint64_t* offsets, uint64_t& reference) {
+    const uint64_t* src = values;
+    if (codec == IntArrayCodec::Delta) {
+        bitpacking::deltaEncode64(values, count, prev, offsets);
+        src = offsets;
+    }
+    return bitpacking::frameOfReference64(src, count, offsets, reference);
+}
+
+static void restoreBlock(uint32_t* values, size_t count,
+                         IntArrayCodec codec, uint32_t reference,
+                         uint32_t prev) {
+    bitpacking::addReference32(values, count, reference);
+    if (codec == IntArrayCodec::Delta)
+        bitpacking::deltaDecode32(values, count, prev);
+}
+
+static void restoreBlock(uint64_t* values, size_t count,
+                         IntArrayCodec codec, uint64_t reference,
+                         uint64_t prev) {
+    bitpacking::addReference64(values, count, reference);
+    if (codec == IntArrayCodec::Delta)
+        bitpacking::deltaDecode64(values, count, prev);
+}
+
+static void packBlock(const uint32_t* offsets, uint8_t bitWidth,
+                      uint32_t* words) {
+    bitpacking::pack128(offsets, bitWidth, words);
+}
+
+// 64-bit offsets are split into a low and a high half that are packed
+// separately, which keeps the total at bitWidth*4 words.
+static void packBlock(const uint64_t* offsets, uint8_t bitWidth,
+                      uint32_t* words) {
+    const uint8_t lowWidth = (bitWidth > 32) ? 32 : bitWidth;
+    const uint8_t highWidth = (bitWidth > 32) ? bitWidth - 32 : 0;
+    uint32_t half[bitpacking::BLOCK_SIZE];
+
+    for (size_t i = 0; i < bitpacking::BLOCK_SIZE; i++)
+        half[i] = static_cast<uint32_t>(offsets[i]);
+    bitpacking::pack128(half, lowWidth, words);
+
+    if (highWidth == 0) return;
+
+    for (size_t i = 0; i < bitpacking::BLOCK_SIZE; i++)
+        half[i] = static_cast<uint32_t>(offsets[i] >> 32);
+    bitpacking::pack128(half, highWidth,
+                        words + bitpacking::blockWords(lowWidth));
+}
+
+static void unpackBlock(const uint32_t* words, uint8_t bitWidth,
+                        uint32_t* out) {
+    bitpacking::unpack128(words, bitWidth, out);
+}
+
+static void unpackBlock(const uint32_t* words, uint8_t bitWidth,
+                        uint64_t* out) {
+    const uint8_t lowWidth = (bitWidth > 32) ? 32 : bitWidth;
+    const uint8_t highWidth = (bitWidth > 32) ? bitWidth - 32 : 0;
+    uint32_t low[bitpacking::BLOCK_SIZE];
+    uint32_t high[bitpacking::BLOCK_SIZE];
+
+    bitpacking::unpack128(words, lowWidth, low);
+    bitpacking::unpack128(words + bitpacking::blockWords(lowWidth),
+                          highWidth, high);
+
+    for (size_t i = 0; i < bitpacking::BLOCK_SIZE; i++) {
+        out[i] = (static_cast<uint64_t>(high[i]) << 32) | low[i];
+    }
+}
+
 ByteStream::ByteStream(ByteBuffer& _buffer)
     : buffer(_buffer), readPos(0)
 {
@@ -114,6 +304,33 @@ bool ByteStream::readObject(ByteSerializable& obj) {
     return obj.fromByteStream(*this);
 }
 
+bool ByteStream::writePresenceMask(const PresenceMask& mask) {
+    const size_t bytes = mask.byteSize();
+    if (!canWrite(bytes)) return false;
+
+    const uint64_t bits = mask.getBits();
+    for (size_t i = 0; i < bytes; i++) {
+        this->buffer.addByte(static_cast<uint8_t>(bits >> (i * 8)));
+    }
+    return true;
+}
+
+bool ByteStream::readPresenceMask(PresenceMask& mask) {
+    const size_t bytes = mask.byteSize();
+    if (!canRead(bytes)) return false;
+
+    uint64_t bits = 0;
+    const uint8_t* raw = this->buffer.getRawBytes() + this->readPos;
+    for (size_t i = 0; i < bytes; i++) {
+        bits |= static_cast<uint64_t>(raw[i]) << (i * 8);
+    }
+
+    if (!mask.setBits(bits)) return false;
+
+    this->readPos += bytes;
+    return true;
+}
+
 bool ByteStream::writeUint8(uint8_t val) {
     return this->buffer.addByte(val);
 }
@@ -163,6 +380,23 @@ bool ByteStream::writeDouble(double val) {
     return writeUint64(bits);
 }
 
+#if defined(SERDELITE_HAS_INT128)
+bool ByteStream::writeUint128(uint128_t val) {
+    return writeScalars(&val, sizeof(uint128_t), 1);
+}
+
+bool ByteStream::writeInt128(int128_t val) {
+    return writeScalars(&val, sizeof(int128_t), 1);
+}
+
+bool ByteStream::writeDecimal(const Decimal& val) {
+    if (!canWrite(sizeof(uint8_t) + sizeof(int128_t))) return false;
+
+    return writeUint8(val.getScale()) &&
+           writeInt128(val.getUnits());
+}
+#endif
+
 bool ByteStream::writeChars(const char* str, size_t length) {
     if (!str) return false;
     if (!canWrite(length)) return false;
@@ -196,6 +430,33 @@ bool ByteStream::writeBool(bool val) {
     return writeUint8(val ? 1 : 0);
 }
 
+bool ByteStream::writeString(const std::string& str) {
+    constexpr size_t UINT16_MAX_VALUE = 0xFFFF;
+    if (str.size() > UINT16_MAX_VALUE ||
+        !canWrite(sizeof(uint16_t) + str.size())) return false;
+
+    writeUint16(static_cast<uint16_t>(str.size()));
+    return writeScalars(str.data(), 1, str.size());
+}
+
+bool ByteStream::readString(std::string& out) {
+    size_t startPos = this->readPos;
+
+    uint16_t len;
+    if (!readUint16(len)) return false;
+
+    if (!canRead(len)) {
+        this->readPos = startPos;
+        return false;
+    }
+
+    const char* raw = reinterpret_cast<const char*>(
+                          this->buffer.getRawBytes() + this->readPos);
+    out.assign(raw, len);
+    this->readPos += len;
+    return true;
+}
+
 bool ByteStream::readUint8(uint8_t& out) {
     if (!canRead(sizeof(uint8_t))) return false;
 
@@ -303,6 +564,32 @@ bool ByteStream::readDouble(double& out) {
     return true;
 }
 
+#if defined(SERDELITE_HAS_INT128)
+bool ByteStream::readUint128(uint128_t& out) {
+    return readScalars(&out, sizeof(uint128_t), 1);
+}
+
+bool ByteStream::readInt128(int128_t& out) {
+    return readScalars(&out, sizeof(int128_t), 1);
+}
+
+bool ByteStream::readDecimal(Decimal& out) {
+    if (!canRead(sizeof(uint8_t) + sizeof(int128_t))) return false;
+
+    uint8_t scale;
+    int128_t units;
+    size_t startPos = this->readPos;
+    if (!readUint8(scale) || !readInt128(units) ||
+        scale > Decimal::MAX_SCALE) {
+        this->readPos = startPos;
+        return false;
+    }
+
+    out = Decimal(units, scale);
+    return true;
+}
+#endif
+
 bool ByteStream::readChars(char* dest, size_t length) {
     if (!canRead(length)) return false;
 
@@ -334,10 +621,96 @@ bool ByteStream::readBool(bool& out) {
     return true;
 }
 
+bool ByteStream::writePackedUint32Array(const uint32_t* values,
+                                        size_t count,
+                                        IntArrayCodec codec) {
+    return writePackedArray(values, count, codec);
+}
+
+bool ByteStream::writePackedUint64Array(const uint64_t* values,
+                                        size_t count,
+                                        IntArrayCodec codec) {
+    return writePackedArray(values, count, codec);
+}
+
+bool ByteStream::readPackedUint32Array(uint32_t* dest,
+                                       size_t destCapacity,
+                                       size_t& outCount) {
+    return readPackedArray(dest, destCapacity, outCount);
+}
+
+bool ByteStream::readPackedUint64Array(uint64_t* dest,
+                                       size_t destCapacity,
+                                       size_t& outCount) {
+    return readPackedArray(dest, destCapacity, outCount);
+}
+
+bool ByteStream::writeMessage(const void* obj,
+                              const MessageDescriptor& descriptor) {
+    if (!obj) return false;
+
+    size_t startLen = this->buffer.getSize();
+    if (!writeDescribed(static_cast<const uint8_t*>(obj), descriptor)) {
+        this->buffer.setLength(startLen);
+        return false;
+    }
+    return true;
+}
+
+bool ByteStream::readMessage(void* obj,
+                             const MessageDescriptor& descriptor) {
+    if (!obj) return false;
+
+    size_t startPos = this->readPos;
+    if (!readDescribed(static_cast<uint8_t*>(obj), descriptor)) {
+        this->readPos = startPos;
+        return false;
+    }
+    return true;
+}
+
+uint8_t* ByteStream::reserveBytes(size_t bytesCount) {
+    if (!canWrite(bytesCount)) return nullptr;
+
+    size_t startLen = this->buffer.getSize();
+    this->buffer.setLength(startLen + bytesCount);
+    return this->buffer.getRawBytes() + startLen;
+}
+
+const uint8_t* ByteStream::consumeBytes(size_t bytesCount) {
+    if (!canRead(bytesCount)) return nullptr;
+
+    const uint8_t* ptr = this->buffer.getRawBytes() + this->readPos;
+    this->readPos += bytesCount;
+    return ptr;
+}
+
+bool ByteStream::readSlice(size_t bytesCount, ByteBuffer& view) {
+    if (!this->buffer.slice(this->readPos, bytesCount, view)) return false;
+
+    this->readPos += bytesCount;
+    return true;
+}
+
+Endian ByteStream::getEndianOrder() const {
+    return this->buffer.getEndianOrder();
+}
+
 void ByteStream::resetReadCursor() {
     this->readPos = 0;
 }
 
+size_t ByteStream::getReadCursor() const {
+    return this->readPos;
+}
+
+bool ByteStream::seekReadCursor(size_t pos) {
+    if (pos > this->buffer.getSize()) return false;
+
+    this->readPos = pos;
+    return true;
+}
+
 bool ByteStream::canRead(size_t bytesCount) const {
     return (this->readPos + bytesCount) <=
             this->buffer.getSize();
@@ -413,4 +786,508 @@ bool ByteStream::readBits(uint64_t& out, uint8_t bitSize) {
 }
 
 
+bool ByteStream::writeScalars(const void* src,
+                              size_t elemSize,
+                              size_t count) {
+    if (count == 0) return true;
+    if (!src || elemSize == 0 ||
+        count > SIZE_MAX / elemSize) return false;
+
+    const size_t total = elemSize * count;
+    if (!canWrite(total)) return false;
+
+    const size_t startLen = this->buffer.getSize();
+    const bool swapBytes = this->buffer.getEndianOrder() !=
+                           getSystemEndianness();
+
+    copyScalars(this->buffer.getRawBytes() + startLen,
+                static_cast<const uint8_t*>(src),
+                elemSize, count, swapBytes);
+
+    return this->buffer.setLength(startLen + total);
+}
+
+bool ByteStream::readScalars(void* dest,
+                             size_t elemSize,
+                             size_t count) {
+    if (count == 0) return true;
+    if (!dest || elemSize == 0 ||
+        count > SIZE_MAX / elemSize) return false;
+
+    const size_t total = elemSize * count;
+    if (!canRead(total)) return false;
+
+    const bool swapBytes = this->buffer.getEndianOrder() !=
+                           getSystemEndianness();
+
+    copyScalars(static_cast<uint8_t*>(dest),
+                this->buffer.getRawBytes() + this->readPos,
+                elemSize, count, swapBytes);
+
+    this->readPos += total;
+    return true;
+}
+
+bool ByteStream::writeDescribed(const uint8_t* base,
+                                const MessageDescriptor& descriptor) {
+    const FieldDescriptor* field = descriptor.fields;
+    const FieldDescriptor* end = field + descriptor.fieldCount;
+
+    for (; field < end; field++) {
+        const uint8_t* src = base + field->offset;
+
+        switch (field->type) {
+        case WireType::String:
+            for (size_t i = 0; i < field->count; i++) {
+                const char* str = reinterpret_cast<const char*>(
+                                      src + i * field->capacity);
+                const size_t len = strnlen(str, field->capacity);
+                if (len == field->capacity ||
+                    !writeUint16(static_cast<uint16_t>(len)) ||
+                    !writeChars(str, len)) return false;
+            }
+            break;
+
+        case WireType::Message:
+            for (size_t i = 0; i < field->count; i++) {
+                if (!writeDescribed(src + i * field->message->structSize,
+                                    *field->message)) return false;
+            }
+            break;
+
+        default:
+            if (!writeScalars(src, wireTypeSize(field->type), field->count))
+                return false;
+            break;
+        }
+    }
+    return true;
+}
+
+bool ByteStream::readDescribed(uint8_t* base,
+                               const MessageDescriptor& descriptor) {
+    const FieldDescriptor* field = descriptor.fields;
+    const FieldDescriptor* end = field + descriptor.fieldCount;
+
+    for (; field < end; field++) {
+        uint8_t* dest = base + field->offset;
+
+        switch (field->type) {
+        case WireType::String:
+            for (size_t i = 0; i < field->count; i++) {
+                if (!readString(reinterpret_cast<char*>(
+                                    dest + i * field->capacity),
+                                field->capacity)) return false;
+            }
+            break;
+
+        case WireType::Message:
+            for (size_t i = 0; i < field->count; i++) {
+                if (!readDescribed(dest + i * field->message->structSize,
+                                   *field->message)) return false;
+            }
+            break;
+
+        case WireType::Bool:
+            if (!readScalars(dest, 1, field->count)) return false;
+            // Normalize to the only valid object representations of bool
+            for (size_t i = 0; i < field->count; i++) {
+                dest[i] = (dest[i] != 0) ? 1 : 0;
+            }
+            break;
+
+        default:
+            if (!readScalars(dest, wireTypeSize(field->type), field->count))
+                return false;
+            break;
+        }
+    }
+    return true;
+}
+
+bool ByteStream::writeVarint(uint64_t val) {
+    // Seven bits per byte, least significant group first; the high bit marks
+    // that another byte follows
+    uint8_t bytes[10];
+    size_t len = 0;
+    do {
+        uint8_t group = static_cast<uint8_t>(val & 0x7F);
+        val >>= 7;
+        bytes[len++] = static_cast<uint8_t>(group | (val ? 0x80 : 0));
+    } while (val);
+
+    uint8_t* dst = reserveBytes(len);
+    if (!dst) return false;
+
+    memcpy(dst, bytes, len);
+    return true;
+}
+
+bool ByteStream::readVarint(uint64_t& val) {
+    const size_t startPos = this->readPos;
+    uint64_t result = 0;
+
+    for (size_t i = 0; i < 10; i++) {
+        uint8_t byte;
+        if (!readUint8(byte)) break;
+
+        // The tenth byte only has room for the top bit of a 64-bit value
+        if (i == 9 && byte > 1) break;
+
+        result |= static_cast<uint64_t>(byte & 0x7F) << (i * 7);
+        if (!(byte & 0x80)) {
+            val = result;
+            return true;
+        }
+    }
+
+    this->readPos = startPos;
+    return false;
+}
+
+bool ByteStream::writeSparseScalars(const void* values,
+                                    size_t count,
+                                    size_t elemSize,
+                                    const void* defaultValue) {
+    if (!values && count > 0) return false;
+    if (count > 0xFFFFFFFFULL) return false;
+
+    const size_t startLen = this->buffer.getSize();
+    size_t bitmapPos;
+
+    if (!writeUint32(static_cast<uint32_t>(count)) ||
+        !reserveBitmap(count, bitmapPos)) {
+        this->buffer.setLength(startLen);
+        return false;
+    }
+
+    const uint8_t* src = static_cast<const uint8_t*>(values);
+    const size_t present = buildPresenceBitmap(
+                               src, count, elemSize,
+                               static_cast<const uint8_t*>(defaultValue),
+                               this->buffer.getRawBytes() + bitmapPos);
+
+    if (!canWrite(present * elemSize)) {
+        this->buffer.setLength(startLen);
+        return false;
+    }
+
+    uint8_t* dst = this->buffer.getRawBytes() + this->buffer.getSize();
+    const bool swapBytes = this->buffer.getEndianOrder() !=
+                           getSystemEndianness();
+
+    const size_t words = (count + 63) / 64;
+    for (size_t w = 0; w < words; w++) {
+        uint64_t bits = bitmapWord(bitmapPos, count, w);
+        while (bits) {
+            size_t index = w * 64 + countTrailingZeros64(bits);
+            copyScalars(dst, src + index * elemSize, elemSize, 1, swapBytes);
+            dst += elemSize;
+            bits &= bits - 1;
+        }
+    }
+
+    return this->buffer.setLength(this->buffer.getSize() +
+                                  present * elemSize);
+}
+
+bool ByteStream::readSparseScalars(void* dest,
+                                   size_t destCapacity,
+                                   size_t elemSize,
+                                   const void* defaultValue,
+                                   size_t& outCount) {
+    const size_t startPos = this->readPos;
+    size_t bitmapPos;
+
+    uint32_t count;
+    if (!readUint32(count) || count > destCapacity ||
+        (!dest && count > 0) ||
+        !readBitmap(count, bitmapPos)) {
+        this->readPos = startPos;
+        return false;
+    }
+
+    const size_t words = (static_cast<size_t>(count) + 63) / 64;
+
+    size_t present = 0;
+    for (size_t w = 0; w < words; w++)
+        present += popCount64(bitmapWord(bitmapPos, count, w));
+
+    if (!canRead(present * elemSize)) {
+        this->readPos = startPos;
+        return false;
+    }
+
+    uint8_t* out = static_cast<uint8_t*>(dest);
+    for (size_t i = 0; i < count; i++)
+        memcpy(out + i * elemSize, defaultValue, elemSize);
+
+    const uint8_t* src = this->buffer.getRawBytes() + this->readPos;
+    const bool swapBytes = this->buffer.getEndianOrder() !=
+                           getSystemEndianness();
+
+    for (size_t w = 0; w < words; w++) {
+        uint64_t bits = bitmapWord(bitmapPos, count, w);
+        while (bits) {
+            size_t index = w * 64 + countTrailingZeros64(bits);
+            copyScalars(out + index * elemSize, src, elemSize, 1, swapBytes);
+            src += elemSize;
+            bits &= bits - 1;
+        }
+    }
+
+    this->readPos += present * elemSize;
+    outCount = count;
+    return true;
+}
+
+bool ByteStream::readCount(size_t minElemSize, uint32_t& count) {
+    size_t startPos = this->readPos;
+    if (!readUint32(count)) return false;
+
+    // Every element takes at least minElemSize bytes, so a count that cannot
+    // fit in the remaining bytes is rejected before anything is reserved.
+    // Without a positive size there is no bound, so nothing is accepted
+    const size_t remaining = this->buffer.getSize() - this->readPos;
+    if (minElemSize == 0 || count > remaining / minElemSize) {
+        this->readPos = startPos;
+        return false;
+    }
+    return true;
+}
+
+bool ByteStream::writeElement(bool val) {
+    return writeBool(val);
+}
+
+bool ByteStream::writeElement(const std::string& val) {
+    return writeString(val);
+}
+
+bool ByteStream::readElement(bool& out) {
+    return readBool(out);
+}
+
+bool ByteStream::readElement(std::string& out) {
+    return readString(out);
+}
+
+bool ByteStream::reserveBitmap(size_t count, size_t& bitmapPos) {
+    const size_t bitmapBytes = (count + 7) / 8;
+    if (!canWrite(bitmapBytes)) return false;
+
+    bitmapPos = this->buffer.getSize();
+    memset(this->buffer.getRawBytes() + bitmapPos, 0, bitmapBytes);
+    return this->buffer.setLength(bitmapPos + bitmapBytes);
+}
+
+bool ByteStream::readBitmap(size_t count, size_t& bitmapPos) {
+    const size_t bitmapBytes = (count + 7) / 8;
+    if (!canRead(bitmapBytes)) return false;
+
+    // Reject bits set past the last element
+    if (count % 8 != 0) {
+        uint8_t last;
+        this->buffer.getByte(this->readPos + bitmapBytes - 1, last);
+        if (last >> (count % 8)) return false;
+    }
+
+    bitmapPos = this->readPos;
+    this->readPos += bitmapBytes;
+    return true;
+}
+
+uint64_t ByteStream::bitmapWord(size_t bitmapPos,
+                                size_t count,
+                                size_t wordIndex) const {
+    const size_t bitmapBytes = (count + 7) / 8;
+    const uint8_t* bitmap = this->buffer.getRawBytes() + bitmapPos;
+
+    size_t first = wordIndex * 8;
+    size_t last = first + 8;
+    if (last > bitmapBytes) last = bitmapBytes;
+
+    uint64_t word = 0;
+    for (size_t b = first; b < last; b++)
+        word |= static_cast<uint64_t>(bitmap[b]) << ((b - first) * 8);
+    return word;
+}
+
+bool ByteStream::encodeDetached(const ByteSerializable& obj,
+                                uint8_t* scratch, size_t scratchSize,
+                                std::vector<uint8_t>& spill,
+                                const uint8_t*& encoded,
+                                size_t& encodedLen) const {
+    // Encodings too large for the scratch are retried on the heap, growing
+    // up to the capacity of this stream's buffer
+    const size_t limit = (this->buffer.getCapacity() > scratchSize)
+                         ? this->buffer.getCapacity() : scratchSize;
+    uint8_t* bytes = scratch;
+    size_t size = scratchSize;
+
+    while (true) {
+        ByteBuffer detached(bytes, size, this->buffer.getEndianOrder(),
+                            ZeroPolicy::None);
+        ByteStream stream(detached);
+        if (stream.writeObject(obj)) {
+            encoded = bytes;
+            encodedLen = detached.getSize();
+            return true;
+        }
+
+        if (size >= limit) return false;
+        size = (size > limit / 2) ? limit : size * 2;
+        spill.resize(size);
+        bytes = spill.data();
+    }
+}
+
+template <typename T>
+bool ByteStream::writePackedArray(const T* values,
+                                  size_t count,
+                                  IntArrayCodec codec) {
+    if (!values && count > 0) return false;
+    if (count > 0xFFFFFFFFULL) return false;
+    if (codec != IntArrayCodec::FrameOfReference &&
+        codec != IntArrayCodec::Delta) return false;
+
+    const uint8_t valueBits = sizeof(T) * 8;
+    const size_t blockSize = bitpacking::BLOCK_SIZE;
+    size_t startLen = this->buffer.getSize();
+
+    bool success = writeUint8(static_cast<uint8_t>(codec)) &&
+                   writeUint32(static_cast<uint32_t>(count));
+
+    // Delta blocks chain from the previous value, the first one from values[0]
+    T prev = 0;
+    if (success && codec == IntArrayCodec::Delta && count > 0) {
+        prev = values[0];
+        success = writeBits(prev, valueBits);
+    }
+
+    T offsets[bitpacking::BLOCK_SIZE];
+    T reference;
+    size_t pos = 0;
+
+    // Full blocks: SIMD packed
+    uint32_t words[bitpacking::BLOCK_SIZE * 2];
+    while (success && pos + blockSize <= count) {
+        uint8_t bitWidth = encodeBlock(values + pos, blockSize, codec,
+                                       prev, offsets, reference);
+        packBlock(offsets, bitWidth, words);
+
+        success = writeBits(reference, valueBits) &&
+                  writeUint8(bitWidth) &&
+                  writeScalars(words, sizeof(uint32_t),
+                               bitpacking::blockWords(bitWidth));
+
+        prev = values[pos + blockSize - 1];
+        pos += blockSize;
+    }
+
+    // Tail: plain bit stream
+    if (success && pos < count) {
+        const size_t tailCount = count - pos;
+        uint8_t bitWidth = encodeBlock(values + pos, tailCount, codec,
+                                       prev, offsets, reference);
+
+        uint64_t wide[bitpacking::BLOCK_SIZE];
+        uint8_t bytes[bitpacking::BLOCK_SIZE * sizeof(uint64_t)];
+        for (size_t i = 0; i < tailCount; i++) wide[i] = offsets[i];
+        bitpacking::packTail(wide, tailCount, bitWidth, bytes);
+
+        success = writeBits(reference, valueBits) &&
+                  writeUint8(bitWidth) &&
+                  writeScalars(bytes, 1,
+                               bitpacking::tailBytes(tailCount, bitWidth));
+    }
+
+    if (!success) this->buffer.setLength(startLen);
+    return success;
+}
+
+template <typename T>
+bool ByteStream::readPackedArray(T* dest,
+                                 size_t destCapacity,
+                                 size_t& outCount) {
+    const uint8_t valueBits = sizeof(T) * 8;
+    const size_t blockSize = bitpacking::BLOCK_SIZE;
+    size_t startPos = this->readPos;
+
+    uint8_t codecId;
+    uint32_t count;
+    if (!readUint8(codecId) || !readUint32(count)) {
+        this->readPos = startPos;
+        return false;
+    }
+
+    IntArrayCodec codec = static_cast<IntArrayCodec>(codecId);
+    if ((codec != IntArrayCodec::FrameOfReference &&
+         codec != IntArrayCodec::Delta) ||
+        count > destCapacity ||
+        (!dest && count > 0)) {
+        this->readPos = startPos;
+        return false;
+    }
+
+    bool success = true;
+    uint64_t raw = 0;
+    uint8_t bitWidth = 0;
+
+    T prev = 0;
+    if (codec == IntArrayCodec::Delta && count > 0) {
+        success = readBits(raw, valueBits);
+        prev = static_cast<T>(raw);
+    }
+
+    size_t pos = 0;
+
+    uint32_t words[bitpacking::BLOCK_SIZE * 2];
+    while (success && pos + blockSize <= count) {
+        success = readBits(raw, valueBits) &&
+                  readUint8(bitWidth) &&
+                  bitWidth <= valueBits &&
+                  readScalars(words, sizeof(uint32_t),
+                              bitpacking::blockWords(bitWidth));
+        if (!success) break;
+
+        unpackBlock(words, bitWidth, dest + pos);
+        restoreBlock(dest + pos, blockSize, codec,
+                     static_cast<T>(raw), prev);
+
+        prev = dest[pos + blockSize - 1];
+        pos += blockSize;
+    }
+
+    if (success && pos < count) {
+        const size_t tailCount = count - pos;
+        uint64_t wide[bitpacking::BLOCK_SIZE];
+        uint8_t bytes[bitpacking::BLOCK_SIZE * sizeof(uint64_t)];
+
+        success = readBits(raw, valueBits) &&
+                  readUint8(bitWidth) &&
+                  bitWidth <= valueBits &&
+                  readScalars(bytes, 1,
+                              bitpacking::tailBytes(tailCount, bitWidth));
+
+        if (success) {
+            bitpacking::unpackTail(bytes, tailCount, bitWidth, wide);
+            for (size_t i = 0; i < tailCount; i++)
+                dest[pos + i] = static_cast<T>(wide[i]);
+
+            restoreBlock(dest + pos, tailCount, codec,
+                         static_cast<T>(raw), prev);
+        }
+    }
+
+    if (!success) {
+        this->readPos = startPos;
+        return false;
+    }
+
+    outCount = count;
+    return true;
+}
+
+
 }
\ No newline at end of file
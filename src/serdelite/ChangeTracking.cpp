@@ -0,0 +1,42 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "serdelite/ChangeTracking.h"
+
+namespace serdelite {
+
+DirtyMask::DirtyMask(uint8_t _fieldCount)
+    : PresenceMask(_fieldCount)
+{
+    markAllDirty();
+}
+
+bool DirtyMask::markDirty(uint8_t index) {
+    return set(index);
+}
+
+bool DirtyMask::isDirty(uint8_t index) const {
+    return has(index);
+}
+
+void DirtyMask::markAllDirty() {
+    setBits((getFieldCount() >= MAX_FIELDS)
+            ? ~0ULL
+            : (1ULL << getFieldCount()) - 1);
+}
+
+void DirtyMask::clean() {
+    clear();
+}
+
+bool DirtyMask::isClean() const {
+    return getBits() == 0;
+}
+
+}
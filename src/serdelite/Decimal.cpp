@@ -0,0 +1,178 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "serdelite/Decimal.h"
+
+#if defined(SERDELITE_HAS_INT128)
+
+#include "Digits.h"
+
+#include <string.h>
+
+namespace serdelite {
+
+static inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Multiplies by 10 and adds a digit, failing instead of wrapping around
+static inline bool appendDigit(uint128_t& val, char c) {
+    const uint128_t MAX_VALUE = ~static_cast<uint128_t>(0);
+    const unsigned digit = static_cast<unsigned>(c - '0');
+
+    if (val > (MAX_VALUE - digit) / 10) return false;
+    val = val * 10 + digit;
+    return true;
+}
+
+Decimal::Decimal()
+    : units(0),
+      scale(0)
+{}
+
+Decimal::Decimal(int128_t _units, uint8_t _scale)
+    : units(_units),
+      scale(_scale > MAX_SCALE ? MAX_SCALE : _scale)
+{}
+
+bool Decimal::parse(const char* str, size_t len, uint8_t scale, Decimal& out) {
+    if (!str || scale > MAX_SCALE) return false;
+
+    const char* p = str;
+    const char* end = str + len;
+
+    const bool isNegative = (p < end && *p == '-');
+    if (isNegative) p++;
+
+    uint128_t mantissa = 0;
+    long shift = scale;     // power of ten applied to the mantissa
+    bool isTruncated = false;
+
+    // Integer part (JSON forbids leading zeros)
+    const char* intStart = p;
+    for (; p < end && isDigit(*p); p++) {
+        if (isTruncated || !appendDigit(mantissa, *p)) {
+            // Beyond 128 bits only trailing zeros can still be exact
+            if (*p != '0') return false;
+            isTruncated = true;
+            shift++;
+        }
+    }
+    if (p == intStart || (p - intStart > 1 && *intStart == '0')) return false;
+
+    // Fraction
+    if (p < end && *p == '.') {
+        const char* fracStart = ++p;
+        for (; p < end && isDigit(*p); p++) {
+            if (isTruncated || !appendDigit(mantissa, *p)) {
+                if (*p != '0') return false;
+                isTruncated = true;
+                continue;
+            }
+            shift--;
+        }
+        if (p == fracStart) return false;
+    }
+
+    // Exponent
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool isNegativeExp = false;
+        if (p < end && (*p == '+' || *p == '-')) isNegativeExp = (*p++ == '-');
+
+        const char* expStart = p;
+        long exponent = 0;
+        for (; p < end && isDigit(*p); p++) {
+            if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+        }
+        if (p == expStart) return false;
+        shift += isNegativeExp ? -exponent : exponent;
+    }
+
+    if (p != end) return false;
+
+    // Bring the mantissa to the requested scale without losing digits
+    if (mantissa != 0) {
+        for (; shift > 0; shift--) {
+            if (!appendDigit(mantissa, '0')) return false;
+        }
+        for (; shift < 0; shift++) {
+            if (mantissa % 10 != 0) return false;
+            mantissa /= 10;
+        }
+    }
+
+    const uint128_t limit = (static_cast<uint128_t>(1) << 127) -
+                            (isNegative ? 0 : 1);
+    if (mantissa > limit) return false;
+
+    const uint128_t bits = isNegative ? (0 - mantissa) : mantissa;
+    out = Decimal(static_cast<int128_t>(bits), scale);
+    return true;
+}
+
+size_t Decimal::format(char* dest) const {
+    char digitBuf[digits::MAX_UINT128_DIGITS];
+
+    const bool isNegative = this->units < 0;
+    const uint128_t magnitude = isNegative
+                                ? 0 - static_cast<uint128_t>(this->units)
+                                : static_cast<uint128_t>(this->units);
+
+    const size_t count = digits::formatUint128(magnitude, digitBuf);
+    const size_t fracDigits = this->scale;
+
+    char* p = dest;
+    if (isNegative) *p++ = '-';
+
+    if (fracDigits == 0) {
+        memcpy(p, digitBuf, count);
+        p += count;
+    } else if (count <= fracDigits) {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', fracDigits - count);
+        p += fracDigits - count;
+        memcpy(p, digitBuf, count);
+        p += count;
+    } else {
+        const size_t intDigits = count - fracDigits;
+        memcpy(p, digitBuf, intDigits);
+        p += intDigits;
+        *p++ = '.';
+        memcpy(p, digitBuf + intDigits, fracDigits);
+        p += fracDigits;
+    }
+
+    return static_cast<size_t>(p - dest);
+}
+
+bool Decimal::toString(char* dest, size_t destCapacity) const {
+    if (!dest) return false;
+
+    char temp[MAX_STRING_LENGTH];
+    const size_t len = format(temp);
+    if (destCapacity < len + 1) return false;
+
+    memcpy(dest, temp, len);
+    dest[len] = '\0';
+    return true;
+}
+
+int128_t Decimal::getUnits() const {
+    return this->units;
+}
+
+uint8_t Decimal::getScale() const {
+    return this->scale;
+}
+
+} // namespace serdelite
+
+#endif // SERDELITE_HAS_INT128
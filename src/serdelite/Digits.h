@@ -0,0 +1,138 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file Digits.h
+ * @brief Internal table-driven decimal formatting of unsigned integers.
+ *
+ * Digits are produced two at a time from a 200-byte table of pairs, which
+ * halves the number of divisions compared to a digit-by-digit loop and avoids
+ * the format-string parsing of `snprintf`.
+ *
+ * @note This header is private to the library sources and is not installed.
+ */
+
+#ifndef SERDELITE_DIGITS_H
+#define SERDELITE_DIGITS_H
+
+#include "serdelite/Common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace serdelite {
+namespace digits {
+
+/** @brief "00" to "99", two characters per entry. */
+static const char PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/** @brief Maximum number of digits of a 64-bit value. */
+static const size_t MAX_UINT64_DIGITS = 20;
+
+/**
+ * @brief Writes the decimal digits of `val` without leading zeros.
+ * @param val The value to format.
+ * @param[out] dest Destination of at least `MAX_UINT64_DIGITS` bytes.
+ * @return The number of characters written (no terminator).
+ */
+static inline size_t formatUint64(uint64_t val, char* dest) {
+    char temp[MAX_UINT64_DIGITS];
+    char* p = temp + MAX_UINT64_DIGITS;
+
+    while (val >= 100) {
+        const size_t pair = static_cast<size_t>(val % 100) * 2;
+        val /= 100;
+        p -= 2;
+        memcpy(p, PAIRS + pair, 2);
+    }
+    if (val >= 10) {
+        p -= 2;
+        memcpy(p, PAIRS + val * 2, 2);
+    } else {
+        *--p = static_cast<char>('0' + val);
+    }
+
+    const size_t len = static_cast<size_t>(temp + MAX_UINT64_DIGITS - p);
+    memcpy(dest, p, len);
+    return len;
+}
+
+/**
+ * @brief Writes exactly `width` digits of `val`, padding with leading zeros.
+ * @param val The value to format; must have at most `width` digits.
+ * @param[out] dest Destination of `width` bytes.
+ * @param width Number of digits to write.
+ */
+static inline void formatUint64Padded(uint64_t val, char* dest, size_t width) {
+    char* p = dest + width;
+
+    while (p - dest >= 2) {
+        const size_t pair = static_cast<size_t>(val % 100) * 2;
+        val /= 100;
+        p -= 2;
+        memcpy(p, PAIRS + pair, 2);
+    }
+    if (p > dest) *--p = static_cast<char>('0' + val % 10);
+}
+
+#if defined(SERDELITE_HAS_INT128)
+
+/** @brief Maximum number of digits of a 128-bit value. */
+static const size_t MAX_UINT128_DIGITS = 39;
+
+/**
+ * @brief Writes the decimal digits of a 128-bit value without leading zeros.
+ *
+ * The value is split into 19-digit chunks so that all but at most two
+ * divisions run on 64-bit words.
+ *
+ * @param val The value to format.
+ * @param[out] dest Destination of at least `MAX_UINT128_DIGITS` bytes.
+ * @return The number of characters written (no terminator).
+ */
+static inline size_t formatUint128(uint128_t val, char* dest) {
+    if (static_cast<uint64_t>(val >> 64) == 0)
+        return formatUint64(static_cast<uint64_t>(val), dest);
+
+    const uint64_t CHUNK = 10000000000000000000ULL; // 10^19
+
+    const uint64_t low = static_cast<uint64_t>(val % CHUNK);
+    val /= CHUNK;
+
+    size_t len;
+    if (static_cast<uint64_t>(val >> 64) == 0) {
+        len = formatUint64(static_cast<uint64_t>(val), dest);
+    } else {
+        const uint64_t mid = static_cast<uint64_t>(val % CHUNK);
+        len = formatUint64(static_cast<uint64_t>(val / CHUNK), dest);
+        formatUint64Padded(mid, dest + len, 19);
+        len += 19;
+    }
+
+    formatUint64Padded(low, dest + len, 19);
+    return len + 19;
+}
+
+#endif
+
+} // namespace digits
+} // namespace serdelite
+
+#endif
@@ -0,0 +1,283 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "Hex.h"
+#include "Simd.h"
+
+#include <string.h>
+
+namespace serdelite {
+namespace hex {
+
+static const char UPPER_DIGITS[] = "0123456789ABCDEF";
+static const char LOWER_DIGITS[] = "0123456789abcdef";
+
+// "XX " for every byte value, indexed by byte * 3
+#define SERDELITE_HEX_ROW(h) \
+    h "0 " h "1 " h "2 " h "3 " h "4 " h "5 " h "6 " h "7 " \
+    h "8 " h "9 " h "A " h "B " h "C " h "D " h "E " h "F "
+
+static const char BYTE_GROUPS[] =
+    SERDELITE_HEX_ROW("0") SERDELITE_HEX_ROW("1") SERDELITE_HEX_ROW("2")
+    SERDELITE_HEX_ROW("3") SERDELITE_HEX_ROW("4") SERDELITE_HEX_ROW("5")
+    SERDELITE_HEX_ROW("6") SERDELITE_HEX_ROW("7") SERDELITE_HEX_ROW("8")
+    SERDELITE_HEX_ROW("9") SERDELITE_HEX_ROW("A") SERDELITE_HEX_ROW("B")
+    SERDELITE_HEX_ROW("C") SERDELITE_HEX_ROW("D") SERDELITE_HEX_ROW("E")
+    SERDELITE_HEX_ROW("F");
+
+#undef SERDELITE_HEX_ROW
+
+#if defined(SERDELITE_SSSE3)
+// Spreads the 16 high and low digits of a row into 48 "XX " characters:
+// output byte 3k takes high digit k, byte 3k+1 low digit k (-1 selects zero)
+static const int8_t GROUP_HIGH[3][16] = {
+    { 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5 },
+    { -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1 },
+    { -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1 }
+};
+
+static const int8_t GROUP_LOW[3][16] = {
+    { -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1 },
+    { 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10 },
+    { -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1 }
+};
+#endif
+
+void encode(const uint8_t* src, size_t count, char* dest, bool upperCase) {
+    const char* table = upperCase ? UPPER_DIGITS : LOWER_DIGITS;
+    size_t i = 0;
+
+#if defined(SERDELITE_AVX2)
+    const __m256i lut32 = _mm256_broadcastsi128_si256(
+                              _mm_loadu_si128(
+                                  reinterpret_cast<const __m128i*>(table)));
+    const __m256i mask32 = _mm256_set1_epi8(0x0F);
+
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(src + i));
+        __m256i hi = _mm256_shuffle_epi8(
+                         lut32, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask32));
+        __m256i lo = _mm256_shuffle_epi8(lut32, _mm256_and_si256(v, mask32));
+
+        // Unpacking works per 128-bit lane: reorder the lanes on the way out
+        __m256i first = _mm256_unpacklo_epi8(hi, lo);
+        __m256i second = _mm256_unpackhi_epi8(hi, lo);
+
+        __m256i* out = reinterpret_cast<__m256i*>(dest + i*2);
+        _mm256_storeu_si256(out, _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(first, second, 0x31));
+    }
+#endif
+
+#if defined(SERDELITE_SSSE3)
+    const __m128i lut = _mm_loadu_si128(
+                            reinterpret_cast<const __m128i*>(table));
+    const __m128i mask = _mm_set1_epi8(0x0F);
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(src + i));
+        __m128i hi = _mm_shuffle_epi8(
+                         lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+
+        __m128i* out = reinterpret_cast<__m128i*>(dest + i*2);
+        _mm_storeu_si128(out, _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dest[i*2] = table[src[i] >> 4];
+        dest[i*2 + 1] = table[src[i] & 0x0F];
+    }
+}
+
+#if defined(SERDELITE_SSE2)
+// Values of 16 hex characters; `valid` gets a bit per character that is a digit
+static inline __m128i digitValues(__m128i v, int& valid) {
+    const __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    const __m128i alpha = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)),
+                                       _mm_set1_epi8('a'));
+
+    // Unsigned range checks: x <= n exactly when min(x, n) == x
+    const __m128i isDigit = _mm_cmpeq_epi8(
+                                _mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i isAlpha = _mm_cmpeq_epi8(
+                                _mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+    valid = _mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha));
+    return _mm_or_si128(
+               _mm_and_si128(isDigit, digit),
+               _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+// Joins the high (even) and low (odd) nibbles into 16-bit lanes holding one byte
+static inline __m128i joinNibbles(__m128i values) {
+    return _mm_or_si128(
+               _mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), 4),
+               _mm_srli_epi16(values, 8));
+}
+#endif
+
+#if defined(SERDELITE_AVX2)
+static inline __m256i digitValues(__m256i v, uint32_t& valid) {
+    const __m256i digit = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    const __m256i alpha = _mm256_sub_epi8(
+                              _mm256_or_si256(v, _mm256_set1_epi8(0x20)),
+                              _mm256_set1_epi8('a'));
+
+    const __m256i isDigit = _mm256_cmpeq_epi8(
+                                _mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i isAlpha = _mm256_cmpeq_epi8(
+                                _mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+    valid = static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_or_si256(isDigit, isAlpha)));
+    return _mm256_or_si256(
+               _mm256_and_si256(isDigit, digit),
+               _mm256_and_si256(isAlpha,
+                                _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+static inline __m256i joinNibbles(__m256i values) {
+    return _mm256_or_si256(
+               _mm256_slli_epi16(
+                   _mm256_and_si256(values, _mm256_set1_epi16(0x00FF)), 4),
+               _mm256_srli_epi16(values, 8));
+}
+#endif
+
+size_t decode(const char* src, size_t count, uint8_t* dest) {
+    size_t i = 0;
+
+#if defined(SERDELITE_AVX2)
+    for (; i + 32 <= count; i += 32) {
+        uint32_t validLow, validHigh;
+        __m256i low = digitValues(_mm256_loadu_si256(
+                          reinterpret_cast<const __m256i*>(src + i*2)), validLow);
+        __m256i high = digitValues(_mm256_loadu_si256(
+                           reinterpret_cast<const __m256i*>(src + i*2 + 32)), validHigh);
+        if ((validLow & validHigh) != 0xFFFFFFFFu) break;
+
+        // Packing works per 128-bit lane: restore the order of the quarters
+        __m256i packed = _mm256_packus_epi16(joinNibbles(low), joinNibbles(high));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+#endif
+
+#if defined(SERDELITE_SSE2)
+    // 32 characters per step; a block with any non-digit goes to the tail
+    for (; i + 16 <= count; i += 16) {
+        int validLow, validHigh;
+        __m128i low = digitValues(_mm_loadu_si128(
+                          reinterpret_cast<const __m128i*>(src + i*2)), validLow);
+        __m128i high = digitValues(_mm_loadu_si128(
+                           reinterpret_cast<const __m128i*>(src + i*2 + 16)), validHigh);
+        if ((validLow & validHigh) != 0xFFFF) break;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                         _mm_packus_epi16(joinNibbles(low), joinNibbles(high)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        const uint8_t high = digitValue(src[i*2]);
+        const uint8_t low = digitValue(src[i*2 + 1]);
+        if ((high | low) > 15) break;
+
+        dest[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return i;
+}
+
+static inline char printableChar(uint8_t byte) {
+    return (byte >= 32 && byte <= 126) ? static_cast<char>(byte) : '.';
+}
+
+size_t dumpLine(const uint8_t* src, size_t count, uint64_t offset,
+                size_t offsetDigits, char* dest) {
+    char* out = dest;
+
+    // Offset column: big-endian bytes of the offset, hex encoded
+    uint8_t offsetBytes[8];
+    for (size_t i = 0; i < 8; i++) {
+        offsetBytes[i] = static_cast<uint8_t>(offset >> (56 - i*8));
+    }
+    encode(offsetBytes + 8 - offsetDigits/2, offsetDigits/2, out, true);
+    out += offsetDigits;
+    *out++ = ':';
+    *out++ = ' ';
+
+    size_t i = 0;
+
+#if defined(SERDELITE_SSSE3)
+    if (count == DUMP_WIDTH) {
+        const __m128i lut = _mm_loadu_si128(
+                                reinterpret_cast<const __m128i*>(UPPER_DIGITS));
+        const __m128i mask = _mm_set1_epi8(0x0F);
+        const __m128i space = _mm_set1_epi8(' ');
+
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        __m128i hi = _mm_shuffle_epi8(
+                         lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+
+        // Digits are above ' ', so max() fills the zeroed gaps with spaces
+        for (int j = 0; j < 3; j++) {
+            __m128i group = _mm_or_si128(
+                _mm_shuffle_epi8(hi, _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(GROUP_HIGH[j]))),
+                _mm_shuffle_epi8(lo, _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(GROUP_LOW[j]))));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j*16),
+                             _mm_max_epu8(group, space));
+        }
+        out += DUMP_WIDTH * 3;
+
+        memcpy(out, " | ", 3);
+        out += 3;
+
+        // Printable means 0x20-0x7E, i.e. above 0x1F and below 0x7F signed
+        __m128i printable = _mm_and_si128(
+                                _mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)),
+                                _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F)));
+        __m128i text = _mm_or_si128(
+                           _mm_and_si128(printable, v),
+                           _mm_andnot_si128(printable, _mm_set1_epi8('.')));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), text);
+        out += DUMP_WIDTH;
+
+        *out++ = '\n';
+        return static_cast<size_t>(out - dest);
+    }
+#endif
+
+    for (; i < count; i++) {
+        memcpy(out, BYTE_GROUPS + src[i]*3, 3);
+        out += 3;
+    }
+    for (; i < DUMP_WIDTH; i++) {
+        memcpy(out, "   ", 3);
+        out += 3;
+    }
+
+    memcpy(out, " | ", 3);
+    out += 3;
+
+    for (i = 0; i < count; i++) *out++ = printableChar(src[i]);
+
+    *out++ = '\n';
+    return static_cast<size_t>(out - dest);
+}
+
+} // namespace hex
+} // namespace serdelite
@@ -0,0 +1,100 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file Hex.h
+ * @brief Internal hexadecimal encoding kernels.
+ *
+ * With SSSE3 each 16-byte block (32 with AVX2) is split into nibbles and
+ * translated with a single `pshufb` table lookup per nibble vector; other
+ * targets use a scalar lookup table. Decoding classifies and converts 16 (SSE2)
+ * or 32 (AVX2) characters per step with range compares. All paths produce
+ * identical output. Hex dump lines are formatted a whole 16-byte row at a
+ * time the same way.
+ *
+ * @note This header is private to the library sources and is not installed.
+ */
+
+#ifndef SERDELITE_HEX_H
+#define SERDELITE_HEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace serdelite {
+namespace hex {
+
+/**
+ * @brief Writes two hexadecimal characters per input byte.
+ * @param src The bytes to encode.
+ * @param count Number of bytes.
+ * @param[out] dest Destination of `count * 2` characters (no terminator).
+ * @param upperCase `true` for `A-F`, `false` for `a-f`.
+ */
+void encode(const uint8_t* src, size_t count, char* dest, bool upperCase);
+
+/**
+ * @brief Converts one hexadecimal character into its value.
+ * @return Returns the nibble (0-15), or `255` for any other character.
+ */
+static inline uint8_t digitValue(char c) {
+    if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0');
+    if (c >= 'a' && c <= 'f') return static_cast<uint8_t>(c - 'a' + 10);
+    if (c >= 'A' && c <= 'F') return static_cast<uint8_t>(c - 'A' + 10);
+    return 255;
+}
+
+/**
+ * @brief Decodes pairs of hexadecimal characters (either case) into bytes.
+ * @param src The characters to decode.
+ * @param count Maximum number of bytes to produce (`src` holds at least
+ * 				`count * 2` characters).
+ * @param[out] dest Destination of up to `count` bytes.
+ * @return Returns the number of bytes decoded; decoding stops before the
+ * 		   first pair holding a character that is not a hex digit.
+ */
+size_t decode(const char* src, size_t count, uint8_t* dest);
+
+/** @brief Number of bytes shown on each line of a hex dump. */
+static const size_t DUMP_WIDTH = 16;
+
+/** @brief Longest dump line: 16 offset digits, 16 bytes and the newline. */
+static const size_t MAX_DUMP_LINE = 16 + 2 + DUMP_WIDTH * 3 + 3 + DUMP_WIDTH + 1;
+
+/**
+ * @brief Gives the length of one dump line.
+ * @param count Number of bytes on the line (1 to @ref DUMP_WIDTH).
+ * @param offsetDigits Width of the offset column (8 or 16).
+ */
+static inline size_t dumpLineLength(size_t count, size_t offsetDigits) {
+    return offsetDigits + 2 + DUMP_WIDTH * 3 + 3 + count + 1;
+}
+
+/**
+ * @brief Formats one hex dump line, e.g.
+ * 		  `00000010: 48 65 6C 6C 6F 00 ...  | Hello.`.
+ *
+ * The hex column is always padded to @ref DUMP_WIDTH bytes so that the
+ * character column lines up; the character column is not padded. Bytes
+ * outside 0x20-0x7E are shown as `.`.
+ *
+ * @param src The bytes of the line.
+ * @param count Number of bytes (1 to @ref DUMP_WIDTH).
+ * @param offset Offset of `src[0]`, printed in the first column.
+ * @param offsetDigits Width of the offset column (8 or 16).
+ * @param[out] dest Destination of at least @ref MAX_DUMP_LINE characters.
+ * @return Returns the number of characters written, newline included.
+ */
+size_t dumpLine(const uint8_t* src, size_t count, uint64_t offset,
+                size_t offsetDigits, char* dest);
+
+} // namespace hex
+} // namespace serdelite
+
+#endif
@@ -8,17 +8,40 @@
  */
 
 #include "serdelite/JsonBuffer.h"
+#include "JsonScanner.h"
+#include "JsonValidator.h"
 
 #include <cstdio>
 
 namespace serdelite {
 
+JsonBuffer::JsonBuffer()
+    : data(nullptr), length(0)
+{
+
+}
+
 JsonBuffer::JsonBuffer(const char* _data, size_t len)
     : data(_data), length(len)
 {
 
 }
 
+bool JsonBuffer::isValid() const {
+    return json::isValidValue(this->data, this->length);
+}
+
+bool JsonBuffer::find(const char* pointer, JsonBuffer& value) const {
+    return json::findPointers(this->data, this->length,
+                              &pointer, 1, &value) == 1;
+}
+
+size_t JsonBuffer::find(const char* const* pointers, size_t count,
+                        JsonBuffer* values) const {
+    return json::findPointers(this->data, this->length,
+                              pointers, count, values);
+}
+
 void JsonBuffer::printPretty(int tabWidth) const  {
     if (!this->data || this->length == 0) return;
 
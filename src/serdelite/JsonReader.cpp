@@ -0,0 +1,595 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "serdelite/JsonReader.h"
+#include "JsonScanner.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+namespace serdelite {
+
+static const size_t MAX_KEY_LENGTH = 128;
+static const size_t MAX_NUMBER_LENGTH = 128;
+
+// Chunks handed out per thread, so that uneven elements still balance
+static const size_t CHUNKS_PER_THREAD = 8;
+
+static inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Scans a JSON number, returning the character after it or nullptr
+static const char* scanNumber(const char* p, const char* end, bool& isInteger) {
+    isInteger = true;
+    if (p < end && *p == '-') p++;
+
+    if (p == end || !isDigit(*p)) return nullptr;
+    if (*p == '0') p++;
+    else while (p < end && isDigit(*p)) p++;
+
+    if (p < end && *p == '.') {
+        isInteger = false;
+        if (++p == end || !isDigit(*p)) return nullptr;
+        while (p < end && isDigit(*p)) p++;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        isInteger = false;
+        if (++p < end && (*p == '+' || *p == '-')) p++;
+        if (p == end || !isDigit(*p)) return nullptr;
+        while (p < end && isDigit(*p)) p++;
+    }
+    return p;
+}
+
+JsonReader::JsonReader(const JsonBuffer& json)
+    : p(json.data),
+      end(json.data ? json.data + json.length : json.data),
+      error(!json.data),
+      isFirstMember(true),
+      isObjectEnd(false),
+      isValuePending(false),
+      isMutable(false)
+{
+
+}
+
+JsonReader::JsonReader(const char* text, size_t len)
+    : p(text),
+      end(text ? text + len : text),
+      error(!text),
+      isFirstMember(true),
+      isObjectEnd(false),
+      isValuePending(false),
+      isMutable(false)
+{
+
+}
+
+JsonReader::JsonReader(char* text, size_t len)
+    : p(text),
+      end(text ? text + len : text),
+      error(!text),
+      isFirstMember(true),
+      isObjectEnd(false),
+      isValuePending(false),
+      isMutable(true)
+{
+
+}
+
+bool JsonReader::unescape(const char* src, size_t len,
+                          char* dest, size_t& outLen) {
+    if (!src || !dest) return false;
+    return json::unescape(src, len, dest, outLen);
+}
+
+bool JsonReader::hasError() const {
+    return this->error;
+}
+
+bool JsonReader::isComplete() const {
+    return !this->error && json::skipWhitespace(this->p, this->end) == this->end;
+}
+
+bool JsonReader::readObject(JsonSerializable& obj) {
+    if (this->error) return false;
+
+    // Save parent state
+    bool parentFirst = this->isFirstMember;
+    bool parentEnd = this->isObjectEnd;
+
+    bool success = obj.fromJson(*this);
+
+    // Restore parent state
+    this->isFirstMember = parentFirst;
+    this->isObjectEnd = parentEnd;
+    this->isValuePending = false;
+
+    return success || fail();
+}
+
+bool JsonReader::beginObject() {
+    if (!beginValue() || *this->p != '{') return fail();
+
+    this->p++;
+    this->isFirstMember = true;
+    this->isObjectEnd = false;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::nextField(const JsonKey* keys, size_t keyCount, size_t& index) {
+    for (;;) {
+        if (this->error || this->isObjectEnd) return false;
+        if (this->isValuePending && !skipValue()) return false;
+
+        this->p = json::skipWhitespace(this->p, this->end);
+        if (this->p == this->end) return fail();
+
+        if (*this->p == '}') {
+            this->p++;
+            this->isObjectEnd = true;
+            return false;
+        }
+
+        if (!this->isFirstMember) {
+            if (*this->p != ',') return fail();
+            this->p = json::skipWhitespace(this->p + 1, this->end);
+        }
+        this->isFirstMember = false;
+
+        if (this->p == this->end || *this->p != '"') return fail();
+
+        bool hasEscapes = false;
+        const char* key = this->p + 1;
+        const char* keyEnd = json::skipString(key, this->end, hasEscapes);
+        if (!keyEnd) return fail();
+        keyEnd--;
+
+        this->p = json::skipWhitespace(keyEnd + 1, this->end);
+        if (this->p == this->end || *this->p != ':') return fail();
+        this->p++;
+
+        this->isValuePending = true;
+        if (matchKey(key, keyEnd, hasEscapes, keys, keyCount, index))
+            return true;
+    }
+}
+
+bool JsonReader::endObject() {
+    size_t index;
+    while (nextField(nullptr, 0, index)) {}
+    return !this->error;
+}
+
+bool JsonReader::beginArray() {
+    if (!beginValue() || *this->p != '[') return fail();
+
+    this->p++;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::nextElement(bool& isFirst) {
+    if (this->error) return false;
+
+    this->p = json::skipWhitespace(this->p, this->end);
+    if (this->p == this->end) return fail();
+
+    if (*this->p == ']') {
+        this->p++;
+        return false;
+    }
+
+    if (!isFirst) {
+        if (*this->p != ',') return fail();
+        this->p++;
+    }
+    isFirst = false;
+    return true;
+}
+
+bool JsonReader::readUint8(uint8_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readUint16(uint16_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readUint32(uint32_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readUint64(uint64_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readInt8(int8_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readInt16(int16_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readInt32(int32_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readInt64(int64_t& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readFloat(float& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readDouble(double& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readBool(bool& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readString(char* dest, size_t destCapacity) {
+    if (!dest || !beginValue() || *this->p != '"') return fail();
+
+    bool hasEscapes = false;
+    const char* start = this->p + 1;
+    const char* stop = json::skipString(start, this->end, hasEscapes);
+    if (!stop) return fail();
+    stop--;
+
+    // Decoding never lengthens the text, so the raw length is a safe bound
+    const size_t rawLen = static_cast<size_t>(stop - start);
+    size_t len = rawLen;
+
+    if (!hasEscapes) {
+        if (rawLen >= destCapacity) return fail();
+        memcpy(dest, start, rawLen);
+    } else if (rawLen < destCapacity) {
+        if (!json::unescape(start, rawLen, dest, len)) return fail();
+    } else {
+        std::string temp;
+        if (!readValue(temp)) return false;
+        if (temp.size() >= destCapacity) return fail();
+        memcpy(dest, temp.data(), temp.size());
+        dest[temp.size()] = '\0';
+        return true;
+    }
+
+    dest[len] = '\0';
+    this->p = stop + 1;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::readString(std::string& out) {
+    return readValue(out);
+}
+
+bool JsonReader::readStringView(JsonBuffer& out) {
+    if (!beginValue() || *this->p != '"') return fail();
+
+    bool hasEscapes = false;
+    const char* start = this->p + 1;
+    const char* stop = json::skipString(start, this->end, hasEscapes);
+    if (!stop) return fail();
+    stop--;
+
+    size_t len = static_cast<size_t>(stop - start);
+    if (hasEscapes) {
+        // The document was handed over as writable, see the constructor
+        if (!this->isMutable) return fail();
+
+        char* text = const_cast<char*>(start);
+        if (!json::unescape(start, len, text, len)) return fail();
+    }
+
+    out = JsonBuffer(start, len);
+    this->p = stop + 1;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::readNull() {
+    if (this->error) return false;
+
+    const char* q = json::skipWhitespace(this->p, this->end);
+    if (this->end - q < 4 || memcmp(q, "null", 4) != 0) return false;
+
+    this->p = q + 4;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::readRawJson(JsonBuffer& out) {
+    if (!beginValue()) return false;
+
+    const char* stop = json::skipValue(this->p, this->end);
+    if (!stop) return fail();
+
+    out = JsonBuffer(this->p, static_cast<size_t>(stop - this->p));
+    this->p = stop;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::skipValue() {
+    JsonBuffer ignored;
+    return readRawJson(ignored);
+}
+
+bool JsonReader::splitArray(const JsonBuffer& json,
+                            std::vector<JsonBuffer>& elements) {
+    elements.clear();
+    if (!json.data) return false;
+
+    const char* end = json.data + json.length;
+    const char* p = json::skipWhitespace(json.data, end);
+    if (p == end || *p != '[') return false;
+
+    p = json::skipWhitespace(p + 1, end);
+    if (p < end && *p == ']') {
+        return json::skipWhitespace(p + 1, end) == end;
+    }
+
+    while (p < end) {
+        const char* stop = json::skipValue(p, end);
+        if (!stop) break;
+        elements.push_back(JsonBuffer(p, static_cast<size_t>(stop - p)));
+
+        p = json::skipWhitespace(stop, end);
+        if (p == end) break;
+        if (*p == ']') {
+            if (json::skipWhitespace(p + 1, end) == end) return true;
+            break;
+        }
+        if (*p != ',') break;
+        p = json::skipWhitespace(p + 1, end);
+    }
+
+    // The elements found before the error are not handed out
+    elements.clear();
+    return false;
+}
+
+bool JsonReader::forEachElement(const JsonBuffer& json,
+                                const ElementHandler& handler,
+                                size_t threadCount) {
+    std::vector<JsonBuffer> elements;
+    if (!handler || !splitArray(json, elements)) return false;
+
+    return runChunks(elements.size(), threadCount,
+        [&elements, &handler](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                JsonReader reader(elements[i]);
+                if (!handler(reader, i) || !reader.isComplete()) return false;
+            }
+            return true;
+        });
+}
+
+bool JsonReader::runChunks(size_t count, size_t threadCount,
+                           const std::function<bool(size_t, size_t)>& work) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    if (threadCount > count) threadCount = count;
+
+    if (threadCount <= 1) return work(0, count);
+
+    const size_t chunkCount = threadCount * CHUNKS_PER_THREAD;
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    std::atomic<size_t> nextChunk(0);
+    std::atomic<bool> failed(false);
+    std::atomic<bool> hasThrown(false);
+    std::exception_ptr thrown;
+
+    // An exception must not leave a thread: the first one is kept, the other
+    // workers stop, and it is rethrown on the calling thread once all joined
+    auto worker = [&]() {
+        try {
+            while (!failed.load(std::memory_order_relaxed)) {
+                const size_t first = nextChunk.fetch_add(1) * chunkSize;
+                if (first >= count) return;
+
+                const size_t last = (count - first < chunkSize)
+                                    ? count : first + chunkSize;
+                if (!work(first, last)) failed.store(true);
+            }
+        } catch (...) {
+            if (!hasThrown.exchange(true)) thrown = std::current_exception();
+            failed.store(true);
+        }
+    };
+
+    // The calling thread works too. If the system runs out of threads, the
+    // ones already started share the remaining chunks
+    std::vector<std::thread> threads;
+    try {
+        threads.reserve(threadCount - 1);
+        for (size_t i = 1; i < threadCount; i++) threads.emplace_back(worker);
+    } catch (const std::exception&) {
+    }
+
+    worker();
+    for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+
+    if (thrown) std::rethrow_exception(thrown);
+    return !failed.load();
+}
+
+bool JsonReader::fail() {
+    this->error = true;
+    return false;
+}
+
+bool JsonReader::beginValue() {
+    if (this->error) return false;
+
+    this->p = json::skipWhitespace(this->p, this->end);
+    return this->p < this->end || fail();
+}
+
+bool JsonReader::readIntBits(uint64_t& out, uint8_t bitSize, bool isSigned) {
+    if (!beginValue()) return false;
+
+    const char* q = this->p;
+    const bool isNegative = (*q == '-');
+    if (isNegative) {
+        if (!isSigned) return fail();
+        q++;
+    }
+
+    if (q == this->end || !isDigit(*q)) return fail();
+    if (*q == '0' && q + 1 < this->end && isDigit(q[1])) return fail();
+
+    uint64_t magnitude = 0;
+    for (; q < this->end && isDigit(*q); q++) {
+        const uint64_t digit = static_cast<uint64_t>(*q - '0');
+        if (magnitude > (~0ULL - digit) / 10) return fail();
+        magnitude = magnitude * 10 + digit;
+    }
+    if (q < this->end && (*q == '.' || *q == 'e' || *q == 'E')) return fail();
+
+    uint64_t limit;
+    if (isSigned) {
+        limit = (1ULL << (bitSize - 1)) - (isNegative ? 0 : 1);
+    } else {
+        limit = (bitSize == 64) ? ~0ULL : (1ULL << bitSize) - 1;
+    }
+    if (magnitude > limit) return fail();
+
+    out = isNegative ? (0 - magnitude) : magnitude;
+    this->p = q;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::readReal(double& out) {
+    if (!beginValue()) return false;
+
+    if (readNull()) {
+        out = NAN;
+        return true;
+    }
+
+    bool isInteger;
+    const char* stop = scanNumber(this->p, this->end, isInteger);
+    if (!stop) return fail();
+
+    // strtod needs a terminated copy; the text need not be terminated
+    const size_t len = static_cast<size_t>(stop - this->p);
+    if (len >= MAX_NUMBER_LENGTH) return fail();
+
+    char temp[MAX_NUMBER_LENGTH];
+    memcpy(temp, this->p, len);
+    temp[len] = '\0';
+
+    out = strtod(temp, nullptr);
+    this->p = stop;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::matchKey(const char* key, const char* keyEnd, bool hasEscapes,
+                          const JsonKey* keys, size_t keyCount,
+                          size_t& index) const {
+    if (keyCount == 0) return false;
+
+    char decoded[MAX_KEY_LENGTH];
+    size_t len = static_cast<size_t>(keyEnd - key);
+
+    if (hasEscapes) {
+        if (len > MAX_KEY_LENGTH || !json::unescape(key, len, decoded, len))
+            return false;
+        key = decoded;
+    }
+
+    const uint32_t signature = jsonKeySignature(key, len);
+    for (size_t i = 0; i < keyCount; i++) {
+        if (keys[i].signature == signature &&
+            keys[i].length == len &&
+            memcmp(keys[i].text, key, len) == 0) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JsonReader::readValue(bool& out) {
+    if (!beginValue()) return false;
+
+    const size_t left = static_cast<size_t>(this->end - this->p);
+    if (left >= 4 && memcmp(this->p, "true", 4) == 0) {
+        out = true;
+        this->p += 4;
+    } else if (left >= 5 && memcmp(this->p, "false", 5) == 0) {
+        out = false;
+        this->p += 5;
+    } else {
+        return fail();
+    }
+
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::readValue(float& out) {
+    double val;
+    if (!readReal(val)) return false;
+
+    out = static_cast<float>(val);
+    return true;
+}
+
+bool JsonReader::readValue(double& out) {
+    return readReal(out);
+}
+
+bool JsonReader::readValue(std::string& out) {
+    if (!beginValue() || *this->p != '"') return fail();
+
+    bool hasEscapes = false;
+    const char* start = this->p + 1;
+    const char* stop = json::skipString(start, this->end, hasEscapes);
+    if (!stop) return fail();
+    stop--;
+
+    const size_t rawLen = static_cast<size_t>(stop - start);
+    if (!hasEscapes) {
+        out.assign(start, rawLen);
+    } else {
+        std::string temp(rawLen, '\0');
+        size_t len = 0;
+        if (!json::unescape(start, rawLen, &temp[0], len)) return fail();
+        temp.resize(len);
+        out.swap(temp);
+    }
+
+    this->p = stop + 1;
+    this->isValuePending = false;
+    return true;
+}
+
+bool JsonReader::readValue(JsonSerializable& obj) {
+    return readObject(obj);
+}
+
+}
@@ -0,0 +1,585 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "JsonScanner.h"
+#include "Simd.h"
+#include "serdelite/Common.h"
+
+#include <string.h>
+
+namespace serdelite {
+namespace json {
+
+namespace {
+
+inline bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool isDelimiter(char c) {
+    return c == ',' || c == '}' || c == ']' || isWhitespace(c);
+}
+
+inline bool isBracket(char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']';
+}
+
+// Finds the next `"` or `\` at or after p, or returns end
+const char* findQuoteOrBackslash(const char* p, const char* end) {
+#if defined(SERDELITE_AVX2)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                                            _mm256_cmpeq_epi8(v, backslash))));
+        if (mask) return p + countTrailingZeros64(mask);
+    }
+#elif defined(SERDELITE_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                            _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                         _mm_cmpeq_epi8(v, backslash))));
+        if (mask) return p + countTrailingZeros64(mask);
+    }
+#endif
+
+    for (; p < end; p++) {
+        if (*p == '"' || *p == '\\') return p;
+    }
+    return end;
+}
+
+// Finds the next quote or bracket at or after p, or returns end. Setting bit
+// 0x20 folds `[` onto `{` and `]` onto `}`, so two compares cover all four.
+const char* findQuoteOrBracket(const char* p, const char* end) {
+#if defined(SERDELITE_AVX2)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i fold = _mm256_set1_epi8(0x20);
+    const __m256i open = _mm256_set1_epi8('{');
+    const __m256i close = _mm256_set1_epi8('}');
+
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i folded = _mm256_or_si256(v, fold);
+        __m256i hits = _mm256_or_si256(
+                           _mm256_cmpeq_epi8(v, quote),
+                           _mm256_or_si256(_mm256_cmpeq_epi8(folded, open),
+                                           _mm256_cmpeq_epi8(folded, close)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask) return p + countTrailingZeros64(mask);
+    }
+#elif defined(SERDELITE_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i fold = _mm_set1_epi8(0x20);
+    const __m128i open = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i folded = _mm_or_si128(v, fold);
+        __m128i hits = _mm_or_si128(
+                           _mm_cmpeq_epi8(v, quote),
+                           _mm_or_si128(_mm_cmpeq_epi8(folded, open),
+                                        _mm_cmpeq_epi8(folded, close)));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask) return p + countTrailingZeros64(mask);
+    }
+#endif
+
+    for (; p < end; p++) {
+        if (*p == '"' || isBracket(*p)) return p;
+    }
+    return end;
+}
+
+// Skips the rest of an object or array whose opening bracket precedes p
+const char* skipContainer(const char* p, const char* end) {
+    size_t depth = 1;
+    bool hasEscapes = false;
+
+    while ((p = findQuoteOrBracket(p, end)) < end) {
+        const char c = *p;
+        if (c == '"') {
+            p = skipString(p + 1, end, hasEscapes);
+            if (!p) return nullptr;
+            continue;
+        }
+
+        p++;
+        if (c == '{' || c == '[') {
+            depth++;
+        } else if (--depth == 0) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool readHex4(const char* p, const char* end, uint32_t& out) {
+    if (end - p < 4) return false;
+
+    out = 0;
+    for (int i = 0; i < 4; i++) {
+        const int digit = hexValue(p[i]);
+        if (digit < 0) return false;
+        out = (out << 4) | static_cast<uint32_t>(digit);
+    }
+    return true;
+}
+
+size_t encodeUtf8(uint32_t cp, char* dest) {
+    if (cp < 0x80) {
+        dest[0] = static_cast<char>(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        dest[0] = static_cast<char>(0xC0 | (cp >> 6));
+        dest[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        dest[0] = static_cast<char>(0xE0 | (cp >> 12));
+        dest[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        dest[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    dest[0] = static_cast<char>(0xF0 | (cp >> 18));
+    dest[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    dest[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    dest[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// Compares a raw (escaped) object key with a pointer reference token, where
+// `~0` stands for `~` and `~1` for `/`
+bool keyEquals(const char* key, const char* keyEnd, bool keyHasEscapes,
+               const char* token, const char* tokenEnd) {
+    const size_t tokenLen = static_cast<size_t>(tokenEnd - token);
+
+    if (!keyHasEscapes && !memchr(token, '~', tokenLen)) {
+        return static_cast<size_t>(keyEnd - key) == tokenLen &&
+               memcmp(key, token, tokenLen) == 0;
+    }
+
+    char bytes[4];
+    while (key < keyEnd) {
+        size_t n = 1;
+        if (*key == '\\') {
+            n = decodeEscape(key, keyEnd, bytes);
+            if (n == 0) return false;
+        } else {
+            bytes[0] = *key++;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            if (token == tokenEnd) return false;
+
+            char c = *token++;
+            if (c == '~') {
+                if (token == tokenEnd) return false;
+                if (*token == '0') c = '~';
+                else if (*token == '1') c = '/';
+                else return false;
+                token++;
+            }
+            if (c != bytes[i]) return false;
+        }
+    }
+    return token == tokenEnd;
+}
+
+// Parses an array index token (no sign, no leading zeros)
+bool parseIndex(const char* token, const char* tokenEnd, size_t& out) {
+    if (token == tokenEnd) return false;
+    if (*token == '0' && tokenEnd - token > 1) return false;
+
+    out = 0;
+    for (; token < tokenEnd; token++) {
+        if (*token < '0' || *token > '9') return false;
+        if (out > (static_cast<size_t>(-1) - 9) / 10) return false;
+        out = out * 10 + static_cast<size_t>(*token - '0');
+    }
+    return true;
+}
+
+/*
+ * Walks the document once, descending only into members and elements that
+ * some pointer still needs. `active` holds the pointers whose tokens matched
+ * so far and which have more tokens to go; `cursors[i]` is the offset of the
+ * next token of pointer i.
+ */
+class PointerResolver {
+public:
+    PointerResolver(const char* text, size_t len,
+                    const char* const* _pointers, JsonBuffer* _values)
+        : end(text + len),
+          pointers(_pointers),
+          values(_values),
+          remaining(0),
+          isDone(false)
+    {}
+
+    size_t resolve(const char* p, size_t count) {
+        uint64_t active = 0;
+        uint64_t atRoot = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            values[i] = JsonBuffer();
+            cursors[i] = 0;
+
+            const char* pointer = pointers[i];
+            if (!pointer) continue;
+            if (*pointer == '\0') atRoot |= (1ULL << i);
+            else if (*pointer == '/') active |= (1ULL << i);
+            else continue;
+            remaining++;
+        }
+        const size_t requested = remaining;
+
+        p = skipWhitespace(p, end);
+        if (p == end || remaining == 0) return 0;
+
+        const char* valueEnd = visit(p, active);
+        if (valueEnd && atRoot) record(atRoot, p, valueEnd);
+
+        return requested - remaining;
+    }
+
+private:
+    const char* end;
+    const char* const* pointers;
+    JsonBuffer* values;
+    size_t cursors[MAX_POINTERS];
+    size_t remaining;
+    bool isDone;
+
+    void record(uint64_t set, const char* start, const char* stop) {
+        for (; set; set &= set - 1) {
+            const size_t i = countTrailingZeros64(set);
+            values[i] = JsonBuffer(start, static_cast<size_t>(stop - start));
+            remaining--;
+        }
+        if (remaining == 0) isDone = true;
+    }
+
+    void token(size_t i, const char*& begin, const char*& stop) const {
+        begin = pointers[i] + cursors[i] + 1;
+        stop = begin;
+        while (*stop != '\0' && *stop != '/') stop++;
+    }
+
+    // Moves the pointers of `set` past their current token and splits them
+    // into those that end here and those that continue deeper
+    void advance(uint64_t set, uint64_t& ending, uint64_t& deeper) {
+        ending = 0;
+        deeper = 0;
+        for (; set; set &= set - 1) {
+            const size_t i = countTrailingZeros64(set);
+            const char* begin;
+            const char* stop;
+            token(i, begin, stop);
+
+            cursors[i] = static_cast<size_t>(stop - pointers[i]);
+            if (*stop == '\0') ending |= (1ULL << i);
+            else deeper |= (1ULL << i);
+        }
+    }
+
+    // Handles one member or element value that `matched` pointers selected
+    const char* visitChild(const char* p, uint64_t matched) {
+        uint64_t ending, deeper;
+        advance(matched, ending, deeper);
+
+        const char* valueEnd = deeper ? visit(p, deeper) : skipValue(p, end);
+        if (!valueEnd || isDone) return valueEnd;
+
+        if (ending) record(ending, p, valueEnd);
+        return valueEnd;
+    }
+
+    const char* visit(const char* p, uint64_t active) {
+        if (active == 0) return skipValue(p, end);
+        if (*p == '{') return visitObject(p + 1, active);
+        if (*p == '[') return visitArray(p + 1, active);
+        return skipValue(p, end);
+    }
+
+    const char* visitObject(const char* p, uint64_t active) {
+        p = skipWhitespace(p, end);
+        if (p < end && *p == '}') return p + 1;
+
+        while (p < end) {
+            if (active == 0) return skipContainer(p, end);
+            if (*p != '"') return nullptr;
+
+            bool hasEscapes = false;
+            const char* key = p + 1;
+            p = skipString(key, end, hasEscapes);
+            if (!p) return nullptr;
+            const char* keyEnd = p - 1;
+
+            p = skipWhitespace(p, end);
+            if (p == end || *p != ':') return nullptr;
+            p = skipWhitespace(p + 1, end);
+            if (p == end) return nullptr;
+
+            // The first occurrence of a duplicated key wins
+            uint64_t matched = 0;
+            for (uint64_t set = active; set; set &= set - 1) {
+                const size_t i = countTrailingZeros64(set);
+                const char* begin;
+                const char* stop;
+                token(i, begin, stop);
+                if (keyEquals(key, keyEnd, hasEscapes, begin, stop))
+                    matched |= (1ULL << i);
+            }
+            active &= ~matched;
+
+            p = matched ? visitChild(p, matched) : skipValue(p, end);
+            if (!p || isDone) return p;
+
+            p = skipWhitespace(p, end);
+            if (p == end) return nullptr;
+            if (*p == '}') return p + 1;
+            if (*p != ',') return nullptr;
+            p = skipWhitespace(p + 1, end);
+        }
+        return nullptr;
+    }
+
+    const char* visitArray(const char* p, uint64_t active) {
+        size_t indices[MAX_POINTERS];
+
+        for (uint64_t set = active; set; set &= set - 1) {
+            const size_t i = countTrailingZeros64(set);
+            const char* begin;
+            const char* stop;
+            token(i, begin, stop);
+            if (!parseIndex(begin, stop, indices[i])) active &= ~(1ULL << i);
+        }
+
+        p = skipWhitespace(p, end);
+        if (p < end && *p == ']') return p + 1;
+
+        for (size_t index = 0; p < end; index++) {
+            if (active == 0) return skipContainer(p, end);
+
+            uint64_t matched = 0;
+            for (uint64_t set = active; set; set &= set - 1) {
+                const size_t i = countTrailingZeros64(set);
+                if (indices[i] == index) matched |= (1ULL << i);
+            }
+            active &= ~matched;
+
+            p = matched ? visitChild(p, matched) : skipValue(p, end);
+            if (!p || isDone) return p;
+
+            p = skipWhitespace(p, end);
+            if (p == end) return nullptr;
+            if (*p == ']') return p + 1;
+            if (*p != ',') return nullptr;
+            p = skipWhitespace(p + 1, end);
+        }
+        return nullptr;
+    }
+};
+
+} // namespace
+
+const char* skipWhitespace(const char* p, const char* end) {
+    while (p < end && isWhitespace(*p)) p++;
+    return p;
+}
+
+const char* skipString(const char* p, const char* end, bool& hasEscapes) {
+    while ((p = findQuoteOrBackslash(p, end)) < end) {
+        if (*p == '"') return p + 1;
+
+        // Skip the backslash and the character it escapes
+        hasEscapes = true;
+        if (end - p < 2) return nullptr;
+        p += 2;
+    }
+    return nullptr;
+}
+
+const char* skipValue(const char* p, const char* end) {
+    if (p >= end) return nullptr;
+
+    if (*p == '"') {
+        bool hasEscapes = false;
+        return skipString(p + 1, end, hasEscapes);
+    }
+    if (*p == '{' || *p == '[') return skipContainer(p + 1, end);
+
+    // Number or literal
+    const char* start = p;
+    while (p < end && !isDelimiter(*p) && *p != ':' && *p != '"') p++;
+    return (p == start) ? nullptr : p;
+}
+
+const char* findEscapable(const char* p, const char* end) {
+    // A byte is a control character when max(byte, 0x1F) == 0x1F
+#if defined(SERDELITE_AVX2)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_or_si256(
+                           _mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                                           _mm256_cmpeq_epi8(v, backslash)),
+                           _mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask) return p + countTrailingZeros64(mask);
+    }
+#elif defined(SERDELITE_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(
+                           _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                        _mm_cmpeq_epi8(v, backslash)),
+                           _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask) return p + countTrailingZeros64(mask);
+    }
+#endif
+
+    for (; p < end; p++) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\' || c < 0x20) return p;
+    }
+    return end;
+}
+
+size_t decodeEscape(const char*& p, const char* end, char* dest) {
+    if (end - p < 2 || *p != '\\') return 0;
+
+    char c;
+    switch (p[1]) {
+    case '"':  c = '"';  break;
+    case '\\': c = '\\'; break;
+    case '/':  c = '/';  break;
+    case 'b':  c = '\b'; break;
+    case 'f':  c = '\f'; break;
+    case 'n':  c = '\n'; break;
+    case 'r':  c = '\r'; break;
+    case 't':  c = '\t'; break;
+    case 'u': {
+        uint32_t cp;
+        if (!readHex4(p + 2, end, cp)) return 0;
+        size_t consumed = 6;
+
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            // A high surrogate must be followed by an escaped low surrogate
+            uint32_t low;
+            if (end - p < 12 || p[6] != '\\' || p[7] != 'u' ||
+                !readHex4(p + 8, end, low) ||
+                low < 0xDC00 || low > 0xDFFF) return 0;
+
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            consumed = 12;
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+            return 0;
+        }
+
+        p += consumed;
+        return encodeUtf8(cp, dest);
+    }
+    default:
+        return 0;
+    }
+
+    dest[0] = c;
+    p += 2;
+    return 1;
+}
+
+bool unescape(const char* src, size_t len, char* dest, size_t& outLen) {
+    const char* p = src;
+    const char* end = src + len;
+    char* out = dest;
+
+    while (p < end) {
+#if defined(SERDELITE_AVX2)
+        const __m256i backslash = _mm256_set1_epi8('\\');
+
+        for (; end - p >= 32; p += 32, out += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                                _mm256_cmpeq_epi8(v, backslash)));
+            if (mask) break;
+
+            // In place, nothing moves until the first escape
+            if (out != p) _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+        }
+#elif defined(SERDELITE_SSE2)
+        const __m128i backslash = _mm_set1_epi8('\\');
+
+        for (; end - p >= 16; p += 16, out += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                                _mm_cmpeq_epi8(v, backslash)));
+            if (mask) break;
+
+            if (out != p) _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+        }
+#endif
+
+        // Copy up to the next escape; the regions overlap when in place
+        const char* escape = static_cast<const char*>(
+                                 memchr(p, '\\', static_cast<size_t>(end - p)));
+        if (!escape) escape = end;
+
+        const size_t run = static_cast<size_t>(escape - p);
+        if (out != p) memmove(out, p, run);
+        out += run;
+        p = escape;
+
+        if (p < end) {
+            const size_t n = decodeEscape(p, end, out);
+            if (n == 0) return false;
+            out += n;
+        }
+    }
+
+    outLen = static_cast<size_t>(out - dest);
+    return true;
+}
+
+size_t findPointers(const char* text, size_t len,
+                    const char* const* pointers, size_t count,
+                    JsonBuffer* values) {
+    if (!text || !pointers || !values || count > MAX_POINTERS) return 0;
+
+    PointerResolver resolver(text, len, pointers, values);
+    return resolver.resolve(text, count);
+}
+
+} // namespace json
+} // namespace serdelite
@@ -0,0 +1,110 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file JsonScanner.h
+ * @brief Internal routines that skip over JSON text without parsing it.
+ *
+ * Strings and nested containers are skipped by searching 16 (SSE2) or 32
+ * (AVX2) bytes at a time for the few characters that matter: quotes and
+ * backslashes inside strings, and quotes and brackets inside containers.
+ * The scanner trusts the input to be well-formed; malformed text never makes
+ * it read out of bounds but may yield meaningless spans.
+ *
+ * @note This header is private to the library sources and is not installed.
+ */
+
+#ifndef SERDELITE_JSONSCANNER_H
+#define SERDELITE_JSONSCANNER_H
+
+#include "serdelite/JsonBuffer.h"
+
+#include <stddef.h>
+
+namespace serdelite {
+namespace json {
+
+/**
+ * @brief Skips JSON whitespace.
+ * @return Returns the first non-whitespace character at or after `p`, or `end`.
+ */
+const char* skipWhitespace(const char* p, const char* end);
+
+/**
+ * @brief Skips the rest of a string.
+ * @param p The first character after the opening quote.
+ * @param end One past the last character of the text.
+ * @param[out] hasEscapes Set to `true` if the string contains a backslash.
+ * @return Returns the character after the closing quote, or `nullptr` if
+ * 		   the string is not terminated.
+ */
+const char* skipString(const char* p, const char* end, bool& hasEscapes);
+
+/**
+ * @brief Skips one value (string, number, literal, object or array).
+ * @param p The first character of the value.
+ * @param end One past the last character of the text.
+ * @return Returns the character after the value, or `nullptr` if the value
+ * 		   is empty or not terminated.
+ */
+const char* skipValue(const char* p, const char* end);
+
+/**
+ * @brief Finds the next character that must be escaped inside a string.
+ * @return Returns the first `"`, `\\` or control character (below 0x20) at or
+ * 		   after `p`, or `end`.
+ */
+const char* findEscapable(const char* p, const char* end);
+
+/**
+ * @brief Decodes one backslash escape sequence into UTF-8.
+ * @param[in,out] p Points at the backslash; advanced past the sequence.
+ * @param end One past the last character of the text.
+ * @param[out] dest Destination of up to 4 bytes.
+ * @return Returns the number of bytes written, or `0` if the escape is
+ * 		   malformed (`p` is left unchanged then).
+ */
+size_t decodeEscape(const char*& p, const char* end, char* dest);
+
+/**
+ * @brief Decodes the escapes of a string body into UTF-8.
+ *
+ * Clean runs are copied 32 (AVX2) or 16 (SSE2) bytes at a time while searching
+ * for the next backslash; escapes are decoded one by one on the side.
+ *
+ * @param src The characters between the quotes.
+ * @param len Number of characters in `src`.
+ * @param[out] dest Destination of at least `len` bytes; may equal `src`,
+ * 					since decoding never lengthens the text.
+ * @param[out] outLen Receives the decoded length.
+ * @return Returns `true` if every escape is well-formed.
+ */
+bool unescape(const char* src, size_t len, char* dest, size_t& outLen);
+
+/** @brief Maximum number of pointers `findPointers()` resolves in one pass. */
+static const size_t MAX_POINTERS = 64;
+
+/**
+ * @brief Resolves several RFC 6901 JSON Pointers in a single pass.
+ * @param text The JSON document.
+ * @param len Number of characters in `text`.
+ * @param pointers The pointers, e.g. `"/player/stats/xp"`.
+ * @param count Number of pointers (at most @ref MAX_POINTERS).
+ * @param[out] values Receives the raw text of each value; an empty buffer
+ * 					  (`data == nullptr`) for pointers that do not resolve.
+ * @return Returns the number of pointers that resolved.
+ */
+size_t findPointers(const char* text, size_t len,
+                    const char* const* pointers, size_t count,
+                    JsonBuffer* values);
+
+} // namespace json
+} // namespace serdelite
+
+#endif
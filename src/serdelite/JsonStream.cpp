@@ -8,62 +8,252 @@
  */
 
 #include "serdelite/JsonStream.h"
+#include "serdelite/ByteStream.h"
 #include "serdelite/Common.h"
+#include "Digits.h"
+#include "Hex.h"
+#include "JsonScanner.h"
+#include "JsonValidator.h"
 
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
 
+#if !defined(SERDELITE_VALIDATE_RAW_JSON)
+    #if defined(NDEBUG)
+        #define SERDELITE_VALIDATE_RAW_JSON 0
+    #else
+        #define SERDELITE_VALIDATE_RAW_JSON 1
+    #endif
+#endif
+
 namespace serdelite {
 
-JsonStream::JsonStream(ByteBuffer& _buffer)
+// Longest text of a 64-bit integer: sign and 20 digits
+static const size_t MAX_INT_LENGTH = 21;
+
+// Longest escape of one input byte: \u00XX
+static const size_t MAX_ESCAPE_LENGTH = 6;
+
+// Longest fixed-point text: sign, 20 digits and the decimal point
+static const size_t MAX_FIXED_LENGTH = 22;
+
+// Parts of one JSON Patch operation around its path. "add" replaces a member
+// the target already has and creates one it does not, where "replace" fails
+static const char PATCH_OP[] = "{\"op\":\"add\",\"path\":\"";
+static const char PATCH_VALUE[] = "\",\"value\":";
+static const size_t PATCH_OP_LENGTH = sizeof(PATCH_OP) - 1;
+static const size_t PATCH_VALUE_LENGTH = sizeof(PATCH_VALUE) - 1;
+
+static const double POW10[JsonStream::MAX_FIXED_DIGITS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+static inline char* formatInteger(char* out, uint64_t val,
+                                  uint8_t bitSize, bool isSigned) {
+    if (isSigned) {
+        int64_t sVal = 0;
+        interpretAsSigned(val, bitSize, sVal);
+        if (sVal < 0) {
+            *out++ = '-';
+            val = 0 - static_cast<uint64_t>(sVal);
+        } else {
+            val = static_cast<uint64_t>(sVal);
+        }
+    }
+    return out + digits::formatUint64(val, out);
+}
+
+// Rounds `val` to `fractionDigits` decimals and prints it without trailing
+// zeros; returns nullptr if the scaled value is past 2^53, where doubles no
+// longer hold every integer and the units would carry made-up digits
+static char* formatFixed(char* out, double val, uint8_t fractionDigits) {
+    const bool isNegative = val < 0;
+    const double scaled = (isNegative ? -val : val) * POW10[fractionDigits] + 0.5;
+    if (!(scaled < 9007199254740992.0)) return nullptr;
+
+    uint64_t units = static_cast<uint64_t>(scaled);
+    if (units == 0) {
+        *out++ = '0';
+        return out;
+    }
+    if (isNegative) *out++ = '-';
+
+    // Drop trailing zeros before splitting off the fraction
+    uint8_t digitCount = fractionDigits;
+    while (digitCount > 0 && units % 10 == 0) {
+        units /= 10;
+        digitCount--;
+    }
+
+    const uint64_t divisor = static_cast<uint64_t>(POW10[digitCount]);
+    out += digits::formatUint64(units / divisor, out);
+    if (digitCount > 0) {
+        *out++ = '.';
+        digits::formatUint64Padded(units % divisor, out, digitCount);
+        out += digitCount;
+    }
+    return out;
+}
+
+// Writes the escape of one byte that findEscapable() stopped at
+static inline size_t escapeChar(unsigned char c, char* dest) {
+    static const char HEX[] = "0123456789ABCDEF";
+
+    dest[0] = '\\';
+    switch (c) {
+    case '\"': dest[1] = '\"'; return 2;
+    case '\\': dest[1] = '\\'; return 2;
+    case '\n': dest[1] = 'n'; return 2;
+    case '\t': dest[1] = 't'; return 2;
+    case '\r': dest[1] = 'r'; return 2;
+    case '\b': dest[1] = 'b'; return 2;
+    case '\f': dest[1] = 'f'; return 2;
+    default:
+        dest[1] = 'u';
+        dest[2] = '0';
+        dest[3] = '0';
+        dest[4] = HEX[c >> 4];
+        dest[5] = HEX[c & 0xF];
+        return 6;
+    }
+}
+
+// Escapes into memory known to hold MAX_ESCAPE_LENGTH bytes per input byte
+static char* escapeInto(char* out, const char* str, size_t len) {
+    const char* end = str + len;
+
+    while (str < end) {
+        const char* run = json::findEscapable(str, end);
+        memcpy(out, str, static_cast<size_t>(run - str));
+        out += run - str;
+        if (run == end) break;
+
+        out += escapeChar(static_cast<unsigned char>(*run), out);
+        str = run + 1;
+    }
+    return out;
+}
+
+JsonStream::JsonStream(ByteBuffer& _buffer, JsonDocument _document)
     : buffer(_buffer),
+      documentStart(_buffer.getSize()),
+      document(_document),
       isFirstField(true),
-      isClosed(false)
+      isClosed(false),
+      isArrayLevel(_document == JsonDocument::Array),
+      fixedDigits(FULL_PRECISION),
+      fieldFilter(nullptr),
+      fieldIndex(0),
+      patchPath(nullptr),
+      patchPathLen(0),
+      isPatchOpOpen(false)
 {
-    this->buffer
-        .addByte(static_cast<uint8_t>('{'));
+    openDocument();
+}
+
+bool JsonStream::openDocument() {
+    const char opening = (this->document == JsonDocument::Array) ? '[' : '{';
+    return this->buffer
+               .addByte(static_cast<uint8_t>(opening));
 }
 
 bool JsonStream::writeObject(const char* key,
                              const JsonSerializable& obj) {
+    return writeField(key, obj);
+}
+
+bool JsonStream::writeRawJson(const char* key,
+                              const char* json,
+                              size_t len) {
+    if (!json || len == 0) return false;
+
+#if SERDELITE_VALIDATE_RAW_JSON
+    if (!json::isValidValue(json, len)) return false;
+#endif
+
+    return writeRawField(key, json, len);
+}
+
+bool JsonStream::writeMergePatch(const JsonSerializable& obj,
+                                 DirtyMask& dirty) {
+    if (this->isClosed || this->isArrayLevel ||
+        !this->isFirstField || this->fieldFilter)
+        return false;
+
     size_t startLen = this->buffer.getSize();
-    if (!startField(key)) return false;
 
-        
-    if (!this->buffer
-             .addByte(static_cast<uint8_t>('{'))) {
+    this->fieldFilter = &dirty;
+    this->fieldIndex = 0;
+
+    bool success = obj.toJson(*this);
+
+    this->fieldFilter = nullptr;
+
+    if (!success) {
         this->buffer.setLength(startLen);
+        this->isFirstField = true;
+        this->isClosed = false;
         return false;
     }
 
-    // Save parent state
+    dirty.clean();
+    return true;
+}
+
+bool JsonStream::writeJsonPatch(const JsonSerializable& obj,
+                                DirtyMask& dirty,
+                                const char* basePath) {
+    if (this->isClosed || !this->isArrayLevel || this->fieldFilter)
+        return false;
+
+    size_t startLen = this->buffer.getSize();
     bool parentFirst = this->isFirstField;
-    bool parentClosed = this->isClosed;
 
-    // Reset for the child (Child's first field needs no comma)
-    this->isFirstField = true;
+    // The fields of `obj` are written as operations of the top-level array
+    this->isArrayLevel = false;
+    this->fieldFilter = &dirty;
+    this->fieldIndex = 0;
+    this->patchPath = basePath ? basePath : "";
+    this->patchPathLen = strlen(this->patchPath);
+    this->isPatchOpOpen = false;
+
+    bool success = obj.toJson(*this);
+
+    // The last operation is closed once its value is complete
+    success = success &&
+              (!this->isPatchOpOpen ||
+               this->buffer.addByte(static_cast<uint8_t>('}')));
+
+    this->isArrayLevel = true;
     this->isClosed = false;
+    this->fieldFilter = nullptr;
+    this->patchPath = nullptr;
+    this->isPatchOpOpen = false;
 
-    if (!obj.toJson(*this)) {
+    if (!success) {
         this->buffer.setLength(startLen);
         this->isFirstField = parentFirst;
-        this->isClosed = parentClosed;
         return false;
     }
 
-    // Restore parent state
-    this->isFirstField = parentFirst;
-    this->isClosed = parentClosed;
-
+    dirty.clean();
     return true;
 }
 
 bool JsonStream::close() {
     if (this->isClosed) return true;
 
+    // Inside writeJsonPatch(), where the array stays open
+    if (this->patchPath) {
+        this->isClosed = true;
+        return true;
+    }
+
+    const char closing = this->isArrayLevel ? ']' : '}';
     if (!this->buffer
-             .addByte(static_cast<uint8_t>('}')))
+             .addByte(static_cast<uint8_t>(closing)))
         return false;
 
     uint8_t* raw = this->buffer.getRawBytes();
@@ -77,6 +267,38 @@ bool JsonStream::close() {
     return true;
 }
 
+bool JsonStream::nextDocument() {
+    if (this->document != JsonDocument::Lines) return false;
+
+    size_t startLen = this->buffer.getSize();
+    bool wasClosed = this->isClosed;
+
+    if (!close() ||
+        !this->buffer.addByte(static_cast<uint8_t>('\n')) ||
+        !openDocument()) {
+        this->buffer.setLength(startLen);
+        this->isClosed = wasClosed;
+        return false;
+    }
+
+    this->isFirstField = true;
+    this->isClosed = false;
+    return true;
+}
+
+bool JsonStream::reset() {
+    this->buffer.setLength(this->documentStart);
+    this->isFirstField = true;
+    this->isClosed = false;
+    this->fieldIndex = 0;
+
+    return openDocument();
+}
+
+JsonDocument JsonStream::getDocument() const {
+    return this->document;
+}
+
 bool JsonStream::writeUint8(const char* key, uint8_t val) {
     return writeIntBits(key,
                         static_cast<uint64_t>(val),
@@ -128,69 +350,278 @@ bool JsonStream::writeInt64(const char* key, int64_t val) {
 
 
 bool JsonStream::writeFloat(const char* key, float val) {
+    return writeField(key, val);
+}
+
+bool JsonStream::writeDouble(const char* key, double val) {
+    return writeField(key, val);
+}
+
+bool JsonStream::setFixedPrecision(uint8_t fractionDigits) {
+    if (fractionDigits > MAX_FIXED_DIGITS &&
+        fractionDigits != FULL_PRECISION) return false;
+
+    this->fixedDigits = fractionDigits;
+    return true;
+}
+
+uint8_t JsonStream::getFixedPrecision() const {
+    return this->fixedDigits;
+}
+
+bool JsonStream::writeFixed(const char* key, double val,
+                            uint8_t fractionDigits) {
+    if (fractionDigits > MAX_FIXED_DIGITS) return false;
+    if (skipField()) return true;
+
     size_t startLen = this->buffer.getSize();
+    bool parentFirst = this->isFirstField;
     if (!startField(key)) return false;
 
-    if (!isfinite(val)) {
-        if (!writeRaw("null", 4)) {
-            this->buffer.setLength(startLen);
-            return false;
-        }
-        return true;
+    if (!writeFixedValue(val, fractionDigits)) {
+        this->buffer.setLength(startLen);
+        this->isFirstField = parentFirst;
+        return false;
     }
+    return true;
+}
 
-    char temp[32];
-    int len = snprintf(temp, sizeof(temp), "%.9g", val);
+#if defined(SERDELITE_HAS_INT128)
+bool JsonStream::writeUint128(const char* key, uint128_t val) {
+    char temp[digits::MAX_UINT128_DIGITS];
+    size_t len = digits::formatUint128(val, temp);
+    return writeRawField(key, temp, len);
+}
+
+bool JsonStream::writeInt128(const char* key, int128_t val) {
+    char temp[digits::MAX_UINT128_DIGITS + 1];
+    size_t len = 0;
+
+    uint128_t magnitude = static_cast<uint128_t>(val);
+    if (val < 0) {
+        temp[len++] = '-';
+        magnitude = 0 - magnitude;
+    }
+    len += digits::formatUint128(magnitude, temp + len);
+    return writeRawField(key, temp, len);
+}
+
+bool JsonStream::writeDecimal(const char* key, const Decimal& val) {
+    char temp[Decimal::MAX_STRING_LENGTH];
+    size_t len = val.format(temp);
+    return writeRawField(key, temp, len);
+}
+#endif
+
+
+bool JsonStream::writeBool(const char* key, bool val) {
+    if (skipField()) return true;
+    if (this->isClosed || this->isArrayLevel || !key) return false;
+
+    const size_t keyLen = strlen(key);
+    char* out = reserveOutput(fieldPrefixSize(key, keyLen) + (val ? 4 : 5));
+    if (!out) return false;
+
+    out = writeFieldPrefix(out, key, keyLen);
+    if (val) {
+        memcpy(out, "true", 4);
+        out += 4;
+    } else {
+        memcpy(out, "false", 5);
+        out += 5;
+    }
+    return commitOutput(out);
+}
+
+bool JsonStream::writeElement(const char* val) {
+    return writeElement<const char*>(val);
+}
+
+bool JsonStream::writeString(const char* key, const char* val) {
+    return writeField(key, val);
+}
+
+bool JsonStream::writeString(const char* key, const std::string& val) {
+    return writeField(key, val);
+}
+
+bool JsonStream::writeMessage(const char* key, const void* obj,
+                              const MessageDescriptor& descriptor) {
+    if (!obj) return false;
+
+    size_t startLen = this->buffer.getSize();
+    bool parentFirst = this->isFirstField;
+    if (skipField()) return true;
+    if (!startField(key)) return false;
 
-    if (len < 0 || len >= (int)sizeof(temp) ||
-        !writeRaw(temp, len)) {
+    if (!writeDescribed(static_cast<const uint8_t*>(obj), nullptr,
+                        descriptor)) {
         this->buffer.setLength(startLen);
+        this->isFirstField = parentFirst;
         return false;
     }
     return true;
 }
 
-bool JsonStream::writeDouble(const char* key, double val) {
+bool JsonStream::writeMessage(const char* key, ByteStream& in,
+                              const MessageDescriptor& descriptor) {
+    if (this->fieldFilter) return false;
+
     size_t startLen = this->buffer.getSize();
+    bool parentFirst = this->isFirstField;
     if (!startField(key)) return false;
 
-    if (!isfinite(val)) {
-        if (!writeRaw("null", 4)) {
-            this->buffer.setLength(startLen);
-            return false;
-        }
-        return true;
+    if (!writeDescribed(nullptr, &in, descriptor)) {
+        this->buffer.setLength(startLen);
+        this->isFirstField = parentFirst;
+        return false;
     }
+    return true;
+}
 
-    char temp[32];
-    int len = snprintf(temp, sizeof(temp), "%.17g", val);
-    
-    if (len < 0 || len >= (int)sizeof(temp) ||
-        !writeRaw(temp, len)) {
+bool JsonStream::writeFields(const void* obj,
+                             const MessageDescriptor& descriptor) {
+    if (this->isClosed || this->isArrayLevel || !obj) return false;
+
+    size_t startLen = this->buffer.getSize();
+    bool parentFirst = this->isFirstField;
+
+    if (!writeDescribedFields(static_cast<const uint8_t*>(obj), nullptr,
+                              descriptor, this->isFirstField)) {
         this->buffer.setLength(startLen);
+        this->isFirstField = parentFirst;
         return false;
     }
     return true;
 }
 
+bool JsonStream::writeFields(ByteStream& in,
+                             const MessageDescriptor& descriptor) {
+    if (this->isClosed || this->isArrayLevel || this->fieldFilter)
+        return false;
 
-bool JsonStream::writeBool(const char* key, bool val) {
-    if (!startField(key)) return false;
-    return val ? writeRaw("true", 4) : writeRaw("false", 5);
+    size_t startLen = this->buffer.getSize();
+    bool parentFirst = this->isFirstField;
+
+    if (!writeDescribedFields(nullptr, &in, descriptor, this->isFirstField)) {
+        this->buffer.setLength(startLen);
+        this->isFirstField = parentFirst;
+        return false;
+    }
+    return true;
 }
 
-bool JsonStream::writeString(const char* key, const char* val) {
-    if (!startField(key)) return false;
-    
-    if (!val) return writeRaw("null", 4);
+bool JsonStream::writeTimestamp(const char* key,
+                                int64_t epochNanos,
+                                uint8_t fractionDigits) {
+    if (fractionDigits > 9) return false;
 
-    if (!this->buffer
-             .addByte(static_cast<uint8_t>('\"'))) return false;
+    const int64_t NANOS_PER_SECOND = 1000000000LL;
+    const int64_t SECONDS_PER_DAY = 86400;
 
-    if (!writeEscaped(val)) return false;
-    
-    return this->buffer
-                .addByte(static_cast<uint8_t>('\"'));
+    // Floor division so that instants before 1970 resolve correctly
+    int64_t seconds = epochNanos / NANOS_PER_SECOND;
+    int64_t nanos = epochNanos % NANOS_PER_SECOND;
+    if (nanos < 0) {
+        nanos += NANOS_PER_SECOND;
+        seconds--;
+    }
+
+    int64_t days = seconds / SECONDS_PER_DAY;
+    int64_t secOfDay = seconds % SECONDS_PER_DAY;
+    if (secOfDay < 0) {
+        secOfDay += SECONDS_PER_DAY;
+        days--;
+    }
+
+    // Years start on March 1 here, so the leap day ends the year and every
+    // month starts on the same day of the year in leap and common years
+    static const uint16_t DAYS_BEFORE_MONTH[13] = {
+        0, 31, 61, 92, 122, 153, 184, 214, 245, 275, 306, 337, 366
+    };
+
+    // Year from the 400, 100 and 4-year leap cycles (proleptic Gregorian);
+    // int64 nanoseconds span 1677 to 2262, so the day number stays positive
+    const int64_t z = days + 719468;
+    const int64_t era = z / 146097;
+    const int64_t doe = z - era * 146097;
+    const int64_t yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    const int64_t doy = doe - (365*yoe + yoe/4 - yoe/100);
+
+    // Month and day from the table; doy / 31 is at most one month early
+    size_t mp = static_cast<size_t>(doy / 31);
+    if (doy >= DAYS_BEFORE_MONTH[mp + 1]) mp++;
+
+    const int64_t day = doy - DAYS_BEFORE_MONTH[mp] + 1;
+    const int64_t month = static_cast<int64_t>(mp < 10 ? mp + 3 : mp - 9);
+    const int64_t year = yoe + era*400 + (month <= 2 ? 1 : 0);
+
+    // "YYYY-MM-DDTHH:MM:SS" + ".fffffffff" + "Z", quoted
+    char temp[32];
+    char* p = temp;
+    const char* pairs = digits::PAIRS;
+
+    *p++ = '\"';
+    digits::formatUint64Padded(static_cast<uint64_t>(year), p, 4);
+    p += 4;
+    *p++ = '-';
+    memcpy(p, pairs + month*2, 2);
+    p += 2;
+    *p++ = '-';
+    memcpy(p, pairs + day*2, 2);
+    p += 2;
+    *p++ = 'T';
+    memcpy(p, pairs + (secOfDay / 3600)*2, 2);
+    p += 2;
+    *p++ = ':';
+    memcpy(p, pairs + (secOfDay / 60 % 60)*2, 2);
+    p += 2;
+    *p++ = ':';
+    memcpy(p, pairs + (secOfDay % 60)*2, 2);
+    p += 2;
+
+    if (fractionDigits > 0) {
+        char fraction[9];
+        digits::formatUint64Padded(static_cast<uint64_t>(nanos), fraction, 9);
+        *p++ = '.';
+        memcpy(p, fraction, fractionDigits);
+        p += fractionDigits;
+    }
+
+    *p++ = 'Z';
+    *p++ = '\"';
+
+    return writeRawField(key, temp, static_cast<size_t>(p - temp));
+}
+
+bool JsonStream::writeUuid(const char* key, const uint8_t* bytes) {
+    if (!bytes) return false;
+
+    char digitsBuf[32];
+    hex::encode(bytes, 16, digitsBuf, false);
+
+    // 8-4-4-4-12 groups, quoted
+    char temp[38];
+    temp[0] = '\"';
+    memcpy(temp + 1, digitsBuf, 8);
+    temp[9] = '-';
+    memcpy(temp + 10, digitsBuf + 8, 4);
+    temp[14] = '-';
+    memcpy(temp + 15, digitsBuf + 12, 4);
+    temp[19] = '-';
+    memcpy(temp + 20, digitsBuf + 16, 4);
+    temp[24] = '-';
+    memcpy(temp + 25, digitsBuf + 20, 12);
+    temp[37] = '\"';
+
+    return writeRawField(key, temp, sizeof(temp));
+}
+
+bool JsonStream::writeEnum(const char* key, size_t index,
+                           const EnumName* names, size_t count) {
+    if (!names || index >= count || !names[index].text) return false;
+
+    return writeRawField(key, names[index].text, names[index].length);
 }
 
 JsonBuffer JsonStream::getJson() const {
@@ -211,97 +642,451 @@ bool JsonStream::writeIntBits(const char* key,
     if (bitSize == 0 || bitSize>64 || bitSize%8 != 0)
         return false;
 
-    int startLen = this->buffer.getSize();
+    if (skipField()) return true;
+    if (this->isClosed || this->isArrayLevel || !key) return false;
+
+    // Fast path: one capacity check for the worst case, then unchecked writes
+    const size_t keyLen = strlen(key);
+    char* out = reserveOutput(fieldPrefixSize(key, keyLen) + MAX_INT_LENGTH);
+    if (out) {
+        out = writeFieldPrefix(out, key, keyLen);
+        return commitOutput(formatInteger(out, val, bitSize, isSigned));
+    }
+
+    // Close to the end of the buffer: exact, checked writes
+    size_t startLen = this->buffer.getSize();
+    bool parentFirst = this->isFirstField;
 
     if (!startField(key)) return false;
 
-    char temp[24];
-    int len=0;
+    if (!writeIntValue(val, bitSize, isSigned)) {
+        this->buffer.setLength(startLen);
+        this->isFirstField = parentFirst;
+        return false;
+    }
 
-    if (isSigned) {
-        int64_t sVal;
-        interpretAsSigned(val, bitSize, sVal);
-        len = snprintf(temp, sizeof(temp), "%lld",
-                       static_cast<long long>(sVal));
+    return true;
+}
+
+bool JsonStream::writeIntValue(uint64_t val,
+                               uint8_t bitSize,
+                               bool isSigned) {
+    char* out = reserveOutput(MAX_INT_LENGTH);
+    if (out) return commitOutput(formatInteger(out, val, bitSize, isSigned));
+
+    char temp[MAX_INT_LENGTH];
+    char* end = formatInteger(temp, val, bitSize, isSigned);
+    return writeRaw(temp, static_cast<size_t>(end - temp));
+}
+
+bool JsonStream::writeRawField(const char* key,
+                                 const char* text,
+                                 size_t len) {
+    if (skipField()) return true;
+    if (this->isClosed || this->isArrayLevel || !key) return false;
+
+    const size_t keyLen = strlen(key);
+    char* out = reserveOutput(fieldPrefixSize(key, keyLen) + len);
+    if (!out) return false;
+
+    out = writeFieldPrefix(out, key, keyLen);
+    memcpy(out, text, len);
+    return commitOutput(out + len);
+}
+
+bool JsonStream::writeRealValue(double val, const char* format) {
+    if (!isfinite(val)) return writeRaw("null", 4);
+    if (this->fixedDigits != FULL_PRECISION)
+        return writeFixedValue(val, this->fixedDigits);
+
+    char temp[32];
+    int len = snprintf(temp, sizeof(temp), format, val);
+
+    if (len < 0 || len >= (int)sizeof(temp)) return false;
+    return writeRaw(temp, len);
+}
+
+bool JsonStream::writeFixedValue(double val, uint8_t fractionDigits) {
+    if (!isfinite(val)) return writeRaw("null", 4);
+
+    char* out = reserveOutput(MAX_FIXED_LENGTH);
+    if (out) {
+        char* end = formatFixed(out, val, fractionDigits);
+        if (end) return commitOutput(end);
     } else {
-        len = snprintf(temp, sizeof(temp), "%llu",
-                       static_cast<unsigned long long>(val));
+        char temp[MAX_FIXED_LENGTH];
+        char* end = formatFixed(temp, val, fractionDigits);
+        if (end) return writeRaw(temp, static_cast<size_t>(end - temp));
     }
 
-    if (len < 0 || len >= (int)sizeof(temp) ||
-        !writeRaw(temp, len)) {
-        this->buffer.setLength(startLen);
+    // Too large to scale exactly: printf rounding with the zeros trimmed the
+    // same way, and the exponent form once the integer part alone is too long
+    char temp[64];
+    const bool isPlain = fabs(val) < 1e21;
+    int len = isPlain ? snprintf(temp, sizeof(temp), "%.*f", fractionDigits, val)
+                      : snprintf(temp, sizeof(temp), "%.17g", val);
+
+    if (len < 0 || len >= (int)sizeof(temp)) return false;
+    if (isPlain && fractionDigits > 0) {
+        while (temp[len - 1] == '0') len--;
+        if (temp[len - 1] == '.') len--;
+    }
+    return writeRaw(temp, len);
+}
+
+bool JsonStream::writeValue(bool val) {
+    return val ? writeRaw("true", 4) : writeRaw("false", 5);
+}
+
+bool JsonStream::writeValue(float val) {
+    return writeRealValue(val, "%.9g");
+}
+
+bool JsonStream::writeValue(double val) {
+    return writeRealValue(val, "%.17g");
+}
+
+bool JsonStream::writeValue(const char* val) {
+    if (!val) return writeRaw("null", 4);
+    return writeQuoted(val, strlen(val));
+}
+
+bool JsonStream::writeValue(const std::string& val) {
+    return writeQuoted(val.data(), val.size());
+}
+
+bool JsonStream::writeValue(const JsonSerializable& obj) {
+    size_t startLen = this->buffer.getSize();
+
+    if (!this->buffer
+             .addByte(static_cast<uint8_t>('{')))
         return false;
+
+    // Save parent state
+    bool parentFirst = this->isFirstField;
+    bool parentClosed = this->isClosed;
+    bool parentArrayLevel = this->isArrayLevel;
+    const DirtyMask* parentFilter = this->fieldFilter;
+    const char* parentPatch = this->patchPath;
+
+    // Reset for the child (Child's first field needs no comma, nested
+    // objects of a patch or array are written whole, as plain objects)
+    this->isFirstField = true;
+    this->isClosed = false;
+    this->isArrayLevel = false;
+    this->fieldFilter = nullptr;
+    this->patchPath = nullptr;
+
+    bool success = obj.toJson(*this);
+
+    // Restore parent state
+    this->isFirstField = parentFirst;
+    this->isClosed = parentClosed;
+    this->isArrayLevel = parentArrayLevel;
+    this->fieldFilter = parentFilter;
+    this->patchPath = parentPatch;
+
+    if (!success) this->buffer.setLength(startLen);
+    return success;
+}
+
+bool JsonStream::writeQuoted(const char* str, size_t len) {
+    // Fast path: room for the worst-case escape of every byte
+    if (len < (static_cast<size_t>(-1) - 2) / MAX_ESCAPE_LENGTH) {
+        char* out = reserveOutput(len * MAX_ESCAPE_LENGTH + 2);
+        if (out) {
+            *out++ = '\"';
+            out = escapeInto(out, str, len);
+            *out++ = '\"';
+            return commitOutput(out);
+        }
     }
 
+    size_t startLen = this->buffer.getSize();
+
+    if (!this->buffer.addByte(static_cast<uint8_t>('\"')) ||
+        !writeEscaped(str, len) ||
+        !this->buffer.addByte(static_cast<uint8_t>('\"'))) {
+        this->buffer.setLength(startLen);
+        return false;
+    }
     return true;
 }
 
-bool JsonStream::writeRaw(const char* str, size_t len) {
-    if (!canWrite(len)) return false;
+bool JsonStream::writeSeparator(bool& isFirst) {
+    if (isFirst) {
+        isFirst = false;
+        return true;
+    }
+    return this->buffer.addByte(static_cast<uint8_t>(','));
+}
+
+bool JsonStream::writeMapKey(const std::string& key) {
+    return writeQuoted(key.data(), key.size()) &&
+           this->buffer.addByte(static_cast<uint8_t>(':'));
+}
+
+bool JsonStream::writeDescribed(const uint8_t* base, ByteStream* in,
+                                const MessageDescriptor& descriptor) {
+    const DirtyMask* parentFilter = this->fieldFilter;
+    const char* parentPatch = this->patchPath;
+    this->fieldFilter = nullptr;
+    this->patchPath = nullptr;
+
+    bool isFirst = true;
+    bool success = this->buffer.addByte(static_cast<uint8_t>('{')) &&
+                   writeDescribedFields(base, in, descriptor, isFirst) &&
+                   this->buffer.addByte(static_cast<uint8_t>('}'));
+
+    this->fieldFilter = parentFilter;
+    this->patchPath = parentPatch;
+    return success;
+}
+
+bool JsonStream::writeDescribedFields(const uint8_t* base, ByteStream* in,
+                                      const MessageDescriptor& descriptor,
+                                      bool& isFirst) {
+    const FieldDescriptor* field = descriptor.fields;
+    const FieldDescriptor* end = field + descriptor.fieldCount;
+
+    for (; field < end; field++) {
+        if (skipField()) continue;
+        if (!field->name) return false;
 
-    for(size_t i=0; i<len; i++) {
-        uint8_t byte = static_cast<uint8_t>(str[i]);
-        this->buffer.addByte(byte);
+        // Top-level fields of a JSON Patch each open an operation
+        if (this->patchPath) {
+            if (!startField(field->name)) return false;
+        } else if (!writeSeparator(isFirst) ||
+                   !writeQuoted(field->name, strlen(field->name)) ||
+                   !this->buffer.addByte(static_cast<uint8_t>(':'))) {
+            return false;
+        }
+
+        if (field->count == 1) {
+            if (!writeDescribedValue(*field, base, in, 0)) return false;
+            continue;
+        }
+
+        bool isFirstElement = true;
+        if (!this->buffer.addByte(static_cast<uint8_t>('['))) return false;
+        for (size_t i = 0; i < field->count; i++) {
+            if (!writeSeparator(isFirstElement) ||
+                !writeDescribedValue(*field, base, in, i)) return false;
+        }
+        if (!this->buffer.addByte(static_cast<uint8_t>(']'))) return false;
     }
     return true;
 }
 
-bool JsonStream::writeEscaped(const char* str) {
-    size_t startLen = this->buffer.getSize();
-    bool success = true;
-
-    while (*str) {
-        bool isDefault = false;
-    
-        switch (*str) {
-        case '\"': success = writeRaw("\\\"", 2); break;
-        case '\\': success = writeRaw("\\\\", 2); break;
-        case '\n': success = writeRaw("\\n", 2); break;
-        case '\t': success = writeRaw("\\t", 2); break;
-        case '\r': success = writeRaw("\\r", 2); break;
-        case '\b': success = writeRaw("\\b", 2); break;
-        case '\f': success = writeRaw("\\f", 2); break;
-        default: isDefault = true; break;
+bool JsonStream::writeDescribedValue(const FieldDescriptor& field,
+                                     const uint8_t* base, ByteStream* in,
+                                     size_t index) {
+    if (field.type == WireType::Message) {
+        const MessageDescriptor& nested = *field.message;
+        return writeDescribed(
+                   base ? base + field.offset + index * nested.structSize
+                        : nullptr,
+                   in, nested);
+    }
+
+    if (field.type == WireType::String) {
+        const char* str;
+        size_t len;
+
+        if (base) {
+            str = reinterpret_cast<const char*>(
+                      base + field.offset + index * field.capacity);
+            len = strnlen(str, field.capacity);
+        } else {
+            uint16_t wireLen;
+            if (!in->readUint16(wireLen)) return false;
+            len = wireLen;
+            str = reinterpret_cast<const char*>(in->consumeBytes(len));
+            if (!str) return false;
         }
+        if (len >= field.capacity) return false;
+        return writeQuoted(str, len);
+    }
 
-        if (isDefault && (unsigned char)*str < 0x20) {
-            static const char hex[] = "0123456789ABCDEF";
-            char esc[6] = {
-                '\\', 'u', '0', '0',
-                hex[((unsigned char)*str >> 4) & 0xF],
-                hex[(unsigned char)*str & 0xF]
-            };
-            success = writeRaw(esc, 6);
-        } else if (isDefault) {
-            success = this->buffer.addByte(*str);
+    // Fixed-size scalar: fetch its bytes in host order
+    const size_t size = wireTypeSize(field.type);
+    if (size == 0) return false;
+
+    uint8_t raw[8];
+    if (base) {
+        memcpy(raw, base + field.offset + index * size, size);
+    } else {
+        const uint8_t* src = in->consumeBytes(size);
+        if (!src) return false;
+
+        if (in->getEndianOrder() == getSystemEndianness()) {
+            memcpy(raw, src, size);
+        } else {
+            for (size_t i = 0; i < size; i++) raw[i] = src[size - 1 - i];
         }
+    }
 
-        str++;
-        if (!success) break;
+    switch (field.type) {
+    case WireType::Bool:
+        return writeValue(raw[0] != 0);
+    case WireType::Uint8:
+        return writeIntValue(raw[0], 8, false);
+    case WireType::Int8:
+        return writeIntValue(raw[0], 8, true);
+    case WireType::Uint16:
+    case WireType::Int16: {
+        uint16_t val;
+        memcpy(&val, raw, sizeof(val));
+        return writeIntValue(val, 16, field.type == WireType::Int16);
+    }
+    case WireType::Uint32:
+    case WireType::Int32: {
+        uint32_t val;
+        memcpy(&val, raw, sizeof(val));
+        return writeIntValue(val, 32, field.type == WireType::Int32);
+    }
+    case WireType::Uint64:
+    case WireType::Int64: {
+        uint64_t val;
+        memcpy(&val, raw, sizeof(val));
+        return writeIntValue(val, 64, field.type == WireType::Int64);
+    }
+    case WireType::Float: {
+        float val;
+        memcpy(&val, raw, sizeof(val));
+        return writeValue(val);
+    }
+    case WireType::Double: {
+        double val;
+        memcpy(&val, raw, sizeof(val));
+        return writeValue(val);
+    }
+    default:
+        return false;
     }
+}
 
-    if (!success) this->buffer.setLength(startLen);
-    return success;
+bool JsonStream::writeRaw(const char* str, size_t len) {
+    if (!canWrite(len)) return false;
+
+    size_t startLen = this->buffer.getSize();
+    memcpy(this->buffer.getRawBytes() + startLen, str, len);
+    return this->buffer.setLength(startLen + len);
 }
 
+bool JsonStream::writeEscaped(const char* str, size_t len) {
+    size_t startLen = this->buffer.getSize();
+    const char* end = str + len;
 
-bool JsonStream::startField(const char* key) {
-    if (this->isClosed || !key) return false;
+    // Clean runs are copied in bulk, escapes one at a time
+    while (str < end) {
+        const char* run = json::findEscapable(str, end);
+        char esc[MAX_ESCAPE_LENGTH];
 
-    if (!this->isFirstField) {
-        if (!this->buffer
-                 .addByte(static_cast<uint8_t>(',')))
+        if (!writeRaw(str, static_cast<size_t>(run - str)) ||
+            (run < end &&
+             !writeRaw(esc, escapeChar(static_cast<unsigned char>(*run), esc)))) {
+            this->buffer.setLength(startLen);
             return false;
+        }
+
+        if (run == end) break;
+        str = run + 1;
+    }
+    return true;
+}
+
+char* JsonStream::reserveOutput(size_t maxLen) {
+    if (!canWrite(maxLen)) return nullptr;
+
+    uint8_t* raw = this->buffer.getRawBytes();
+    if (!raw) return nullptr;
+    return reinterpret_cast<char*>(raw + this->buffer.getSize());
+}
+
+bool JsonStream::commitOutput(const char* end) {
+    const char* base = reinterpret_cast<const char*>(this->buffer.getRawBytes());
+    return this->buffer.setLength(static_cast<size_t>(end - base));
+}
+
+size_t JsonStream::fieldPrefixSize(const char* key, size_t keyLen) const {
+    if (this->patchPath) {
+        // `},{"op":"add","path":"<base>/<key>","value":`, where `~` and `/`
+        // in the key take two characters each
+        size_t tokenLen = keyLen;
+        for (size_t i = 0; i < keyLen; i++) {
+            if (key[i] == '~' || key[i] == '/') tokenLen++;
+        }
+        return (this->isPatchOpOpen ? 1 : 0) + (this->isFirstField ? 0 : 1) +
+               PATCH_OP_LENGTH + this->patchPathLen + 1 + tokenLen +
+               PATCH_VALUE_LENGTH;
     }
 
+    // `,"key":`, without the comma for the first field
+    return keyLen + (this->isFirstField ? 3 : 4);
+}
+
+char* JsonStream::writeFieldPrefix(char* out, const char* key, size_t keyLen) {
+    if (this->patchPath) return writePatchPrefix(out, key, keyLen);
+
+    if (!this->isFirstField) *out++ = ',';
     this->isFirstField = false;
 
-    if (!this->buffer
-             .addByte(static_cast<uint8_t>('\"'))) return false;
+    *out++ = '\"';
+    memcpy(out, key, keyLen);
+    out += keyLen;
+    *out++ = '\"';
+    *out++ = ':';
+    return out;
+}
+
+char* JsonStream::writePatchPrefix(char* out, const char* key, size_t keyLen) {
+    // Closes the previous operation, whose value is complete by now
+    if (this->isPatchOpOpen) *out++ = '}';
+    if (!this->isFirstField) *out++ = ',';
+    this->isFirstField = false;
+    this->isPatchOpOpen = true;
+
+    memcpy(out, PATCH_OP, PATCH_OP_LENGTH);
+    out += PATCH_OP_LENGTH;
+    memcpy(out, this->patchPath, this->patchPathLen);
+    out += this->patchPathLen;
+    *out++ = '/';
+
+    // RFC 6901 reference token
+    for (size_t i = 0; i < keyLen; i++) {
+        if (key[i] == '~') {
+            *out++ = '~';
+            *out++ = '0';
+        } else if (key[i] == '/') {
+            *out++ = '~';
+            *out++ = '1';
+        } else {
+            *out++ = key[i];
+        }
+    }
+
+    memcpy(out, PATCH_VALUE, PATCH_VALUE_LENGTH);
+    return out + PATCH_VALUE_LENGTH;
+}
+
+bool JsonStream::skipField() {
+    if (!this->fieldFilter) return false;
+
+    // Fields past the mask are untracked and never emitted
+    const uint8_t index = this->fieldIndex;
+    if (index < DirtyMask::MAX_FIELDS) this->fieldIndex++;
+    return !this->fieldFilter->isDirty(index);
+}
+
+bool JsonStream::startField(const char* key) {
+    if (this->isClosed || this->isArrayLevel || !key) return false;
+
+    const size_t keyLen = strlen(key);
+    char* out = reserveOutput(fieldPrefixSize(key, keyLen));
+    if (!out) return false;
 
-    if (!writeRaw(key, strlen(key))) return false;
-    return writeRaw("\":", 2);
+    return commitOutput(writeFieldPrefix(out, key, keyLen));
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "JsonValidator.h"
+
+#include <string.h>
+
+namespace serdelite {
+namespace json {
+
+namespace {
+
+class Validator {
+public:
+    Validator(const char* text, size_t len)
+        : p(reinterpret_cast<const unsigned char*>(text)),
+          end(reinterpret_cast<const unsigned char*>(text) + len)
+    {}
+
+    bool validateDocument() {
+        skipWhitespace();
+        if (!value(0)) return false;
+        skipWhitespace();
+        return p == end;
+    }
+
+private:
+    const unsigned char* p;
+    const unsigned char* end;
+
+    void skipWhitespace() {
+        while (p < end &&
+               (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    }
+
+    bool literal(const char* word, size_t len) {
+        if (static_cast<size_t>(end - p) < len || memcmp(p, word, len) != 0)
+            return false;
+        p += len;
+        return true;
+    }
+
+    bool digits() {
+        const unsigned char* start = p;
+        while (p < end && *p >= '0' && *p <= '9') p++;
+        return p > start;
+    }
+
+    bool number() {
+        if (p < end && *p == '-') p++;
+
+        if (p < end && *p == '0') {
+            p++;
+        } else if (!digits()) {
+            return false;
+        }
+
+        if (p < end && *p == '.') {
+            p++;
+            if (!digits()) return false;
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            p++;
+            if (p < end && (*p == '+' || *p == '-')) p++;
+            if (!digits()) return false;
+        }
+        return true;
+    }
+
+    bool isHex(unsigned char c) const {
+        return (c >= '0' && c <= '9') ||
+               (c >= 'a' && c <= 'f') ||
+               (c >= 'A' && c <= 'F');
+    }
+
+    // Accepts one well-formed UTF-8 sequence starting with a non-ASCII byte
+    bool utf8Sequence() {
+        const unsigned char lead = *p;
+        size_t extra;
+        unsigned char min = 0x80, max = 0xBF;
+
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            extra = 1;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            extra = 2;
+            if (lead == 0xE0) min = 0xA0;       // overlong
+            if (lead == 0xED) max = 0x9F;       // surrogates
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            extra = 3;
+            if (lead == 0xF0) min = 0x90;       // overlong
+            if (lead == 0xF4) max = 0x8F;       // above U+10FFFF
+        } else {
+            return false;
+        }
+
+        if (static_cast<size_t>(end - p) <= extra) return false;
+        if (p[1] < min || p[1] > max) return false;
+        for (size_t i = 2; i <= extra; i++) {
+            if (p[i] < 0x80 || p[i] > 0xBF) return false;
+        }
+        p += extra + 1;
+        return true;
+    }
+
+    bool string() {
+        p++; // opening quote
+
+        while (p < end) {
+            const unsigned char c = *p;
+
+            if (c == '"') {
+                p++;
+                return true;
+            }
+            if (c < 0x20) return false;
+
+            if (c == '\\') {
+                if (++p >= end) return false;
+                switch (*p) {
+                case '"': case '\\': case '/':
+                case 'b': case 'f': case 'n': case 'r': case 't':
+                    p++;
+                    break;
+                case 'u':
+                    if (end - p < 5 ||
+                        !isHex(p[1]) || !isHex(p[2]) ||
+                        !isHex(p[3]) || !isHex(p[4])) return false;
+                    p += 5;
+                    break;
+                default:
+                    return false;
+                }
+            } else if (c >= 0x80) {
+                if (!utf8Sequence()) return false;
+            } else {
+                p++;
+            }
+        }
+        return false;
+    }
+
+    bool array(size_t depth) {
+        p++; // '['
+        skipWhitespace();
+        if (p < end && *p == ']') {
+            p++;
+            return true;
+        }
+
+        while (true) {
+            if (!value(depth + 1)) return false;
+            skipWhitespace();
+            if (p >= end) return false;
+            if (*p == ']') {
+                p++;
+                return true;
+            }
+            if (*p++ != ',') return false;
+            skipWhitespace();
+        }
+    }
+
+    bool object(size_t depth) {
+        p++; // '{'
+        skipWhitespace();
+        if (p < end && *p == '}') {
+            p++;
+            return true;
+        }
+
+        while (true) {
+            if (p >= end || *p != '"' || !string()) return false;
+            skipWhitespace();
+            if (p >= end || *p++ != ':') return false;
+            skipWhitespace();
+            if (!value(depth + 1)) return false;
+            skipWhitespace();
+            if (p >= end) return false;
+            if (*p == '}') {
+                p++;
+                return true;
+            }
+            if (*p++ != ',') return false;
+            skipWhitespace();
+        }
+    }
+
+    bool value(size_t depth) {
+        if (p >= end || depth >= MAX_DEPTH) return false;
+
+        switch (*p) {
+        case '{': return object(depth);
+        case '[': return array(depth);
+        case '"': return string();
+        case 't': return literal("true", 4);
+        case 'f': return literal("false", 5);
+        case 'n': return literal("null", 4);
+        default:  return number();
+        }
+    }
+};
+
+} // namespace
+
+bool isValidValue(const char* text, size_t len) {
+    if (!text) return false;
+
+    Validator validator(text, len);
+    return validator.validateDocument();
+}
+
+} // namespace json
+} // namespace serdelite
@@ -0,0 +1,41 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file JsonValidator.h
+ * @brief Internal strict RFC 8259 syntax checker.
+ *
+ * @note This header is private to the library sources and is not installed.
+ */
+
+#ifndef SERDELITE_JSONVALIDATOR_H
+#define SERDELITE_JSONVALIDATOR_H
+
+#include <stddef.h>
+
+namespace serdelite {
+namespace json {
+
+/** @brief Maximum nesting depth of arrays and objects that is accepted. */
+static const size_t MAX_DEPTH = 512;
+
+/**
+ * @brief Checks that `text` holds exactly one JSON value, optionally
+ * 		  surrounded by whitespace.
+ * @param text The text to check (need not be NUL-terminated).
+ * @param len Number of characters in `text`.
+ * @return Returns `true` if the text is well-formed JSON with valid UTF-8
+ * 		   strings, `false` otherwise.
+ */
+bool isValidValue(const char* text, size_t len);
+
+} // namespace json
+} // namespace serdelite
+
+#endif
@@ -0,0 +1,447 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "serdelite/Migration.h"
+#include "serdelite/ByteBuffer.h"
+
+#include <string.h>
+
+namespace serdelite {
+
+static bool namesEqual(const char* a, const char* b) {
+    return a && b && strcmp(a, b) == 0;
+}
+
+static const FieldDescriptor* findField(const MessageDescriptor& desc,
+                                        const char* name,
+                                        size_t& index) {
+    for (size_t i = 0; i < desc.fieldCount; i++) {
+        if (namesEqual(desc.fields[i].name, name)) {
+            index = i;
+            return &desc.fields[i];
+        }
+    }
+    return nullptr;
+}
+
+static const MigrationRule* findRule(const MigrationRule* rules,
+                                     size_t ruleCount,
+                                     MigrationOp op,
+                                     const char* name) {
+    for (size_t i = 0; i < ruleCount; i++) {
+        if (rules[i].op == op && namesEqual(rules[i].field, name))
+            return &rules[i];
+    }
+    return nullptr;
+}
+
+static bool sameLayout(const MessageDescriptor& a, const MessageDescriptor& b);
+
+// Compares the wire encoding only; names and struct offsets do not matter
+static bool sameLayout(const FieldDescriptor& a, const FieldDescriptor& b) {
+    if (a.type != b.type || a.count != b.count) return false;
+    if (a.type == WireType::String) return a.capacity == b.capacity;
+    if (a.type == WireType::Message)
+        return a.message == b.message || sameLayout(*a.message, *b.message);
+    return true;
+}
+
+static bool sameLayout(const MessageDescriptor& a, const MessageDescriptor& b) {
+    if (a.fieldCount != b.fieldCount) return false;
+    for (size_t i = 0; i < a.fieldCount; i++) {
+        if (!sameLayout(a.fields[i], b.fields[i])) return false;
+    }
+    return true;
+}
+
+/*
+ * Returns the encoded size of a field if it does not depend on the data,
+ * 0 if it contains strings.
+ */
+static size_t fixedEncodedSize(const FieldDescriptor& field) {
+    if (field.type == WireType::String) return 0;
+
+    size_t elemSize = wireTypeSize(field.type);
+    if (field.type == WireType::Message) {
+        elemSize = 0;
+        for (size_t i = 0; i < field.message->fieldCount; i++) {
+            size_t size = fixedEncodedSize(field.message->fields[i]);
+            if (size == 0) return 0;
+            elemSize += size;
+        }
+    }
+    return elemSize * field.count;
+}
+
+// Encoded size of a field whose strings are all empty
+static size_t zeroEncodedSize(const FieldDescriptor& field) {
+    if (field.type == WireType::String) return sizeof(uint16_t) * field.count;
+
+    if (field.type == WireType::Message) {
+        size_t size = 0;
+        for (size_t i = 0; i < field.message->fieldCount; i++) {
+            size += zeroEncodedSize(field.message->fields[i]);
+        }
+        return size * field.count;
+    }
+    return wireTypeSize(field.type) * field.count;
+}
+
+static bool isSignedType(WireType type) {
+    return type == WireType::Int8 || type == WireType::Int16 ||
+           type == WireType::Int32 || type == WireType::Int64;
+}
+
+static bool isUnsignedType(WireType type) {
+    return type == WireType::Uint8 || type == WireType::Uint16 ||
+           type == WireType::Uint32 || type == WireType::Uint64;
+}
+
+// Only conversions that preserve every value are accepted
+static bool canWiden(WireType from, WireType to) {
+    const size_t fromSize = wireTypeSize(from);
+    const size_t toSize = wireTypeSize(to);
+
+    if (from == WireType::Float) return to == WireType::Double;
+
+    if (to == WireType::Double)
+        return (isSignedType(from) || isUnsignedType(from)) && fromSize <= 4;
+
+    if (isUnsignedType(from))
+        return (isUnsignedType(to) && toSize > fromSize) ||
+               (isSignedType(to) && toSize > fromSize);
+
+    if (isSignedType(from))
+        return isSignedType(to) && toSize > fromSize;
+
+    return false;
+}
+
+static uint64_t loadWire(const uint8_t* src, size_t size, bool isBig) {
+    uint64_t val = 0;
+    for (size_t i = 0; i < size; i++) {
+        const size_t shift = isBig ? (size - 1 - i) * 8 : i * 8;
+        val |= static_cast<uint64_t>(src[i]) << shift;
+    }
+    return val;
+}
+
+static void storeWire(uint8_t* dst, uint64_t val, size_t size, bool isBig) {
+    for (size_t i = 0; i < size; i++) {
+        const size_t shift = isBig ? (size - 1 - i) * 8 : i * 8;
+        dst[i] = static_cast<uint8_t>(val >> shift);
+    }
+}
+
+static void widenValue(const uint8_t* src, WireType from,
+                       uint8_t* dst, WireType to, bool isBig) {
+    const size_t fromSize = wireTypeSize(from);
+    const size_t toSize = wireTypeSize(to);
+    const uint64_t raw = loadWire(src, fromSize, isBig);
+
+    uint64_t out;
+    if (from == WireType::Float) {
+        uint32_t bits = static_cast<uint32_t>(raw);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        double d = f;
+        memcpy(&out, &d, sizeof(out));
+    } else if (isSignedType(from)) {
+        int64_t sVal = 0;
+        interpretAsSigned(raw, static_cast<uint8_t>(fromSize * 8), sVal);
+        if (to == WireType::Double) {
+            double d = static_cast<double>(sVal);
+            memcpy(&out, &d, sizeof(out));
+        } else {
+            out = static_cast<uint64_t>(sVal);
+        }
+    } else if (to == WireType::Double) {
+        double d = static_cast<double>(raw);
+        memcpy(&out, &d, sizeof(out));
+    } else {
+        out = raw;
+    }
+
+    storeWire(dst, out, toSize, isBig);
+}
+
+// Consumes one encoded field whose size depends on its strings
+static bool skipEncoded(ByteStream& in, const FieldDescriptor& field) {
+    for (size_t i = 0; i < field.count; i++) {
+        if (field.type == WireType::String) {
+            uint16_t len;
+            if (!in.readUint16(len) || !in.consumeBytes(len)) return false;
+        } else if (field.type == WireType::Message) {
+            const MessageDescriptor& nested = *field.message;
+            for (size_t j = 0; j < nested.fieldCount; j++) {
+                if (!skipEncoded(in, nested.fields[j])) return false;
+            }
+        } else {
+            return in.consumeBytes(wireTypeSize(field.type) *
+                                   (field.count - i)) != nullptr;
+        }
+    }
+    return true;
+}
+
+MigrationPlan::MigrationPlan()
+    : source(nullptr),
+      stepCount(0),
+      defaultsLength(0),
+      order(Endian::Big),
+      compiled(false),
+      fromVersion(0),
+      toVersion(0)
+{}
+
+bool MigrationPlan::compile(const MessageDescriptor& from,
+                            const MessageDescriptor& to,
+                            const MigrationRule* rules,
+                            size_t ruleCount,
+                            Endian recordOrder) {
+    this->compiled = false;
+    this->stepCount = 0;
+    this->defaultsLength = 0;
+
+    if (from.fieldCount > MAX_FIELDS || (ruleCount > 0 && !rules))
+        return false;
+
+    bool used[MAX_FIELDS] = { false };
+
+    this->source = &from;
+    this->order = recordOrder;
+
+    for (size_t i = 0; i < from.fieldCount; i++) {
+        this->fieldSizes[i] =
+            static_cast<uint32_t>(fixedEncodedSize(from.fields[i]));
+    }
+
+    for (size_t j = 0; j < to.fieldCount; j++) {
+        const FieldDescriptor& field = to.fields[j];
+
+        const MigrationRule* added = findRule(rules, ruleCount,
+                                              MigrationOp::AddField,
+                                              field.name);
+        if (added) {
+            if (!addDefault(field, added->defaultValue)) return false;
+            continue;
+        }
+
+        const MigrationRule* renamed = findRule(rules, ruleCount,
+                                                MigrationOp::RenameField,
+                                                field.name);
+        size_t index = 0;
+        const FieldDescriptor* old = findField(from,
+                                               renamed ? renamed->oldName
+                                                       : field.name,
+                                               index);
+        if (!old || used[index]) return false;
+        used[index] = true;
+
+        Step step;
+        memset(&step, 0, sizeof(step));
+        step.first = static_cast<uint16_t>(index);
+        step.last = static_cast<uint16_t>(index + 1);
+
+        if (!sameLayout(*old, field)) {
+            if (!findRule(rules, ruleCount, MigrationOp::WidenField,
+                          field.name) ||
+                old->count != field.count) return false;
+
+            if (old->type == WireType::String &&
+                field.type == WireType::String) {
+                // Strings keep their encoding; only the member grew
+                if (field.capacity < old->capacity) return false;
+            } else {
+                if (!canWiden(old->type, field.type)) return false;
+                step.op = StepOp::Widen;
+                step.fromType = old->type;
+                step.toType = field.type;
+                step.count = field.count;
+                if (!addStep(step)) return false;
+                continue;
+            }
+        }
+
+        step.op = StepOp::Copy;
+        if (!addStep(step)) return false;
+    }
+
+    // Every old field that is not carried over must be declared as dropped
+    for (size_t i = 0; i < from.fieldCount; i++) {
+        if (!used[i] && !findRule(rules, ruleCount, MigrationOp::DropField,
+                                  from.fields[i].name)) return false;
+    }
+
+    this->fromVersion = from.version;
+    this->toVersion = to.version;
+    this->compiled = true;
+    return true;
+}
+
+bool MigrationPlan::apply(ByteStream& in, ByteStream& out) const {
+    if (!this->compiled ||
+        in.getEndianOrder() != this->order ||
+        out.getEndianOrder() != this->order) return false;
+
+    const size_t startPos = in.getReadCursor();
+    const MessageDescriptor& from = *this->source;
+
+    // Locate the old fields; fixed-size runs are consumed in one go
+    size_t fieldPos[MAX_FIELDS + 1];
+    const uint8_t* record = in.consumeBytes(0);
+    size_t offset = 0;
+    size_t pending = 0;
+    bool success = record != nullptr;
+
+    for (size_t i = 0; success && i < from.fieldCount; i++) {
+        fieldPos[i] = offset;
+
+        if (this->fieldSizes[i] != 0) {
+            offset += this->fieldSizes[i];
+            pending += this->fieldSizes[i];
+            continue;
+        }
+
+        if (pending > 0) {
+            success = in.consumeBytes(pending) != nullptr;
+            pending = 0;
+        }
+
+        const size_t before = in.getReadCursor();
+        success = success && skipEncoded(in, from.fields[i]);
+        offset += in.getReadCursor() - before;
+    }
+    fieldPos[from.fieldCount] = offset;
+    if (success && pending > 0) success = in.consumeBytes(pending) != nullptr;
+
+    // Size the output so it can be reserved with a single check
+    size_t total = 0;
+    for (size_t s = 0; success && s < this->stepCount; s++) {
+        const Step& step = this->steps[s];
+        switch (step.op) {
+        case StepOp::Copy:
+            total += fieldPos[step.last] - fieldPos[step.first];
+            break;
+        case StepOp::Insert:
+            total += step.length;
+            break;
+        case StepOp::Widen:
+            total += wireTypeSize(step.toType) * step.count;
+            break;
+        }
+    }
+
+    uint8_t* dst = success ? out.reserveBytes(total) : nullptr;
+    if (!dst) {
+        in.seekReadCursor(startPos);
+        return false;
+    }
+
+    const bool isBig = this->order == Endian::Big;
+    for (size_t s = 0; s < this->stepCount; s++) {
+        const Step& step = this->steps[s];
+        switch (step.op) {
+        case StepOp::Copy: {
+            const size_t len = fieldPos[step.last] - fieldPos[step.first];
+            memcpy(dst, record + fieldPos[step.first], len);
+            dst += len;
+            break;
+        }
+        case StepOp::Insert:
+            memcpy(dst, this->defaults + step.offset, step.length);
+            dst += step.length;
+            break;
+        case StepOp::Widen: {
+            const uint8_t* src = record + fieldPos[step.first];
+            const size_t fromSize = wireTypeSize(step.fromType);
+            const size_t toSize = wireTypeSize(step.toType);
+            for (size_t i = 0; i < step.count; i++) {
+                widenValue(src, step.fromType, dst, step.toType, isBig);
+                src += fromSize;
+                dst += toSize;
+            }
+            break;
+        }
+        }
+    }
+    return true;
+}
+
+bool MigrationPlan::isCompiled() const {
+    return this->compiled;
+}
+
+size_t MigrationPlan::getStepCount() const {
+    return this->stepCount;
+}
+
+uint16_t MigrationPlan::getFromVersion() const {
+    return this->fromVersion;
+}
+
+uint16_t MigrationPlan::getToVersion() const {
+    return this->toVersion;
+}
+
+bool MigrationPlan::addStep(const Step& step) {
+    if (this->stepCount > 0) {
+        Step& prev = this->steps[this->stepCount - 1];
+
+        if (prev.op == StepOp::Copy && step.op == StepOp::Copy &&
+            prev.last == step.first) {
+            prev.last = step.last;
+            return true;
+        }
+        if (prev.op == StepOp::Insert && step.op == StepOp::Insert &&
+            prev.offset + prev.length == step.offset) {
+            prev.length += step.length;
+            return true;
+        }
+    }
+
+    if (this->stepCount >= MAX_STEPS) return false;
+    this->steps[this->stepCount++] = step;
+    return true;
+}
+
+bool MigrationPlan::addDefault(const FieldDescriptor& field,
+                               const void* value) {
+    uint8_t* pool = this->defaults + this->defaultsLength;
+    const size_t space = MAX_DEFAULT_BYTES - this->defaultsLength;
+    size_t length;
+
+    if (!value) {
+        length = zeroEncodedSize(field);
+        if (length > space) return false;
+        memset(pool, 0, length);
+    } else {
+        // Encode the default like a one-field message placed at offset 0
+        FieldDescriptor member = field;
+        member.offset = 0;
+        const MessageDescriptor wrapper = { field.name, &member, 1, 0, 0 };
+
+        ByteBuffer buffer(pool, space, this->order);
+        ByteStream stream(buffer);
+        if (!stream.writeMessage(value, wrapper)) return false;
+        length = buffer.getSize();
+    }
+
+    Step step;
+    memset(&step, 0, sizeof(step));
+    step.op = StepOp::Insert;
+    step.offset = static_cast<uint32_t>(this->defaultsLength);
+    step.length = static_cast<uint32_t>(length);
+    if (!addStep(step)) return false;
+
+    this->defaultsLength += length;
+    return true;
+}
+
+} // namespace serdelite
@@ -0,0 +1,58 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include "serdelite/Optional.h"
+
+namespace serdelite {
+
+PresenceMask::PresenceMask(uint8_t _fieldCount)
+    : bits(0),
+      fieldCount(_fieldCount > MAX_FIELDS ? MAX_FIELDS : _fieldCount)
+{
+
+}
+
+bool PresenceMask::set(uint8_t index, bool present) {
+    if (index >= this->fieldCount) return false;
+
+    if (present) this->bits |= (1ULL << index);
+    else this->bits &= ~(1ULL << index);
+    return true;
+}
+
+bool PresenceMask::has(uint8_t index) const {
+    if (index >= this->fieldCount) return false;
+    return (this->bits >> index) & 1;
+}
+
+void PresenceMask::clear() {
+    this->bits = 0;
+}
+
+bool PresenceMask::setBits(uint64_t newBits) {
+    if (this->fieldCount < MAX_FIELDS &&
+        (newBits >> this->fieldCount) != 0) return false;
+
+    this->bits = newBits;
+    return true;
+}
+
+uint64_t PresenceMask::getBits() const {
+    return this->bits;
+}
+
+uint8_t PresenceMask::getFieldCount() const {
+    return this->fieldCount;
+}
+
+size_t PresenceMask::byteSize() const {
+    return (static_cast<size_t>(this->fieldCount) + 7) / 8;
+}
+
+}
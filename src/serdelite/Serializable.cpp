@@ -9,6 +9,7 @@
 
 #include "serdelite/Serializable.h"
 #include "serdelite/JsonStream.h"
+#include "serdelite/JsonReader.h"
 
 namespace serdelite {
 
@@ -17,4 +18,15 @@ bool JsonSerializable::toJson(JsonStream& stream) const {
     return stream.close();
 }
 
+bool JsonSerializable::fromJson(JsonReader& reader) {
+    return reader.beginObject() &&
+           deserializeFromJson(reader) &&
+           reader.endObject();
+}
+
+bool JsonSerializable::deserializeFromJson(JsonReader& reader) {
+    (void)reader;
+    return false;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file Simd.h
+ * @brief Internal compile-time detection of the SIMD instruction sets that the
+ *        library kernels may use.
+ *
+ * Kernels are selected at compile time from the flags the library is built
+ * with (e.g. `-msse4.1`, `-mavx2` or `-march=native`). Every kernel has a
+ * scalar fallback, so the library builds on any target. Define
+ * `SERDELITE_NO_SIMD` to force the scalar paths.
+ *
+ * @note This header is private to the library sources and is not installed.
+ */
+
+#ifndef SERDELITE_SIMD_H
+#define SERDELITE_SIMD_H
+
+#if !defined(SERDELITE_NO_SIMD)
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SERDELITE_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+    #define SERDELITE_SSSE3 1
+    #include <tmmintrin.h>
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+    #define SERDELITE_SSE41 1
+    #include <smmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+    #define SERDELITE_AVX2 1
+    #include <immintrin.h>
+#endif
+
+#endif // SERDELITE_NO_SIMD
+
+#endif
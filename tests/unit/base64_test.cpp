@@ -0,0 +1,167 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+static const char STANDARD[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char URL_SAFE[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// RFC 4648 encoding, one group at a time
+static string referenceBase64(const uint8_t* bytes, size_t count,
+                              bool urlSafe, bool padded) {
+    const char* alphabet = urlSafe ? URL_SAFE : STANDARD;
+    string text;
+
+    for (size_t i = 0; i < count; i += 3) {
+        const size_t left = count - i;
+        uint32_t group = static_cast<uint32_t>(bytes[i]) << 16;
+        if (left > 1) group |= static_cast<uint32_t>(bytes[i + 1]) << 8;
+        if (left > 2) group |= bytes[i + 2];
+
+        text += alphabet[group >> 18];
+        text += alphabet[(group >> 12) & 63];
+        if (left > 1) text += alphabet[(group >> 6) & 63];
+        else if (padded) text += '=';
+        if (left > 2) text += alphabet[group & 63];
+        else if (padded) text += '=';
+    }
+    return text;
+}
+
+static Base64Alphabet alphabetOf(bool urlSafe) {
+    return urlSafe ? Base64Alphabet::UrlSafe : Base64Alphabet::Standard;
+}
+
+static void testRoundTrip(test::Random& rng) {
+    uint8_t mem[512], out[512];
+    vector<char> text(1024);
+    size_t errorIndex;
+
+    // Every length up to several 24-byte AVX2 encoding steps
+    for (size_t count = 0; count <= 200; count++)
+    for (int urlSafe = 0; urlSafe < 2; urlSafe++)
+    for (int padded = 0; padded < 2; padded++) {
+        ByteBuffer buffer(mem, sizeof(mem));
+        for (size_t i = 0; i < count; i++) buffer.addByte(rng.byte());
+
+        const Base64Alphabet alphabet = alphabetOf(urlSafe != 0);
+        const string expected = referenceBase64(mem, count, urlSafe != 0,
+                                                padded != 0);
+
+        CHECK(buffer.getBase64Length(padded != 0) == expected.size());
+        CHECK(buffer.toBase64(text.data(), expected.size() + 1, alphabet,
+                              padded != 0));
+        CHECK(expected == text.data());
+        CHECK(!buffer.toBase64(text.data(), expected.size(), alphabet,
+                               padded != 0));
+
+        ByteBuffer decoded(out, sizeof(out));
+        CHECK(decoded.fromBase64(expected.c_str(), errorIndex, alphabet,
+                                 padded != 0));
+        CHECK(errorIndex == expected.size());
+        CHECK(decoded.getSize() == count);
+        CHECK(count == 0 || memcmp(out, mem, count) == 0);
+    }
+}
+
+static void testInvalidCharacters(test::Random& rng) {
+    uint8_t mem[512], out[512];
+    size_t errorIndex;
+
+    for (size_t count = 1; count <= 200; count++)
+    for (int urlSafe = 0; urlSafe < 2; urlSafe++) {
+        for (size_t i = 0; i < count; i++) mem[i] = rng.byte();
+        string text = referenceBase64(mem, count, urlSafe != 0, true);
+
+        // Outside both alphabets, or from the other alphabet only
+        const char foreign[] = { '!', '*', '.', '~', ' ', '\n', '\x80',
+                                 urlSafe ? '+' : '-', urlSafe ? '/' : '_' };
+
+        // Stay clear of the padding, which has its own checks below
+        size_t body = text.size();
+        while (body > 0 && text[body - 1] == '=') body--;
+        const size_t pos = rng.below(body);
+        text[pos] = foreign[rng.below(sizeof(foreign))];
+
+        ByteBuffer rejected(out, sizeof(out));
+        CHECK(rejected.addByte(0xAA));
+        CHECK(!rejected.fromBase64(text.c_str(), errorIndex,
+                                   alphabetOf(urlSafe != 0)));
+        CHECK(errorIndex == pos);
+        CHECK(rejected.getSize() == 1);
+    }
+}
+
+static void testInvalidFraming() {
+    uint8_t out[64];
+    ByteBuffer buffer(out, sizeof(out));
+    size_t errorIndex;
+
+    CHECK(buffer.fromBase64("QQ=="));
+    CHECK(buffer.fromBase64("QUI="));
+    CHECK(buffer.fromBase64("QQ", Base64Alphabet::Standard, false));
+    CHECK(buffer.getSize() == 4);
+
+    // Unused bits of the last character must be zero
+    CHECK(!buffer.fromBase64("QR==", errorIndex));
+    CHECK(errorIndex == 1);
+    CHECK(!buffer.fromBase64("QUJ=", errorIndex));
+    CHECK(errorIndex == 2);
+
+    // Padding required, forbidden, misplaced or too long
+    CHECK(!buffer.fromBase64("QQ"));
+    CHECK(!buffer.fromBase64("QQ==", Base64Alphabet::Standard, false));
+    CHECK(!buffer.fromBase64("Q==="));
+    CHECK(!buffer.fromBase64("QQ=A"));
+    CHECK(!buffer.fromBase64("QQ==QQ=="));
+    CHECK(!buffer.fromBase64("Q"));
+    CHECK(!buffer.fromBase64("Q", Base64Alphabet::Standard, false));
+    CHECK(buffer.getSize() == 4);
+
+    // One byte short of room
+    uint8_t small[2];
+    ByteBuffer smallBuffer(small, sizeof(small));
+    CHECK(!smallBuffer.fromBase64("QUJD"));
+    CHECK(smallBuffer.getSize() == 0);
+}
+
+static void testErasesFailedDecode() {
+    uint8_t mem[96] = { 0 };
+    ByteBuffer buffer(mem, sizeof(mem), Endian::Big, ZeroPolicy::WrittenPrefix);
+
+    // Valid groups for 60 bytes, then a bad character in the last one
+    string text(80, 'Q');
+    text[78] = '*';
+    CHECK(!buffer.fromBase64(text.c_str()));
+    buffer.erase();
+
+    bool isZero = true;
+    for (size_t i = 0; i < sizeof(mem); i++) isZero = isZero && mem[i] == 0;
+    CHECK(isZero);
+}
+
+int main() {
+    test::Random rng(122);
+
+    testRoundTrip(rng);
+    testInvalidCharacters(rng);
+    testInvalidFraming();
+    testErasesFailedDecode();
+
+    return test::finish("base64");
+}
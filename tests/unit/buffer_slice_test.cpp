@@ -0,0 +1,168 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+static bool isSame(const ByteBuffer& view, const uint8_t* bytes, size_t len) {
+    return view.getSize() == len && view.getCapacity() == len &&
+           view.getRawBytes() == bytes;
+}
+
+// Every range of a small buffer, through the writable and the const overload
+static void testRanges() {
+    uint8_t mem[32];
+    ByteBuffer buffer(mem, sizeof(mem), Endian::Little);
+    for (uint8_t i = 0; i < 20; i++) buffer.addByte(i);
+    const ByteBuffer& constBuffer = buffer;
+
+    uint8_t other[4];
+    ByteBuffer untouched(other, sizeof(other));
+
+    for (size_t offset = 0; offset <= 22; offset++)
+    for (size_t len = 0; len <= 22; len++) {
+        const bool isInRange = offset + len <= buffer.getSize();
+
+        ByteBuffer view = untouched;
+        CHECK(buffer.slice(offset, len, view) == isInRange);
+        ByteBuffer constView = untouched;
+        CHECK(constBuffer.slice(offset, len, constView) == isInRange);
+
+        if (isInRange) {
+            CHECK(isSame(view, mem + offset, len));
+            CHECK(isSame(constView, mem + offset, len));
+            CHECK(view.getEndianOrder() == Endian::Little);
+            CHECK(view.getZeroPolicy() == ZeroPolicy::None);
+        } else {
+            // Out of range leaves the view as it was
+            CHECK(view.getRawBytes() == other);
+            CHECK(view.getCapacity() == sizeof(other) && view.getSize() == 0);
+            CHECK(constView.getRawBytes() == other);
+        }
+    }
+
+    // Offsets and lengths whose sum overflows
+    ByteBuffer view = untouched;
+    CHECK(!buffer.slice(1, static_cast<size_t>(-1), view));
+    CHECK(!buffer.slice(static_cast<size_t>(-1), 2, view));
+    CHECK(view.getRawBytes() == other);
+
+    // The source is not changed by slicing
+    CHECK(buffer.getSize() == 20 && buffer.getCapacity() == sizeof(mem));
+}
+
+// A view bounds the streams built on it, and shares the memory
+static void testViews() {
+    uint8_t mem[64];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream writer(buffer);
+    CHECK(writer.writeUint32(0x11223344));
+    CHECK(writer.writeUint32(0x55667788));
+    CHECK(writer.writeUint16(0x99AA));
+
+    ByteBuffer view = buffer;
+    CHECK(buffer.slice(4, 4, view));
+    ByteStream reader(view);
+    uint32_t value = 0;
+    uint8_t byte;
+    CHECK(reader.readUint32(value) && value == 0x55667788);
+    CHECK(!reader.readUint8(byte));
+
+    // Nothing can be added to a full view; a cleared one writes in place
+    CHECK(!view.addByte(0));
+    view.clear();
+    ByteStream inPlace(view);
+    CHECK(inPlace.writeUint32(0xDEADBEEF));
+    CHECK(!inPlace.writeUint8(0));
+    CHECK(mem[4] == 0xDE && mem[7] == 0xEF && mem[8] == 0x99);
+
+    // Erasing a view never zeroes the shared memory
+    view.erase();
+    CHECK(mem[4] == 0xDE);
+
+    // A view of a view
+    ByteBuffer inner = view;
+    CHECK(buffer.slice(2, 8, view) && view.slice(2, 4, inner));
+    CHECK(isSame(inner, mem + 4, 4));
+    CHECK(!view.slice(6, 3, inner));
+}
+
+// Framed messages read one after the other through readSlice()
+static void testReadSlice(test::Random& rng) {
+    vector<uint8_t> mem(4096);
+    ByteBuffer batch(mem.data(), mem.size());
+    ByteStream writer(batch);
+
+    vector<vector<uint8_t> > frames(1 + rng.below(40));
+    for (vector<uint8_t>& frame : frames) {
+        frame.resize(rng.below(50));
+        for (uint8_t& byte : frame) byte = rng.byte();
+        CHECK(writer.writeUint32(static_cast<uint32_t>(frame.size())));
+        for (uint8_t byte : frame) CHECK(writer.writeUint8(byte));
+    }
+
+    ByteStream reader(batch);
+    ByteBuffer frame = batch;
+    uint32_t frameLength;
+    size_t count = 0;
+    while (reader.readUint32(frameLength) && reader.readSlice(frameLength, frame)) {
+        const vector<uint8_t>& expected = frames[count++];
+        CHECK(frame.getSize() == expected.size());
+        CHECK(expected.empty() || memcmp(frame.getRawBytes(), expected.data(), expected.size()) == 0);
+    }
+    CHECK(count == frames.size());
+}
+
+// A length past the remaining bytes leaves the cursor and the view alone
+static void testReadSliceTooLong() {
+    uint8_t mem[16];
+    ByteBuffer buffer(mem, sizeof(mem));
+    for (uint8_t i = 0; i < 10; i++) buffer.addByte(i);
+
+    uint8_t other[2];
+    ByteBuffer untouched(other, sizeof(other));
+
+    for (size_t consumed = 0; consumed <= 10; consumed++) {
+        ByteStream reader(buffer);
+        ByteBuffer view = untouched;
+        CHECK(reader.readSlice(consumed, view));
+        CHECK(isSame(view, mem, consumed));
+
+        const size_t remaining = 10 - consumed;
+        const size_t tooLong[] = { remaining + 1, remaining + 7, static_cast<size_t>(-1) };
+        for (size_t len : tooLong) {
+            view = untouched;
+            CHECK(!reader.readSlice(len, view));
+            CHECK(view.getRawBytes() == other);
+        }
+
+        // The cursor did not move: the rest is still there to read
+        CHECK(reader.readSlice(remaining, view));
+        CHECK(isSame(view, mem + consumed, remaining));
+        uint8_t byte;
+        CHECK(!reader.readUint8(byte));
+    }
+}
+
+int main() {
+    test::Random rng(125);
+
+    testRanges();
+    testViews();
+    testReadSlice(rng);
+    testReadSliceTooLong();
+
+    return test::finish("buffer slices");
+}
@@ -0,0 +1,150 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <utility>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static bool isAligned(const uint8_t* bytes, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(bytes) % alignment == 0;
+}
+
+static bool isZero(const uint8_t* bytes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (bytes[i] != 0) return false;
+    }
+    return true;
+}
+
+// The unit every capacity of the kind obtained is rounded up to
+static size_t unitOf(BufferMemory memory) {
+    switch (memory) {
+    case BufferMemory::CacheAligned: return 64;
+    case BufferMemory::PageAligned: return BufferStorage::getPageSize();
+    default: return HUGE_PAGE_SIZE;
+    }
+}
+
+static void testKinds() {
+    const size_t page = BufferStorage::getPageSize();
+    CHECK(page >= 4096 && (page & (page - 1)) == 0);
+
+    const size_t capacities[] = { 1, 63, 64, 65, page - 1, page, page + 1,
+                                  HUGE_PAGE_SIZE + 1 };
+    const BufferMemory kinds[] = { BufferMemory::CacheAligned, BufferMemory::PageAligned,
+                                   BufferMemory::HugePages };
+
+    for (BufferMemory kind : kinds)
+    for (size_t capacity : capacities) {
+        BufferStorage storage(capacity, kind);
+        CHECK(storage.isValid());
+
+        // Only huge pages may come back as another kind, and only as plain pages
+        const BufferMemory memory = storage.getMemory();
+        if (kind == BufferMemory::HugePages) {
+            CHECK(memory == BufferMemory::HugePages || memory == BufferMemory::PageAligned);
+#if defined(SERDELITE_NO_HUGE_PAGES)
+            CHECK(memory == BufferMemory::PageAligned);
+#endif
+        } else {
+            CHECK(memory == kind);
+        }
+
+        const size_t unit = unitOf(memory);
+        CHECK(isAligned(storage.getBytes(), unit));
+        CHECK(storage.getCapacity() >= capacity);
+        CHECK(storage.getCapacity() % unit == 0);
+        CHECK(storage.getCapacity() - capacity < unit);
+
+        // Mappings come zeroed, and all of the capacity is usable
+        if (memory != BufferMemory::CacheAligned)
+            CHECK(isZero(storage.getBytes(), storage.getCapacity()));
+        memset(storage.getBytes(), 0xA5, storage.getCapacity());
+
+        const BufferStorage& constStorage = storage;
+        CHECK(constStorage.getBytes() == storage.getBytes());
+    }
+}
+
+static void testFailures() {
+    const BufferMemory kinds[] = { BufferMemory::CacheAligned, BufferMemory::PageAligned,
+                                   BufferMemory::HugePages };
+
+    // Nothing to allocate, sizes that overflow the rounding, and mappings no
+    // system can give (not tried on the heap, which sanitizers abort on)
+    for (BufferMemory kind : kinds)
+    for (size_t capacity : { static_cast<size_t>(0), static_cast<size_t>(-1),
+                             static_cast<size_t>(-1) - HUGE_PAGE_SIZE }) {
+        const bool isHeap = kind == BufferMemory::CacheAligned;
+        if (isHeap && capacity == static_cast<size_t>(-1) - HUGE_PAGE_SIZE) continue;
+
+        BufferStorage storage(capacity, kind);
+        CHECK(!storage.isValid());
+        CHECK(storage.getBytes() == nullptr);
+        CHECK(storage.getCapacity() == 0);
+    }
+}
+
+static void testMove() {
+    BufferStorage first(1000, BufferMemory::PageAligned);
+    uint8_t* bytes = first.getBytes();
+    const size_t capacity = first.getCapacity();
+    CHECK(first.isValid());
+
+    BufferStorage second(std::move(first));
+    CHECK(!first.isValid() && first.getCapacity() == 0);
+    CHECK(second.getBytes() == bytes && second.getCapacity() == capacity);
+    CHECK(second.getMemory() == BufferMemory::PageAligned);
+
+    // Assignment frees the memory held before
+    BufferStorage third(100, BufferMemory::CacheAligned);
+    third = std::move(second);
+    CHECK(!second.isValid());
+    CHECK(third.getBytes() == bytes && third.getMemory() == BufferMemory::PageAligned);
+}
+
+static void testWithByteBuffer(test::Random& rng) {
+    BufferStorage storage(3 * HUGE_PAGE_SIZE, BufferMemory::HugePages);
+    CHECK(storage.isValid());
+
+    ByteBuffer buffer(storage.getBytes(), storage.getCapacity(),
+                      Endian::Little, ZeroPolicy::None);
+    ByteStream stream(buffer);
+    uint64_t sum = 0;
+    bool isWritten = true;
+    while (isWritten && buffer.getSpaceLeft() >= 8) {
+        const uint64_t value = rng.next();
+        sum += value;
+        isWritten = stream.writeUint64(value);
+    }
+    CHECK(isWritten);
+    CHECK(buffer.getSize() == storage.getCapacity());
+
+    ByteStream reader(buffer);
+    uint64_t readSum = 0, value;
+    while (reader.readUint64(value)) readSum += value;
+    CHECK(readSum == sum);
+}
+
+int main() {
+    test::Random rng(124);
+
+    testKinds();
+    testFailures();
+    testMove();
+    testWithByteBuffer(rng);
+
+    return test::finish("buffer storage");
+}
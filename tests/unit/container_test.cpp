@@ -0,0 +1,290 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+// Counts every allocation, so rejected counts can be shown to allocate nothing
+static size_t allocations = 0;
+
+template <typename T>
+struct CountingAllocator {
+    typedef T value_type;
+
+    CountingAllocator() {}
+    template <typename U> CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        allocations++;
+        return allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) { allocator<T>().deallocate(p, n); }
+
+    template <typename U> bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+typedef vector<uint32_t, CountingAllocator<uint32_t> > CountedVector;
+typedef unordered_map<uint16_t, string, hash<uint16_t>, equal_to<uint16_t>,
+                      CountingAllocator<pair<const uint16_t, string> > > CountedMap;
+
+class Item: public ByteSerializable {
+public:
+    uint16_t id;
+    string name;
+
+    Item(): id(0) {}
+    Item(uint16_t _id, const string& _name): id(_id), name(_name) {}
+
+    bool operator==(const Item& other) const {
+        return id == other.id && name == other.name;
+    }
+
+    bool toByteStream(ByteStream& s) const override {
+        return s.writeUint16(id) && s.writeString(name);
+    }
+
+    bool fromByteStream(ByteStream& s) override {
+        return s.readUint16(id) && s.readString(name);
+    }
+
+    size_t byteSize() const override {
+        return sizeof(id) + sizeof(uint16_t) + name.size();
+    }
+};
+
+static void testRoundTrip(test::Random& rng, Endian order) {
+    vector<uint8_t> mem(16 * 1024);
+    ByteBuffer buffer(mem.data(), mem.size(), order);
+    ByteStream stream(buffer);
+
+    string text("embedded\0zero", 13);
+    vector<int64_t> numbers;
+    for (int i = 0; i < 100; i++) numbers.push_back(static_cast<int64_t>(rng.next()));
+    vector<double> reals(3, -0.25);
+    vector<bool> flags = { true, false, true, true };
+    vector<string> words = { "", "a", "longer word" };
+    vector<Item> items = { Item(1, "sword"), Item(2, "") };
+    vector<vector<uint16_t> > nested = { {}, { 1, 2, 3 }, { 65535 } };
+    array<uint32_t, 4> fixed = {{ 1, 0xDEADBEEF, 0, 7 }};
+    array<string, 2> fixedWords = {{ "north", "south" }};
+    array<uint8_t, 0> empty = {{}};
+    unordered_map<string, int32_t> scores = { { "alice", -5 }, { "bob", 12 } };
+    unordered_map<uint16_t, vector<string> > tags = { { 3, { "x", "y" } }, { 9, {} } };
+
+    CHECK(stream.writeString(text));
+    CHECK(stream.writeVector(numbers));
+    CHECK(stream.writeVector(reals));
+    CHECK(stream.writeVector(flags));
+    CHECK(stream.writeVector(words));
+    CHECK(stream.writeVector(items));
+    CHECK(stream.writeVector(nested));
+    CHECK(stream.writeArray(fixed));
+    CHECK(stream.writeArray(fixedWords));
+    CHECK(stream.writeArray(empty));
+    CHECK(stream.writeMap(scores));
+    CHECK(stream.writeMap(tags));
+
+    string textOut;
+    vector<int64_t> numbersOut;
+    vector<double> realsOut;
+    vector<bool> flagsOut;
+    vector<string> wordsOut;
+    vector<Item> itemsOut;
+    vector<vector<uint16_t> > nestedOut;
+    array<uint32_t, 4> fixedOut;
+    array<string, 2> fixedWordsOut;
+    array<uint8_t, 0> emptyOut;
+    unordered_map<string, int32_t> scoresOut;
+    unordered_map<uint16_t, vector<string> > tagsOut;
+
+    CHECK(stream.readString(textOut) && textOut == text);
+    CHECK(stream.readVector(numbersOut) && numbersOut == numbers);
+    CHECK(stream.readVector(realsOut) && realsOut == reals);
+    CHECK(stream.readVector(flagsOut) && flagsOut == flags);
+    CHECK(stream.readVector(wordsOut) && wordsOut == words);
+    CHECK(stream.readVector(itemsOut) && itemsOut == items);
+    CHECK(stream.readVector(nestedOut) && nestedOut == nested);
+    CHECK(stream.readArray(fixedOut) && fixedOut == fixed);
+    CHECK(stream.readArray(fixedWordsOut) && fixedWordsOut == fixedWords);
+    CHECK(stream.readArray(emptyOut));
+    CHECK(stream.readMap(scoresOut) && scoresOut == scores);
+    CHECK(stream.readMap(tagsOut) && tagsOut == tags);
+    CHECK(stream.getReadCursor() == buffer.getSize());
+}
+
+// A four-byte count claiming far more elements than the bytes that follow
+static void writeHostileCount(ByteBuffer& buffer, uint32_t count) {
+    buffer.clear();
+    ByteStream stream(buffer);
+    stream.writeUint32(count);
+    for (int i = 0; i < 8; i++) stream.writeUint8(0);
+}
+
+static void testHostileCounts() {
+    uint8_t mem[64];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+
+    const uint32_t counts[] = { 0xFFFFFFFFu, 0x80000000u, 1000000u, 9u, 3u };
+    for (uint32_t count : counts) {
+        CountedVector numbers(1, 42);
+        CountedMap names;
+        vector<string> words(1, "kept");
+        vector<array<uint8_t, 0> > empties;
+        vector<vector<uint8_t> > nested;
+
+        allocations = 0;
+
+        // Four-byte elements: 8 bytes left hold at most 2
+        writeHostileCount(buffer, count);
+        stream.resetReadCursor();
+        CHECK(!stream.readVector(numbers));
+        CHECK(stream.getReadCursor() == 0);
+        CHECK(numbers.size() == 1 && numbers[0] == 42);
+
+        // Pairs of a two-byte key and a two-byte string length: at most 2
+        stream.resetReadCursor();
+        CHECK(!stream.readMap(names));
+        CHECK(stream.getReadCursor() == 0);
+        CHECK(names.empty());
+
+        CHECK(allocations == 0);
+
+        // Strings and nested vectors need their own length prefix each
+        if (count > 4) {
+            stream.resetReadCursor();
+            CHECK(!stream.readVector(words));
+            CHECK(words.size() == 1 && words[0] == "kept");
+            stream.resetReadCursor();
+            CHECK(!stream.readVector(nested));
+            CHECK(stream.getReadCursor() == 0);
+        }
+
+        // Zero-sized elements still count as one byte each
+        if (count > 8) {
+            stream.resetReadCursor();
+            CHECK(!stream.readVector(empties));
+            CHECK(stream.getReadCursor() == 0);
+        }
+    }
+
+    // A string length past the end of the data
+    buffer.clear();
+    CHECK(stream.writeUint16(200));
+    CHECK(stream.writeUint32(0));
+    string text("kept");
+    stream.resetReadCursor();
+    CHECK(!stream.readString(text));
+    CHECK(text == "kept");
+    CHECK(stream.getReadCursor() == 0);
+}
+
+static void testInvalidInput() {
+    uint8_t mem[256];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+
+    unordered_map<string, int32_t> scores = { { "alice", -5 }, { "bob", 12 } };
+    vector<string> words = { "one", "two", "three" };
+    CHECK(stream.writeMap(scores));
+    const size_t mapSize = buffer.getSize();
+    CHECK(stream.writeVector(words));
+    const size_t fullSize = buffer.getSize();
+
+    // Every truncation fails and leaves both the cursor and the output alone
+    for (size_t len = 0; len < fullSize; len++) {
+        buffer.setLength(len);
+        stream.resetReadCursor();
+
+        unordered_map<string, int32_t> scoresOut = { { "old", 1 } };
+        vector<string> wordsOut(1, "old");
+        const bool mapRead = stream.readMap(scoresOut);
+        CHECK(mapRead == (len >= mapSize));
+        CHECK(mapRead || (scoresOut.size() == 1 && scoresOut.count("old") == 1));
+        CHECK(stream.getReadCursor() == (mapRead ? mapSize : 0));
+        if (!mapRead) continue;
+
+        CHECK(!stream.readVector(wordsOut));
+        CHECK(wordsOut.size() == 1 && wordsOut[0] == "old");
+        CHECK(stream.getReadCursor() == mapSize);
+    }
+    buffer.setLength(fullSize);
+
+    // A duplicated key
+    buffer.clear();
+    CHECK(stream.writeUint32(2));
+    for (int i = 0; i < 2; i++) {
+        CHECK(stream.writeString(string("dup")));
+        CHECK(stream.writeInt32(i));
+    }
+    unordered_map<string, int32_t> dup;
+    stream.resetReadCursor();
+    CHECK(!stream.readMap(dup));
+    CHECK(dup.empty());
+    CHECK(stream.getReadCursor() == 0);
+
+    // Output overflow leaves the buffer as it was
+    uint8_t tiny[16];
+    ByteBuffer tinyBuffer(tiny, sizeof(tiny));
+    ByteStream tinyStream(tinyBuffer);
+    CHECK(tinyStream.writeUint8(1));
+    CHECK(!tinyStream.writeVector(words));
+    CHECK(!tinyStream.writeMap(scores));
+    CHECK(!tinyStream.writeString(string(20, 'x')));
+    CHECK(!tinyStream.writeString(string(70000, 'x')));
+    CHECK(tinyBuffer.getSize() == 1);
+}
+
+static void testJson() {
+    uint8_t mem[256];
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer);
+
+    vector<int32_t> numbers = { 1, -2, 3 };
+    array<string, 2> words = {{ "a\"b", "" }};
+    unordered_map<string, vector<bool> > flags = { { "on", { true, false } } };
+
+    CHECK(json.writeVector("numbers", numbers));
+    CHECK(json.writeArray("words", words));
+    CHECK(json.writeMap("flags", flags));
+    CHECK(json.close());
+
+    const char* expected =
+        "{\"numbers\":[1,-2,3],\"words\":[\"a\\\"b\",\"\"],"
+        "\"flags\":{\"on\":[true,false]}}";
+    JsonBuffer out = json.getJson();
+    CHECK(out.length == strlen(expected));
+    CHECK(memcmp(out.data, expected, out.length) == 0);
+    CHECK(out.isValid());
+}
+
+int main() {
+    test::Random rng(105);
+
+    testRoundTrip(rng, Endian::Big);
+    testRoundTrip(rng, Endian::Little);
+    testHostileCounts();
+    testInvalidInput();
+    testJson();
+
+    return test::finish("containers");
+}
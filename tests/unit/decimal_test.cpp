@@ -0,0 +1,260 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <string>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+#if defined(SERDELITE_HAS_INT128)
+
+static const char INT128_MAX_TEXT[] = "170141183460469231731687303715884105727";
+static const char INT128_MIN_TEXT[] = "-170141183460469231731687303715884105728";
+static const char UINT128_MAX_TEXT[] = "340282366920938463463374607431768211455";
+
+static const int128_t INT128_MAX_VALUE =
+    static_cast<int128_t>((~static_cast<uint128_t>(0)) >> 1);
+static const int128_t INT128_MIN_VALUE = -INT128_MAX_VALUE - 1;
+
+// Plain digit-by-digit reference for the decimal text of `units / 10^scale`
+static string referenceText(int128_t units, uint8_t scale) {
+    const bool isNegative = units < 0;
+    uint128_t magnitude = isNegative ? 0 - static_cast<uint128_t>(units)
+                                     : static_cast<uint128_t>(units);
+    string digits;
+    do {
+        digits.insert(digits.begin(), static_cast<char>('0' + magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (scale > 0) {
+        if (digits.size() <= scale) digits.insert(0, scale + 1 - digits.size(), '0');
+        digits.insert(digits.size() - scale, 1, '.');
+    }
+    return isNegative ? "-" + digits : digits;
+}
+
+static string formatted(const Decimal& value) {
+    char text[Decimal::MAX_STRING_LENGTH];
+    return string(text, value.format(text));
+}
+
+static bool parses(const string& text, uint8_t scale, int128_t expected) {
+    Decimal value;
+    return Decimal::parse(text.data(), text.size(), scale, value) &&
+           value.getUnits() == expected && value.getScale() == scale;
+}
+
+static bool rejects(const string& text, uint8_t scale) {
+    Decimal value(7, 1);
+    return !Decimal::parse(text.data(), text.size(), scale, value) &&
+           value.getUnits() == 7 && value.getScale() == 1;
+}
+
+static int128_t randomUnits(test::Random& rng) {
+    uint128_t bits = (static_cast<uint128_t>(rng.next()) << 64) | rng.next();
+
+    // Mix full-width values with short ones, of either sign
+    bits >>= 1 + rng.below(127);
+    const int128_t units = static_cast<int128_t>(bits);
+    return rng.below(2) ? -units : units;
+}
+
+static void testRoundTrip(test::Random& rng) {
+    for (int i = 0; i < 5000; i++) {
+        const int128_t units = randomUnits(rng);
+        const uint8_t scale = static_cast<uint8_t>(rng.below(Decimal::MAX_SCALE + 1));
+        const Decimal value(units, scale);
+
+        const string text = formatted(value);
+        CHECK(text == referenceText(units, scale));
+        CHECK(text.size() <= Decimal::MAX_STRING_LENGTH);
+        CHECK(parses(text, scale, units));
+
+        // The same value at a larger scale gains exact trailing zeros
+        if (scale < Decimal::MAX_SCALE && units > -1000 && units < 1000)
+            CHECK(parses(text, scale + 1, units * 10));
+    }
+}
+
+static void testBoundaries() {
+    const int128_t bounds[] = { INT128_MAX_VALUE, INT128_MIN_VALUE, 0, 1, -1 };
+    const uint8_t scales[] = { 0, 1, 19, 37, Decimal::MAX_SCALE };
+
+    for (int128_t units : bounds)
+    for (uint8_t scale : scales) {
+        const Decimal value(units, scale);
+        const string text = formatted(value);
+        CHECK(text == referenceText(units, scale));
+        CHECK(parses(text, scale, units));
+    }
+
+    CHECK(formatted(Decimal(INT128_MAX_VALUE, 0)) == INT128_MAX_TEXT);
+    CHECK(formatted(Decimal(INT128_MIN_VALUE, 0)) == INT128_MIN_TEXT);
+    CHECK(formatted(Decimal(INT128_MIN_VALUE, Decimal::MAX_SCALE)).size() ==
+          Decimal::MAX_STRING_LENGTH);
+    CHECK(formatted(Decimal(-5, 2)) == "-0.05");
+    CHECK(formatted(Decimal(1250, 2)) == "12.50");
+
+    // One past either end of the range
+    CHECK(rejects("170141183460469231731687303715884105728", 0));
+    CHECK(rejects("-170141183460469231731687303715884105729", 0));
+    CHECK(rejects(UINT128_MAX_TEXT, 0));
+    CHECK(rejects("340282366920938463463374607431768211456", 0));
+    CHECK(rejects("1.70141183460469231731687303715884105728", Decimal::MAX_SCALE));
+    CHECK(rejects("2", Decimal::MAX_SCALE));
+    CHECK(parses("1", Decimal::MAX_SCALE,
+                 static_cast<int128_t>(1e18) * static_cast<int128_t>(1e18) * 100));
+
+    // Scales past the maximum are refused by parse and clamped by the constructor
+    CHECK(rejects("1", Decimal::MAX_SCALE + 1));
+    CHECK(Decimal(1, 200).getScale() == Decimal::MAX_SCALE);
+}
+
+static void testExactness() {
+    // Precision loss is an error, never a rounding
+    CHECK(rejects("12.345", 2));
+    CHECK(rejects("0.001", 2));
+    CHECK(rejects("1e-3", 2));
+    CHECK(rejects("0.000000000000000000000000000000000000001", Decimal::MAX_SCALE));
+    CHECK(parses("0.00000000000000000000000000000000000001", Decimal::MAX_SCALE, 1));
+
+    // Trailing zeros are exact wherever they are
+    CHECK(parses("12.340", 2, 1234));
+    CHECK(parses("12.3400000000000000000000000000000000000000000000", 2, 1234));
+    CHECK(parses("1.25e3", 0, 1250));
+    CHECK(parses("125E-2", 2, 125));
+    CHECK(parses("1e-2", 2, 1));
+    CHECK(parses("-12.5", 1, -125));
+    CHECK(parses("-0", 0, 0));
+    CHECK(parses("0e100000000", 0, 0));
+    CHECK(parses("100000000000000000000000000000000000000000000e-44", 0, 1));
+    CHECK(rejects("1e100000000", 0));
+    CHECK(rejects("1e39", 0));
+}
+
+static void testMalformed() {
+    const char* inputs[] = { "", "-", "+1", "01", "-01", "1.", ".5", "1e",
+                             "1e+", "1.2.3", " 1", "1 ", "1,5", "0x10",
+                             "1e5.0", "--1", "NaN", "Infinity" };
+    for (const char* input : inputs) CHECK(rejects(input, 2));
+
+    // The length bounds the text, so a longer valid prefix is not enough
+    Decimal value;
+    CHECK(Decimal::parse("123", 2, 0, value) && value.getUnits() == 12);
+    CHECK(!Decimal::parse(nullptr, 0, 0, value));
+
+    char text[8];
+    CHECK(Decimal(-5, 2).toString(text, 6) && strcmp(text, "-0.05") == 0);
+    CHECK(!Decimal(-5, 2).toString(text, 5));
+}
+
+static void testStreams(test::Random& rng) {
+    const Endian orders[] = { Endian::Big, Endian::Little };
+
+    for (Endian order : orders) {
+        uint8_t mem[256];
+        ByteBuffer buffer(mem, sizeof(mem), order);
+        ByteStream stream(buffer);
+
+        const uint128_t unsignedValue = ~static_cast<uint128_t>(0) - rng.next();
+        const int128_t signedValue = INT128_MIN_VALUE + 3;
+        const Decimal decimal(randomUnits(rng), 12);
+
+        CHECK(stream.writeUint128(1));
+        CHECK(stream.writeUint128(unsignedValue));
+        CHECK(stream.writeInt128(signedValue));
+        CHECK(stream.writeDecimal(decimal));
+        CHECK(buffer.getSize() == 3 * 16 + 17);
+
+        // The value 1 in the buffer's byte order
+        CHECK(mem[order == Endian::Big ? 15 : 0] == 1);
+
+        uint128_t unsignedOut;
+        int128_t signedOut;
+        Decimal decimalOut;
+        CHECK(stream.readUint128(unsignedOut) && unsignedOut == 1);
+        CHECK(stream.readUint128(unsignedOut) && unsignedOut == unsignedValue);
+        CHECK(stream.readInt128(signedOut) && signedOut == signedValue);
+        CHECK(stream.readDecimal(decimalOut));
+        CHECK(decimalOut.getUnits() == decimal.getUnits());
+        CHECK(decimalOut.getScale() == decimal.getScale());
+
+        // Truncated values and an out-of-range scale leave the cursor in place
+        const size_t decimalPos = 3 * 16;
+        for (size_t len = decimalPos; len < buffer.getSize(); len++) {
+            ByteBuffer cut(mem, sizeof(mem), order);
+            cut.setLength(len);
+            ByteStream cutStream(cut);
+            CHECK(cutStream.readUint128(unsignedOut));
+            CHECK(cutStream.readUint128(unsignedOut));
+            CHECK(cutStream.readInt128(signedOut));
+            CHECK(!cutStream.readDecimal(decimalOut));
+            CHECK(cutStream.getReadCursor() == decimalPos);
+        }
+
+        mem[decimalPos] = Decimal::MAX_SCALE + 1;
+        stream.resetReadCursor();
+        CHECK(stream.readUint128(unsignedOut) && stream.readUint128(unsignedOut));
+        CHECK(stream.readInt128(signedOut));
+        CHECK(!stream.readDecimal(decimalOut));
+        CHECK(stream.getReadCursor() == decimalPos);
+
+        // A full buffer takes neither half of a decimal
+        uint8_t small[16];
+        ByteBuffer smallBuffer(small, sizeof(small), order);
+        ByteStream smallStream(smallBuffer);
+        CHECK(!smallStream.writeDecimal(decimal));
+        CHECK(smallBuffer.getSize() == 0);
+    }
+}
+
+static void testJson() {
+    uint8_t mem[256];
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer);
+
+    CHECK(json.writeUint128("u", ~static_cast<uint128_t>(0)));
+    CHECK(json.writeInt128("min", INT128_MIN_VALUE));
+    CHECK(json.writeInt128("max", INT128_MAX_VALUE));
+    CHECK(json.writeDecimal("price", Decimal(-5, 2)));
+    CHECK(json.close());
+
+    const string expected = string("{\"u\":") + UINT128_MAX_TEXT +
+                            ",\"min\":" + INT128_MIN_TEXT +
+                            ",\"max\":" + INT128_MAX_TEXT +
+                            ",\"price\":-0.05}";
+    JsonBuffer out = json.getJson();
+    CHECK(string(out.data, out.length) == expected);
+}
+
+int main() {
+    test::Random rng(109);
+
+    testRoundTrip(rng);
+    testBoundaries();
+    testExactness();
+    testMalformed();
+    testStreams(rng);
+    testJson();
+
+    return test::finish("decimals");
+}
+
+#else
+
+int main() {
+    printf("[SKIP] decimals: no 128-bit integer support\n");
+    return 0;
+}
+
+#endif
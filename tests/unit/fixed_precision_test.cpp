@@ -0,0 +1,190 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+// The value written for key "v", "!" when the write failed
+static string writeOne(double val, uint8_t fractionDigits) {
+    char mem[128];
+    ByteBuffer buffer(reinterpret_cast<uint8_t*>(mem), sizeof(mem));
+    JsonStream json(buffer);
+    if (!json.writeFixed("v", val, fractionDigits)) return buffer.getSize() == 1 ? "!" : "?";
+
+    // Everything after {"v": since the stream is left open
+    return string(mem + 5, buffer.getSize() - 5);
+}
+
+// printf rounding with the trailing zeros and a bare point removed
+static string reference(double val, unsigned fractionDigits) {
+    char text[64];
+    snprintf(text, sizeof(text), "%.*f", static_cast<int>(fractionDigits), val);
+
+    string result = text;
+    if (result.find('.') != string::npos) {
+        while (result.back() == '0') result.pop_back();
+        if (result.back() == '.') result.pop_back();
+    }
+    return result == "-0" ? "0" : result;
+}
+
+// True when `val` scaled by 10^digits lies close to a rounding tie
+static bool isNearTie(double val, unsigned fractionDigits) {
+    const long double scaled = fabsl(static_cast<long double>(val) *
+                                     powl(10.0L, fractionDigits));
+    return fabsl(scaled - floorl(scaled) - 0.5L) < 1e-3L;
+}
+
+static void testRounding() {
+    // Trailing zeros, and a point only when a fraction is left
+    CHECK(writeOne(2.5, 2) == "2.5");
+    CHECK(writeOne(2.0, 4) == "2");
+    CHECK(writeOne(1.10, 3) == "1.1");
+    CHECK(writeOne(100.0, 2) == "100");
+    CHECK(writeOne(0.05, 2) == "0.05");
+    CHECK(writeOne(1234.5678, 0) == "1235");
+
+    // Carries out of the fraction, and values that round to zero
+    CHECK(writeOne(0.999, 2) == "1");
+    CHECK(writeOne(9.9996, 3) == "10");
+    CHECK(writeOne(-9.9996, 3) == "-10");
+    CHECK(writeOne(0.004, 2) == "0");
+    CHECK(writeOne(-0.004, 2) == "0");
+    CHECK(writeOne(-0.0, 2) == "0");
+    CHECK(writeOne(1e-300, 15) == "0");
+
+    // Exact binary ties round away from zero
+    CHECK(writeOne(0.125, 2) == "0.13");
+    CHECK(writeOne(-0.125, 2) == "-0.13");
+    CHECK(writeOne(2.5, 0) == "3");
+    CHECK(writeOne(-2.5, 0) == "-3");
+
+    // Full width, the digit limit, and values too large to scale exactly
+    CHECK(writeOne(123456.654321, 6) == "123456.654321");
+    CHECK(writeOne(0.000000000000001, JsonStream::MAX_FIXED_DIGITS) == "0.000000000000001");
+    CHECK(writeOne(18446744073709.0, 6) == "18446744073709");
+    CHECK(writeOne(9007199254.740993, 6) == reference(9007199254.740993, 6));
+    CHECK(writeOne(1e300, 2) == "1.0000000000000001e+300");
+    CHECK(writeOne(-1e20, 0) == "-100000000000000000000");
+    CHECK(writeOne(-1e21, 1) == "-1e+21");
+    CHECK(writeOne(1.5, JsonStream::MAX_FIXED_DIGITS + 1) == "!");
+
+    // Non-finite values are null
+    CHECK(writeOne(NAN, 2) == "null");
+    CHECK(writeOne(INFINITY, 2) == "null");
+    CHECK(writeOne(-INFINITY, 0) == "null");
+}
+
+static void testAgainstPrintf(test::Random& rng) {
+    for (int i = 0; i < 100000; i++) {
+        const unsigned digits = static_cast<unsigned>(rng.below(10));
+
+        // Keep the scaled value well inside the exactly representable range
+        const double magnitude = pow(10.0, static_cast<double>(rng.below(11 - digits)));
+        double val = static_cast<double>(rng.next() >> 11) / 9007199254740992.0 * magnitude;
+        if (rng.below(2)) val = -val;
+
+        const string written = writeOne(val, static_cast<uint8_t>(digits));
+        if (written != reference(val, digits)) CHECK(isNearTie(val, digits));
+    }
+}
+
+class Sample: public JsonSerializable {
+public:
+    float ratio;
+    vector<double> points;
+
+    Sample(): ratio(0.3333f), points{ 1.0, 2.25, -3.14159 } {}
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeFloat("ratio", ratio) && s.writeVector("points", points);
+    }
+};
+
+static void testStreamPrecision() {
+    uint8_t mem[256];
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer);
+
+    CHECK(json.getFixedPrecision() == JsonStream::FULL_PRECISION);
+    CHECK(!json.setFixedPrecision(JsonStream::MAX_FIXED_DIGITS + 1));
+    CHECK(json.setFixedPrecision(2));
+    CHECK(!json.setFixedPrecision(200));
+    CHECK(json.getFixedPrecision() == 2);
+
+    // Every real follows the stream precision, nested ones included
+    CHECK(json.writeDouble("d", 1.005001));
+    CHECK(json.writeObject("s", Sample()));
+    CHECK(json.writeFixed("f", 1.23456, 4));
+    CHECK(json.setFixedPrecision(JsonStream::FULL_PRECISION));
+    CHECK(json.writeDouble("full", 0.1));
+    CHECK(json.close());
+
+    const string expected = "{\"d\":1.01,\"s\":{\"ratio\":0.33,\"points\":[1,2.25,-3.14]},"
+                            "\"f\":1.2346,\"full\":0.10000000000000001}";
+    JsonBuffer out = json.getJson();
+    CHECK(string(out.data, out.length) == expected);
+    CHECK(out.isValid());
+
+    // The precision survives a reset
+    CHECK(json.setFixedPrecision(1));
+    CHECK(json.reset());
+    CHECK(json.getFixedPrecision() == 1);
+    CHECK(json.writeDouble("d", 2.25));
+    CHECK(json.close());
+    out = json.getJson();
+    CHECK(string(out.data, out.length) == "{\"d\":2.3}");
+}
+
+// Values are written through the raw pointer when the worst case fits, and
+// with checked writes near the end; both must fit exactly and agree
+static void testNearCapacity(test::Random& rng) {
+    for (int trial = 0; trial < 200; trial++) {
+        const uint8_t digits = static_cast<uint8_t>(rng.below(JsonStream::MAX_FIXED_DIGITS + 1));
+        double val = static_cast<double>(rng.next() >> 40) / 1000.0;
+        if (rng.below(2)) val = -val;
+        const string text = writeOne(val, digits);
+        const string full = "{\"v\":" + text + "}";
+
+        for (size_t capacity = 1; capacity <= full.size() + 1; capacity++) {
+            vector<uint8_t> mem(capacity);
+            ByteBuffer buffer(mem.data(), capacity);
+            JsonStream json(buffer);
+
+            const bool isWritten = json.writeFixed("v", val, digits);
+            CHECK(isWritten == (capacity >= full.size() - 1));
+            if (!isWritten) {
+                CHECK(buffer.getSize() == 1);
+                continue;
+            }
+            CHECK(json.close() == (capacity >= full.size()));
+            CHECK(string(reinterpret_cast<char*>(mem.data()), buffer.getSize()) ==
+                  full.substr(0, buffer.getSize()));
+        }
+    }
+}
+
+int main() {
+    test::Random rng(118);
+
+    testRounding();
+    testAgainstPrintf(rng);
+    testStreamPrecision();
+    testNearCapacity(rng);
+
+    return test::finish("fixed precision");
+}
@@ -0,0 +1,172 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <stdio.h>
+#include <string>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+static const int64_t NANOS_PER_SECOND = 1000000000LL;
+static const int64_t NANOS_PER_DAY = 86400 * NANOS_PER_SECOND;
+
+static bool isLeap(int64_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+// Walks the calendar a year and a month at a time from 1970-01-01
+static string referenceTimestamp(int64_t epochNanos, unsigned fractionDigits) {
+    int64_t days = epochNanos / NANOS_PER_DAY;
+    int64_t rest = epochNanos % NANOS_PER_DAY;
+    if (rest < 0) {
+        rest += NANOS_PER_DAY;
+        days--;
+    }
+
+    int64_t year = 1970;
+    while (days < 0) days += isLeap(--year) ? 366 : 365;
+    while (days >= (isLeap(year) ? 366 : 365)) days -= isLeap(year++) ? 366 : 365;
+
+    const int monthDays[] = { 31, isLeap(year) ? 29 : 28, 31, 30, 31, 30,
+                              31, 31, 30, 31, 30, 31 };
+    int month = 0;
+    while (days >= monthDays[month]) days -= monthDays[month++];
+
+    const int64_t seconds = rest / NANOS_PER_SECOND;
+    char text[64];
+    snprintf(text, sizeof(text), "\"%04lld-%02d-%02lldT%02lld:%02lld:%02lld",
+             static_cast<long long>(year), month + 1,
+             static_cast<long long>(days + 1),
+             static_cast<long long>(seconds / 3600),
+             static_cast<long long>(seconds / 60 % 60),
+             static_cast<long long>(seconds % 60));
+
+    string result = text;
+    if (fractionDigits > 0) {
+        snprintf(text, sizeof(text), "%09lld",
+                 static_cast<long long>(rest % NANOS_PER_SECOND));
+        result += "." + string(text, fractionDigits);
+    }
+    return result + "Z\"";
+}
+
+// The value written for key "t", or "!" when the write failed
+static string writeOne(int64_t epochNanos, unsigned fractionDigits) {
+    char mem[128];
+    ByteBuffer buffer(reinterpret_cast<uint8_t*>(mem), sizeof(mem));
+    JsonStream json(buffer);
+    if (!json.writeTimestamp("t", epochNanos, static_cast<uint8_t>(fractionDigits)))
+        return buffer.getSize() == 1 ? "!" : "?";
+
+    // Everything after {"t": since the stream is left open
+    return string(mem + 5, buffer.getSize() - 5);
+}
+
+static int64_t nanosOf(int64_t days, int64_t seconds, int64_t nanos) {
+    return days * NANOS_PER_DAY + seconds * NANOS_PER_SECOND + nanos;
+}
+
+static void testEdgeDates() {
+    CHECK(writeOne(0, 9) == "\"1970-01-01T00:00:00.000000000Z\"");
+    CHECK(writeOne(0, 0) == "\"1970-01-01T00:00:00Z\"");
+    CHECK(writeOne(-1, 9) == "\"1969-12-31T23:59:59.999999999Z\"");
+    CHECK(writeOne(-1, 3) == "\"1969-12-31T23:59:59.999Z\"");
+    CHECK(writeOne(-NANOS_PER_SECOND, 0) == "\"1969-12-31T23:59:59Z\"");
+    CHECK(writeOne(-NANOS_PER_DAY, 0) == "\"1969-12-31T00:00:00Z\"");
+
+    // Leap days, and the century years that are and are not leap
+    CHECK(writeOne(nanosOf(11016, 0, 0), 0) == "\"2000-02-29T00:00:00Z\"");
+    CHECK(writeOne(nanosOf(11017, 0, 0) - 1, 1) == "\"2000-02-29T23:59:59.9Z\"");
+    CHECK(writeOne(nanosOf(11017, 0, 0), 0) == "\"2000-03-01T00:00:00Z\"");
+    CHECK(writeOne(nanosOf(47541, 0, 0) - 1, 0) == "\"2100-02-28T23:59:59Z\"");
+    CHECK(writeOne(nanosOf(47541, 0, 0), 0) == "\"2100-03-01T00:00:00Z\"");
+    CHECK(writeOne(nanosOf(-25508, 0, 0), 0) == "\"1900-03-01T00:00:00Z\"");
+    CHECK(writeOne(nanosOf(-25509, 0, 0), 0) == "\"1900-02-28T00:00:00Z\"");
+    CHECK(writeOne(nanosOf(10957, 0, 0), 0) == "\"2000-01-01T00:00:00Z\"");
+    CHECK(writeOne(nanosOf(10957, 0, 0) - 1, 0) == "\"1999-12-31T23:59:59Z\"");
+
+    // The extremes of int64 nanoseconds
+    CHECK(writeOne(INT64_MAX, 9) == "\"2262-04-11T23:47:16.854775807Z\"");
+    CHECK(writeOne(INT64_MIN, 9) == "\"1677-09-21T00:12:43.145224192Z\"");
+
+    // Digits are truncated, never rounded
+    CHECK(writeOne(999999999, 1) == "\"1970-01-01T00:00:00.9Z\"");
+    CHECK(writeOne(nanosOf(0, 59, 999999999), 0) == "\"1970-01-01T00:00:59Z\"");
+    CHECK(writeOne(0, 10) == "!");
+}
+
+static void testAgainstReference(test::Random& rng) {
+    for (int i = 0; i < 20000; i++) {
+        // Whole range, then the days around the start of each month
+        int64_t nanos = static_cast<int64_t>(rng.next());
+        if (i % 2) {
+            const int64_t day = static_cast<int64_t>(rng.below(200000)) - 100000;
+            nanos = day * NANOS_PER_DAY + static_cast<int64_t>(rng.below(3)) - 1;
+        }
+        const unsigned digits = static_cast<unsigned>(rng.below(10));
+        CHECK(writeOne(nanos, digits) == referenceTimestamp(nanos, digits));
+    }
+
+    // Every day of four centuries around the epoch
+    for (int64_t day = -73000; day < 73000; day++) {
+        const int64_t nanos = day * NANOS_PER_DAY;
+        CHECK(writeOne(nanos, 0) == referenceTimestamp(nanos, 0));
+    }
+}
+
+enum class Color { Red, Green, Blue };
+
+static const EnumName COLOR_NAMES[] = {
+    SERDELITE_ENUM_NAME(Red),
+    SERDELITE_ENUM_NAME(Green),
+    SERDELITE_ENUM_NAME(Blue)
+};
+
+static void testUuidAndEnum() {
+    const uint8_t uuid[16] = { 0x12, 0x3e, 0x45, 0x67, 0xe8, 0x9b, 0x12, 0xd3,
+                               0xa4, 0x56, 0x42, 0x66, 0x14, 0x17, 0x40, 0x00 };
+    char mem[128];
+    ByteBuffer buffer(reinterpret_cast<uint8_t*>(mem), sizeof(mem));
+    JsonStream json(buffer);
+
+    CHECK(json.writeUuid("id", uuid));
+    CHECK(!json.writeUuid("none", nullptr));
+    CHECK(json.writeEnum("color", Color::Blue, COLOR_NAMES));
+    CHECK(!json.writeEnum("color", 3, COLOR_NAMES, 3));
+    CHECK(json.close());
+
+    const string expected = "{\"id\":\"123e4567-e89b-12d3-a456-426614174000\","
+                            "\"color\":\"Blue\"}";
+    JsonBuffer out = json.getJson();
+    CHECK(string(out.data, out.length) == expected);
+    CHECK(out.isValid());
+
+    // Each value is all or nothing when it does not fit
+    for (size_t capacity = 1; capacity < expected.size(); capacity++) {
+        ByteBuffer small(reinterpret_cast<uint8_t*>(mem), capacity);
+        JsonStream smallJson(small);
+        const size_t before = small.getSize();
+        if (!smallJson.writeUuid("id", uuid)) CHECK(small.getSize() == before);
+        const size_t middle = small.getSize();
+        if (!smallJson.writeEnum("color", Color::Blue, COLOR_NAMES))
+            CHECK(small.getSize() == middle);
+    }
+}
+
+int main() {
+    test::Random rng(110);
+
+    testEdgeDates();
+    testAgainstReference(rng);
+    testUuidAndEnum();
+
+    return test::finish("formatted values");
+}
@@ -0,0 +1,114 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+static string referenceDump(const uint8_t* bytes, size_t count) {
+    string text;
+    char cell[24];
+    for (size_t row = 0; row < count; row += 16) {
+        snprintf(cell, sizeof(cell), "%08zX: ", row);
+        text += cell;
+
+        for (size_t i = row; i < row + 16; i++) {
+            if (i < count) {
+                snprintf(cell, sizeof(cell), "%02X ", bytes[i]);
+                text += cell;
+            } else {
+                text += "   ";
+            }
+        }
+
+        text += " | ";
+        for (size_t i = row; i < row + 16 && i < count; i++)
+            text += (bytes[i] >= 32 && bytes[i] <= 126) ? char(bytes[i]) : '.';
+        text += '\n';
+    }
+    return text;
+}
+
+static void fillRandom(test::Random& rng, ByteBuffer& buffer, size_t count) {
+    buffer.clear();
+    for (size_t i = 0; i < count; i++) buffer.addByte(rng.byte());
+}
+
+static void testDump(test::Random& rng) {
+    uint8_t mem[512];
+    static char text[16 * 1024];
+    ByteBuffer buffer(mem, sizeof(mem));
+
+    for (size_t count = 0; count <= 300; count += 1 + rng.below(7)) {
+        fillRandom(rng, buffer, count);
+        const string expected = referenceDump(mem, count);
+        CHECK(buffer.getHexDumpLength() == expected.size());
+
+        ByteBuffer dump(reinterpret_cast<uint8_t*>(text), sizeof(text));
+        CHECK(buffer.hexDump(dump));
+        CHECK(dump.getSize() == expected.size());
+        CHECK(memcmp(text, expected.data(), expected.size()) == 0);
+
+        string viaSink;
+        CHECK(buffer.hexDump([&viaSink](const char* chunk, size_t len) {
+            viaSink.append(chunk, len);
+            return true;
+        }));
+        CHECK(viaSink == expected);
+
+        // All or nothing when the destination is one byte short
+        if (expected.empty()) continue;
+        ByteBuffer small(reinterpret_cast<uint8_t*>(text), expected.size() - 1);
+        CHECK(!buffer.hexDump(small));
+        CHECK(small.getSize() == 0);
+    }
+}
+
+static void testRefusedDestinations(test::Random& rng) {
+    uint8_t mem[100];
+    ByteBuffer buffer(mem, sizeof(mem));
+    fillRandom(rng, buffer, 40);
+    const string expected = referenceDump(mem, 40);
+
+    // Not into itself, even with room to spare
+    CHECK(!buffer.hexDump(buffer));
+    CHECK(buffer.getSize() == 40);
+
+    // A sink that stops the dump ends it, after whole lines only
+    string received;
+    size_t calls = 0;
+    CHECK(!buffer.hexDump([&](const char* chunk, size_t len) {
+        calls++;
+        received.append(chunk, len);
+        return false;
+    }));
+    CHECK(calls == 1);
+    CHECK(expected.compare(0, received.size(), received) == 0);
+    CHECK(!received.empty() && received.back() == '\n');
+
+    // An empty buffer dumps nothing
+    ByteBuffer empty(mem, sizeof(mem));
+    CHECK(empty.getHexDumpLength() == 0);
+    CHECK(empty.hexDump([](const char*, size_t) { return false; }));
+}
+
+int main() {
+    test::Random rng(120);
+
+    testDump(rng);
+    testRefusedDestinations(rng);
+
+    return test::finish("hex dump");
+}
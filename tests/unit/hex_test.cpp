@@ -0,0 +1,113 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+static string referenceHex(const uint8_t* bytes, size_t count) {
+    string text;
+    char pair[3];
+    for (size_t i = 0; i < count; i++) {
+        snprintf(pair, sizeof(pair), "%02X", bytes[i]);
+        text += pair;
+    }
+    return text;
+}
+
+static void fillRandom(test::Random& rng, ByteBuffer& buffer, size_t count) {
+    buffer.clear();
+    for (size_t i = 0; i < count; i++) buffer.addByte(rng.byte());
+}
+
+static void testEncode(test::Random& rng) {
+    uint8_t mem[512];
+    ByteBuffer buffer(mem, sizeof(mem));
+    vector<char> text(2 * sizeof(mem) + 1);
+
+    // Every length up to a few 32-byte AVX2 steps
+    for (size_t count = 0; count <= 200; count++) {
+        fillRandom(rng, buffer, count);
+        const string expected = referenceHex(mem, count);
+
+        CHECK(buffer.toHex(text.data(), expected.size() + 1));
+        CHECK(expected == text.data());
+        CHECK(!buffer.toHex(text.data(), expected.size()));
+    }
+}
+
+static void testDecode(test::Random& rng) {
+    uint8_t mem[512], out[512];
+    ByteBuffer buffer(mem, sizeof(mem));
+    size_t errorIndex;
+
+    for (size_t count = 0; count <= 200; count++) {
+        fillRandom(rng, buffer, count);
+        string text = referenceHex(mem, count);
+
+        // Lowercase digits and separators between some of the pairs
+        string mixed;
+        for (size_t i = 0; i < text.size(); i += 2) {
+            if (i > 0 && rng.below(8) == 0) mixed += " :-"[rng.below(3)];
+            for (size_t j = i; j < i + 2; j++) {
+                const char c = text[j];
+                mixed += (rng.below(2) && c >= 'A') ? char(c - 'A' + 'a') : c;
+            }
+        }
+
+        ByteBuffer decoded(out, sizeof(out));
+        CHECK(decoded.fromHex(mixed.c_str(), errorIndex));
+        CHECK(errorIndex == mixed.size());
+        CHECK(decoded.getSize() == count);
+        CHECK(count == 0 || memcmp(out, mem, count) == 0);
+
+        if (text.empty()) continue;
+
+        // A non-digit anywhere is reported at its position, with no bytes kept
+        const size_t pos = rng.below(text.size());
+        const char saved = text[pos];
+        text[pos] = "gG/:@`\x80"[rng.below(7)];
+        if (text[pos] == ':' && pos % 2 == 0) text[pos] = 'g';
+
+        ByteBuffer rejected(out, sizeof(out));
+        CHECK(rejected.addByte(0xAA));
+        CHECK(!rejected.fromHex(text.c_str(), errorIndex));
+        CHECK(errorIndex == pos);
+        CHECK(rejected.getSize() == 1);
+        text[pos] = saved;
+
+        // A lone trailing digit
+        text += 'A';
+        CHECK(!rejected.fromHex(text.c_str(), errorIndex));
+        CHECK(errorIndex == text.size() - 1);
+        CHECK(rejected.getSize() == 1);
+        text.erase(text.size() - 1);
+
+        // One byte short of room
+        ByteBuffer small(out, count);
+        CHECK(small.addByte(0));
+        CHECK(!small.fromHex(text.c_str(), errorIndex));
+        CHECK(small.getSize() == 1);
+    }
+}
+
+int main() {
+    test::Random rng(121);
+
+    testEncode(rng);
+    testDecode(rng);
+
+    return test::finish("hex");
+}
@@ -0,0 +1,290 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+typedef function<bool(JsonStream&)> Step;
+
+class Entry: public JsonSerializable {
+public:
+    int32_t id;
+    string tag;
+
+    Entry(int32_t _id, const string& _tag): id(_id), tag(_tag) {}
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeInt32("id", id) && s.writeString("tag", tag);
+    }
+};
+
+static string text(const ByteBuffer& buffer) {
+    return string(reinterpret_cast<const char*>(buffer.getRawBytes()), buffer.getSize());
+}
+
+static void addText(ByteBuffer& buffer, const string& prefix) {
+    for (char c : prefix) buffer.addByte(static_cast<uint8_t>(c));
+}
+
+static void testArray() {
+    uint8_t mem[256];
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer, JsonDocument::Array);
+    CHECK(json.getDocument() == JsonDocument::Array);
+    CHECK(text(buffer) == "[");
+
+    // Keyed writes belong to objects, not to the top-level array
+    CHECK(!json.writeInt32("k", 1));
+    CHECK(!json.writeString("k", "v"));
+    CHECK(!json.writeObject("k", Entry(1, "a")));
+    CHECK(text(buffer) == "[");
+
+    CHECK(json.writeElement(7));
+    CHECK(json.writeElement("two"));
+    CHECK(json.writeElement(Entry(-3, "x\"y")));
+    CHECK(json.writeElement(vector<int>{ 1, 2 }));
+    CHECK(!json.writeBool("k", true));
+    CHECK(json.close());
+    CHECK(text(buffer) == "[7,\"two\",{\"id\":-3,\"tag\":\"x\\\"y\"},[1,2]]");
+    CHECK(json.getJson().isValid());
+
+    // Nothing is added once closed, and closing again is harmless
+    CHECK(!json.writeElement(8));
+    CHECK(json.close());
+    CHECK(text(buffer) == "[7,\"two\",{\"id\":-3,\"tag\":\"x\\\"y\"},[1,2]]");
+
+    // An empty array
+    CHECK(json.reset());
+    CHECK(json.close());
+    CHECK(text(buffer) == "[]");
+}
+
+static void testElementsNeedArray() {
+    uint8_t mem[64];
+    ByteBuffer buffer(mem, sizeof(mem));
+
+    const JsonDocument others[] = { JsonDocument::Object, JsonDocument::Lines };
+    for (JsonDocument document : others) {
+        buffer.clear();
+        JsonStream json(buffer, document);
+        CHECK(!json.writeElement(1));
+        CHECK(!json.writeElement("a"));
+        CHECK(text(buffer) == "{");
+        CHECK(json.writeInt32("n", 1));
+        CHECK(!json.writeElement(2));
+        CHECK(json.close());
+        CHECK(text(buffer) == "{\"n\":1}");
+    }
+}
+
+static void testLines() {
+    uint8_t mem[256];
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer, JsonDocument::Lines);
+
+    CHECK(json.writeInt32("a", 1));
+    CHECK(json.writeString("b", "x"));
+    CHECK(json.nextDocument());
+    CHECK(json.writeObject("e", Entry(2, "y")));
+
+    // An explicit close before the next document is not closed twice
+    CHECK(json.close());
+    CHECK(json.nextDocument());
+    CHECK(json.nextDocument());
+    CHECK(json.writeInt32("c", 3));
+    CHECK(json.close());
+    CHECK(!json.writeInt32("d", 4));
+
+    const string expected = "{\"a\":1,\"b\":\"x\"}\n"
+                            "{\"e\":{\"id\":2,\"tag\":\"y\"}}\n"
+                            "{}\n"
+                            "{\"c\":3}";
+    CHECK(text(buffer) == expected);
+
+    // Every line is a document of its own
+    size_t start = 0;
+    int lines = 0;
+    while (start <= expected.size()) {
+        size_t end = expected.find('\n', start);
+        if (end == string::npos) end = expected.size();
+        CHECK(JsonBuffer(expected.data() + start, end - start).isValid());
+        start = end + 1;
+        lines++;
+    }
+    CHECK(lines == 4);
+}
+
+// Only a Lines stream has a next document, and refusing one writes nothing
+static void testNextDocumentNeedsLines() {
+    uint8_t mem[64];
+    ByteBuffer buffer(mem, sizeof(mem));
+
+    const JsonDocument others[] = { JsonDocument::Object, JsonDocument::Array };
+    for (JsonDocument document : others) {
+        buffer.clear();
+        JsonStream json(buffer, document);
+        const string before = text(buffer);
+        CHECK(!json.nextDocument());
+        CHECK(text(buffer) == before);
+        CHECK(json.close());
+        CHECK(!json.nextDocument());
+        CHECK(text(buffer) == before + (document == JsonDocument::Array ? "]" : "}"));
+    }
+}
+
+// "}\n{" is written whole or not at all, and a refused next document leaves
+// the current one open or closed as it was
+static void testNextDocumentRollback() {
+    const string written = "{\"a\":1";
+
+    for (int isClosedFirst = 0; isClosedFirst <= 1; isClosedFirst++)
+    for (size_t capacity = written.size() + isClosedFirst;
+         capacity <= written.size() + 4; capacity++) {
+        vector<uint8_t> mem(capacity);
+        ByteBuffer buffer(mem.data(), capacity);
+        JsonStream json(buffer, JsonDocument::Lines);
+        CHECK(json.writeInt32("a", 1));
+        if (isClosedFirst) CHECK(json.close());
+        const string before = text(buffer);
+
+        const bool isNext = json.nextDocument();
+        CHECK(isNext == (capacity >= written.size() + 3));
+        if (isNext) {
+            CHECK(text(buffer) == written + "}\n{");
+            continue;
+        }
+
+        CHECK(text(buffer) == before);
+        if (isClosedFirst) {
+            CHECK(!json.writeInt32("b", 2));
+        } else {
+            CHECK(json.close() == (capacity >= written.size() + 1));
+        }
+    }
+}
+
+// reset() goes back to the size at construction, so bytes written before
+// the stream was made are kept, and keeps the mode for the next document
+static void testReset() {
+    const JsonDocument documents[] = { JsonDocument::Object, JsonDocument::Array,
+                                       JsonDocument::Lines };
+    for (JsonDocument document : documents) {
+        uint8_t mem[128];
+        ByteBuffer buffer(mem, sizeof(mem));
+        addText(buffer, "id:");
+        JsonStream json(buffer, document);
+
+        const bool isArray = document == JsonDocument::Array;
+        for (int round = 0; round < 3; round++) {
+            if (isArray) {
+                CHECK(json.writeElement(round));
+            } else {
+                CHECK(json.writeInt32("r", round));
+                if (document == JsonDocument::Lines) CHECK(json.nextDocument());
+            }
+            CHECK(json.close());
+
+            const string r = to_string(round);
+            const string expected = isArray ? "[" + r + "]" :
+                                    document == JsonDocument::Lines ? "{\"r\":" + r + "}\n{}" :
+                                    "{\"r\":" + r + "}";
+            CHECK(text(buffer) == "id:" + expected);
+
+            // Open or closed, the stream starts over after the prefix
+            CHECK(json.reset());
+            CHECK(json.getDocument() == document);
+            CHECK(text(buffer) == (isArray ? "id:[" : "id:{"));
+        }
+
+        // A reset mid-document drops what was written
+        CHECK(isArray ? json.writeElement("gone") : json.writeString("k", "gone"));
+        CHECK(json.reset());
+        CHECK(json.close());
+        CHECK(text(buffer) == (isArray ? "id:[]" : "id:{}"));
+    }
+
+    // Without room for the opening character, reset() fails
+    uint8_t mem[2];
+    ByteBuffer buffer(mem, sizeof(mem));
+    addText(buffer, "ab");
+    JsonStream json(buffer, JsonDocument::Array);
+    CHECK(!json.reset());
+    CHECK(text(buffer) == "ab");
+}
+
+// Replays `steps` at every capacity from one byte short of the reference
+// output up to one byte past it
+static void checkNearCapacity(const vector<Step>& steps, JsonDocument document,
+                              const string& prefix) {
+    vector<uint8_t> mem(4096);
+    ByteBuffer reference(mem.data(), mem.size());
+    addText(reference, prefix);
+    JsonStream json(reference, document);
+    for (const Step& step : steps) CHECK(step(json));
+    CHECK(json.close());
+    const string expected = text(reference);
+
+    for (size_t capacity = expected.size() - 1; capacity <= expected.size() + 1; capacity++) {
+        vector<uint8_t> small(capacity);
+        ByteBuffer buffer(small.data(), capacity);
+        addText(buffer, prefix);
+        JsonStream stream(buffer, document);
+
+        bool isWritten = true;
+        for (const Step& step : steps) isWritten = isWritten && step(stream);
+        isWritten = isWritten && stream.close();
+        CHECK(isWritten == (capacity >= expected.size()));
+
+        // Whatever was written is the start of the reference
+        CHECK(expected.compare(0, buffer.getSize(), text(buffer)) == 0);
+        if (isWritten) CHECK(text(buffer) == expected);
+    }
+}
+
+static void testNearCapacity(test::Random& rng) {
+    for (int trial = 0; trial < 100; trial++) {
+        const size_t count = 1 + rng.below(8);
+        const string prefix(rng.below(3), '#');
+
+        vector<Step> elements, lines;
+        for (size_t i = 0; i < count; i++) {
+            const int32_t id = static_cast<int32_t>(rng.next());
+            const string tag(rng.below(6), 't');
+            elements.push_back([=](JsonStream& s) { return s.writeElement(Entry(id, tag)); });
+
+            lines.push_back([=](JsonStream& s) { return s.writeInt32("id", id); });
+            if (rng.below(2)) lines.push_back([=](JsonStream& s) { return s.writeString("tag", tag); });
+            if (i + 1 < count) lines.push_back([](JsonStream& s) { return s.nextDocument(); });
+        }
+
+        checkNearCapacity(elements, JsonDocument::Array, prefix);
+        checkNearCapacity(lines, JsonDocument::Lines, prefix);
+    }
+}
+
+int main() {
+    test::Random rng(119);
+
+    testArray();
+    testElementsNeedArray();
+    testLines();
+    testNextDocumentNeedsLines();
+    testNextDocumentRollback();
+    testReset();
+    testNearCapacity(rng);
+
+    return test::finish("JSON documents");
+}
@@ -0,0 +1,213 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+typedef function<bool(JsonStream&)> Write;
+
+class Point: public JsonSerializable {
+public:
+    int64_t x;
+    string label;
+
+    Point(int64_t _x, const string& _label): x(_x), label(_label) {}
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeInt64("x", x) && s.writeString("label", label);
+    }
+};
+
+static int64_t randomInt(test::Random& rng) {
+    // Extremes, short values and full-width ones, of either sign
+    switch (rng.below(4)) {
+    case 0: return rng.below(2) ? INT64_MIN : INT64_MAX;
+    case 1: return static_cast<int64_t>(rng.below(200)) - 100;
+    case 2: return static_cast<int64_t>(rng.next() >> rng.below(64));
+    default: return static_cast<int64_t>(rng.next());
+    }
+}
+
+static string randomText(test::Random& rng) {
+    // Clean runs with quotes, backslashes and control characters mixed in
+    const char* pieces[] = { "a", "long clean text ", "\"", "\\", "\n", "\x01",
+                             "\x1f", "\xc3\xa9", "/" };
+    string text;
+    const size_t count = rng.below(12);
+    for (size_t i = 0; i < count; i++) text += pieces[rng.below(9)];
+    return text;
+}
+
+// One random keyed write, with the key itself of random length
+static Write randomField(test::Random& rng) {
+    const string key = string(1 + rng.below(12), 'k');
+    const int64_t value = randomInt(rng);
+    const string text = randomText(rng);
+
+    switch (rng.below(12)) {
+    case 0: return [=](JsonStream& s) { return s.writeUint8(key.c_str(), static_cast<uint8_t>(value)); };
+    case 1: return [=](JsonStream& s) { return s.writeInt8(key.c_str(), static_cast<int8_t>(value)); };
+    case 2: return [=](JsonStream& s) { return s.writeInt16(key.c_str(), static_cast<int16_t>(value)); };
+    case 3: return [=](JsonStream& s) { return s.writeUint32(key.c_str(), static_cast<uint32_t>(value)); };
+    case 4: return [=](JsonStream& s) { return s.writeInt64(key.c_str(), value); };
+    case 5: return [=](JsonStream& s) { return s.writeUint64(key.c_str(), static_cast<uint64_t>(value)); };
+    case 6: return [=](JsonStream& s) { return s.writeString(key.c_str(), text); };
+    case 7: return [=](JsonStream& s) { return s.writeBool(key.c_str(), value < 0); };
+    case 8: return [=](JsonStream& s) { return s.writeDouble(key.c_str(), static_cast<double>(value) / 7); };
+    case 9: return [=](JsonStream& s) { return s.writeObject(key.c_str(), Point(value, text)); };
+    case 10: return [=](JsonStream& s) {
+        return s.writeVector(key.c_str(), vector<int64_t>{ value, value / 3, 0 });
+    };
+    default: return [=](JsonStream& s) { return s.writeRawJson(key.c_str(), "[1,{}]", 6); };
+    }
+}
+
+// One random element of a top-level array
+static Write randomElement(test::Random& rng) {
+    const int64_t value = randomInt(rng);
+    const string text = randomText(rng);
+
+    switch (rng.below(4)) {
+    case 0: return [=](JsonStream& s) { return s.writeElement(value); };
+    case 1: return [=](JsonStream& s) { return s.writeElement(static_cast<uint16_t>(value)); };
+    case 2: return [=](JsonStream& s) { return s.writeElement(text); };
+    default: return [=](JsonStream& s) { return s.writeElement(Point(value, text)); };
+    }
+}
+
+// Replays `writes` into every capacity from one byte up to a little past the
+// full output. A write succeeds exactly when its reference output fits, a
+// failed one leaves the buffer as it was, and the bytes always match the
+// reference, whichever of the raw and checked paths wrote them.
+static void checkEveryCapacity(const vector<Write>& writes, JsonDocument document,
+                               const string& prefix) {
+    vector<uint8_t> mem(64 * 1024);
+    ByteBuffer reference(mem.data(), mem.size());
+    for (char c : prefix) reference.addByte(static_cast<uint8_t>(c));
+
+    JsonStream json(reference, document);
+    vector<size_t> ends(1, reference.getSize());
+    for (const Write& write : writes) {
+        CHECK(write(json));
+        ends.push_back(reference.getSize());
+    }
+    CHECK(json.close());
+    ends.push_back(reference.getSize());
+    const string expected(reinterpret_cast<const char*>(mem.data()), reference.getSize());
+    CHECK(JsonBuffer(expected.data() + prefix.size(),
+                     expected.size() - prefix.size()).isValid());
+
+    for (size_t capacity = prefix.size() + 1; capacity <= expected.size() + 2; capacity++) {
+        vector<uint8_t> small(capacity);
+        ByteBuffer buffer(small.data(), capacity);
+        for (char c : prefix) buffer.addByte(static_cast<uint8_t>(c));
+        JsonStream stream(buffer, document);
+
+        size_t done = 0;
+        while (done < writes.size() && writes[done](stream)) {
+            CHECK(ends[done + 1] <= capacity);
+            CHECK(buffer.getSize() == ends[done + 1]);
+            done++;
+        }
+
+        bool isClosed = false;
+        if (done < writes.size()) {
+            CHECK(ends[done + 1] > capacity);
+            CHECK(buffer.getSize() == ends[done]);
+        } else {
+            isClosed = stream.close();
+            CHECK(isClosed == (expected.size() <= capacity));
+        }
+
+        const size_t size = buffer.getSize();
+        CHECK(memcmp(small.data(), expected.data(), size) == 0);
+        if (isClosed) CHECK(size == expected.size());
+    }
+}
+
+static void testFields(test::Random& rng) {
+    for (int trial = 0; trial < 40; trial++) {
+        vector<Write> writes;
+        const size_t count = 1 + rng.below(16);
+        for (size_t i = 0; i < count; i++) writes.push_back(randomField(rng));
+
+        // Bytes already in the buffer shift every write against the capacity
+        checkEveryCapacity(writes, JsonDocument::Object, string(rng.below(3), '#'));
+    }
+}
+
+static void testElements(test::Random& rng) {
+    for (int trial = 0; trial < 40; trial++) {
+        vector<Write> writes;
+        const size_t count = 1 + rng.below(16);
+        for (size_t i = 0; i < count; i++) writes.push_back(randomElement(rng));
+
+        checkEveryCapacity(writes, JsonDocument::Array, string(rng.below(3), '#'));
+    }
+}
+
+static void testLongStrings(test::Random& rng) {
+    // Strings whose worst-case escaped length is far beyond the buffer, so
+    // they are escaped with checked writes
+    vector<Write> writes;
+    string clean(300, 'x');
+    string escaped;
+    for (int i = 0; i < 100; i++) escaped += (i % 10 == 0) ? '\x02' : 'y';
+    writes.push_back([=](JsonStream& s) { return s.writeString("clean", clean); });
+    writes.push_back([=](JsonStream& s) { return s.writeString("escaped", escaped); });
+    writes.push_back([=](JsonStream& s) { return s.writeUint64("n", UINT64_MAX); });
+    checkEveryCapacity(writes, JsonDocument::Object, "");
+
+    // Mixed with the random ones
+    for (int trial = 0; trial < 4; trial++) {
+        vector<Write> mixed = writes;
+        mixed.insert(mixed.begin() + rng.below(mixed.size()), randomField(rng));
+        checkEveryCapacity(mixed, JsonDocument::Object, "");
+    }
+}
+
+static void testExpectedText() {
+    uint8_t mem[256];
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer);
+
+    CHECK(json.writeInt64("min", INT64_MIN));
+    CHECK(json.writeUint64("max", UINT64_MAX));
+    CHECK(json.writeInt8("neg", -128));
+    CHECK(json.writeUint8("zero", 0));
+    CHECK(json.writeString("text", string("q\"b\\n\nc\x01\0", 9)));
+    CHECK(json.writeBool("no", false));
+    CHECK(json.close());
+
+    const string expected = "{\"min\":-9223372036854775808,\"max\":18446744073709551615,"
+                            "\"neg\":-128,\"zero\":0,"
+                            "\"text\":\"q\\\"b\\\\n\\nc\\u0001\\u0000\",\"no\":false}";
+    JsonBuffer out = json.getJson();
+    CHECK(string(out.data, out.length) == expected);
+    CHECK(out.isValid());
+}
+
+int main() {
+    test::Random rng(117);
+
+    testExpectedText();
+    testFields(rng);
+    testElements(rng);
+    testLongStrings(rng);
+
+    return test::finish("JSON output");
+}
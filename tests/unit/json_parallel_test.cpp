@@ -0,0 +1,213 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+class Item: public JsonSerializable {
+public:
+    uint32_t id;
+    string name;
+    vector<int16_t> values;
+
+    Item(): id(0) {}
+
+    bool operator==(const Item& other) const {
+        return id == other.id && name == other.name && values == other.values;
+    }
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeUint32("id", id) && s.writeString("name", name) &&
+               s.writeVector("values", values);
+    }
+
+    bool deserializeFromJson(JsonReader& r) override {
+        static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("id"),
+                                        SERDELITE_JSON_KEY("name"),
+                                        SERDELITE_JSON_KEY("values") };
+        size_t field;
+        while (r.nextField(KEYS, field)) {
+            switch (field) {
+            case 0: if (!r.readUint32(id)) return false; break;
+            case 1: if (!r.readString(name)) return false; break;
+            case 2: if (!r.readVector(values)) return false; break;
+            }
+        }
+        return !r.hasError();
+    }
+};
+
+static JsonBuffer view(const string& text) {
+    return JsonBuffer(text.data(), text.size());
+}
+
+// The raw text of each element, or "!" when the document is refused
+static vector<string> split(const string& text) {
+    vector<JsonBuffer> elements(1);
+    if (!JsonReader::splitArray(view(text), elements)) {
+        return elements.empty() ? vector<string>(1, "!") : vector<string>(1, "?");
+    }
+
+    vector<string> parts;
+    for (const JsonBuffer& element : elements)
+        parts.push_back(string(element.data, element.length));
+    return parts;
+}
+
+static void testSplitArray() {
+    CHECK(split("[]").empty());
+    CHECK(split(" [ \n ] \t").empty());
+    CHECK((split(" [ {\"a\":[1,\"]\"]} , \"x,y\" ,3,[[]], null ] ") ==
+           vector<string>{ "{\"a\":[1,\"]\"]}", "\"x,y\"", "3", "[[]]", "null" }));
+
+    // Trailing garbage, missing or doubled separators, unterminated arrays
+    const char* refused[] = { "[] x", "[],", "[1] ]", "[1,2] ,", "[1,2", "[1,",
+                              "[", "[1 2]", "[1,,2]", "[,1]", "[1,]", "{}", "1",
+                              "", "  ", "[\"a]", "[{\"a\":1]" };
+    for (const char* input : refused) CHECK(split(input) == vector<string>(1, "!"));
+
+    vector<JsonBuffer> elements(3);
+    CHECK(!JsonReader::splitArray(JsonBuffer(), elements) && elements.empty());
+}
+
+static string encode(const vector<Item>& items) {
+    vector<uint8_t> mem(items.size() * 96 + 16);
+    ByteBuffer buffer(mem.data(), mem.size());
+    JsonStream json(buffer, JsonDocument::Array);
+    for (const Item& item : items) {
+        if (!json.writeElement(item)) return string();
+    }
+    if (!json.close()) return string();
+
+    JsonBuffer out = json.getJson();
+    return string(out.data, out.length);
+}
+
+static void testMatchesSequential(test::Random& rng) {
+    const size_t counts[] = { 0, 1, 2, 7, 64, 1000 };
+
+    for (size_t count : counts) {
+        vector<Item> items(count);
+        for (size_t i = 0; i < count; i++) {
+            items[i].id = static_cast<uint32_t>(rng.next());
+            items[i].name = "item \"" + to_string(i) + "\"";
+            items[i].values.resize(rng.below(5));
+            for (int16_t& value : items[i].values) value = static_cast<int16_t>(rng.next());
+        }
+        const string text = encode(items);
+        CHECK(!text.empty());
+
+        JsonReader reader(view(text));
+        vector<Item> sequential;
+        CHECK(reader.readVector(sequential) && reader.isComplete());
+        CHECK(sequential == items);
+
+        // Every thread count, including more threads than elements
+        for (size_t threads = 0; threads <= 9; threads++) {
+            vector<Item> parallel(3);
+            CHECK(JsonReader::readArrayParallel(view(text), parallel, threads));
+            CHECK(parallel == sequential);
+        }
+
+        // forEachElement hands out every index exactly once
+        vector<atomic<int> > visits(count);
+        for (atomic<int>& visit : visits) visit.store(0);
+        CHECK(JsonReader::forEachElement(view(text),
+            [&visits](JsonReader& element, size_t index) {
+                visits[index]++;
+                return element.skipValue();
+            }, 4));
+        for (atomic<int>& visit : visits) CHECK(visit.load() == 1);
+    }
+}
+
+static void testFailures() {
+    vector<Item> items(200);
+    for (size_t i = 0; i < items.size(); i++) items[i].id = static_cast<uint32_t>(i);
+    const string text = encode(items);
+    const size_t badOffsets[] = { 0, 57, 199 };
+
+    // One element that does not decode fails the whole array, and `out` is kept
+    for (size_t bad : badOffsets)
+    for (size_t threads = 1; threads <= 8; threads++) {
+        vector<Item> copy = items;
+        copy[bad].name = "bad";
+        string broken = encode(copy);
+        const size_t at = broken.find("\"bad\"");
+        broken.replace(at, 5, "17");
+
+        vector<Item> out(2);
+        out[0].id = 1234;
+        CHECK(!JsonReader::readArrayParallel(view(broken), out, threads));
+        CHECK(out.size() == 2 && out[0].id == 1234);
+    }
+
+    // A handler that fails, or leaves part of its element unread
+    for (size_t threads = 1; threads <= 8; threads++) {
+        CHECK(!JsonReader::forEachElement(view(text),
+            [](JsonReader& element, size_t index) {
+                return index != 150 && element.skipValue();
+            }, threads));
+        CHECK(!JsonReader::forEachElement(view(text),
+            [](JsonReader& element, size_t index) {
+                return index == 20 ? element.beginObject() : element.skipValue();
+            }, threads));
+    }
+
+    CHECK(!JsonReader::forEachElement(view(text), JsonReader::ElementHandler()));
+    CHECK(!JsonReader::forEachElement(view("[1] x"),
+        [](JsonReader& element, size_t) { return element.skipValue(); }));
+}
+
+// An exception leaves no thread running and reaches the caller
+static void testExceptions() {
+    vector<Item> items(300);
+    const string text = encode(items);
+
+    for (size_t threads = 1; threads <= 8; threads++)
+    for (size_t thrower : { 0, 123, 299 }) {
+        atomic<size_t> calls(0);
+        string message;
+        try {
+            JsonReader::forEachElement(view(text),
+                [&calls, thrower](JsonReader& element, size_t index) -> bool {
+                    calls++;
+                    if (index == thrower) throw runtime_error("element " + to_string(index));
+                    return element.skipValue();
+                }, threads);
+        } catch (const runtime_error& e) {
+            message = e.what();
+        }
+        CHECK(message == "element " + to_string(thrower));
+        CHECK(calls.load() >= 1 && calls.load() <= items.size());
+    }
+
+    // Nothing is left behind for the next call
+    CHECK(JsonReader::forEachElement(view(text),
+        [](JsonReader& element, size_t) { return element.skipValue(); }, 4));
+}
+
+int main() {
+    test::Random rng(116);
+
+    testSplitArray();
+    testMatchesSequential(rng);
+    testFailures();
+    testExceptions();
+
+    return test::finish("parallel arrays");
+}
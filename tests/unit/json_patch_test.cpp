@@ -0,0 +1,204 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+class Position: public JsonSerializable {
+public:
+    int32_t x, y;
+
+    Position(): x(0), y(0) {}
+    Position(int32_t _x, int32_t _y): x(_x), y(_y) {}
+
+    bool operator==(const Position& other) const {
+        return x == other.x && y == other.y;
+    }
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeInt32("x", x) && s.writeInt32("y", y);
+    }
+};
+
+class Player: public JsonSerializable, public Trackable {
+    SERDELITE_TRACKED_FIELD(uint32_t, hp, Hp, 0);
+    SERDELITE_TRACKED_FIELD(string, name, Name, 1);
+    SERDELITE_TRACKED_FIELD(Position, pos, Pos, 2);
+    SERDELITE_TRACKED_FIELD(uint32_t, ratio, Ratio, 3);
+
+public:
+    Player(): Trackable(4), hp(100), name("ann"), ratio(7) {}
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeUint32("hp", hp) &&
+               s.writeString("name", name) &&
+               s.writeObject("pos", pos) &&
+               s.writeUint32("a/b~c", ratio);
+    }
+};
+
+static string text(const JsonStream& json) {
+    JsonBuffer out = json.getJson();
+    return string(out.data, out.length);
+}
+
+static void testMergePatch() {
+    uint8_t mem[256];
+    Player player;
+
+    // The first patch carries every field
+    {
+        ByteBuffer buffer(mem, sizeof(mem));
+        JsonStream json(buffer);
+        CHECK(json.writeMergePatch(player, player.getDirtyMask()));
+        CHECK(text(json) == "{\"hp\":100,\"name\":\"ann\",\"pos\":{\"x\":0,\"y\":0},"
+                            "\"a/b~c\":7}");
+        CHECK(json.getJson().isValid());
+        CHECK(player.getDirtyMask().isClean());
+    }
+
+    // Nothing changed, or only to the same value
+    player.setHp(100);
+    {
+        ByteBuffer buffer(mem, sizeof(mem));
+        JsonStream json(buffer);
+        CHECK(json.writeMergePatch(player, player.getDirtyMask()));
+        CHECK(text(json) == "{}");
+    }
+
+    // Only the modified fields; nested objects are sent whole
+    player.setHp(90);
+    player.setPos(Position(3, -4));
+    {
+        ByteBuffer buffer(mem, sizeof(mem));
+        JsonStream json(buffer);
+        CHECK(json.writeMergePatch(player, player.getDirtyMask()));
+        CHECK(text(json) == "{\"hp\":90,\"pos\":{\"x\":3,\"y\":-4}}");
+        CHECK(json.getJson().isValid());
+    }
+
+    // A stream that already holds fields is refused, and the mask kept
+    player.setName("bo");
+    {
+        ByteBuffer buffer(mem, sizeof(mem));
+        JsonStream json(buffer);
+        CHECK(json.writeUint8("seq", 1));
+        CHECK(!json.writeMergePatch(player, player.getDirtyMask()));
+        CHECK(player.getDirtyMask().isDirty(1));
+        CHECK(json.close());
+        CHECK(text(json) == "{\"seq\":1}");
+    }
+}
+
+static void testJsonPatch() {
+    uint8_t mem[512];
+    Player first, second;
+
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer, JsonDocument::Array);
+
+    // Keys become JSON Pointer tokens, `~` as `~0` and `/` as `~1`
+    CHECK(json.writeJsonPatch(first, first.getDirtyMask(), "/players/0"));
+    second.getDirtyMask().clean();
+    second.setName("cy");
+    CHECK(json.writeJsonPatch(second, second.getDirtyMask(), "/players/1"));
+
+    // Nothing dirty writes nothing
+    CHECK(json.writeJsonPatch(second, second.getDirtyMask(), "/players/1"));
+    CHECK(json.close());
+
+    CHECK(text(json) ==
+          "[{\"op\":\"add\",\"path\":\"/players/0/hp\",\"value\":100},"
+          "{\"op\":\"add\",\"path\":\"/players/0/name\",\"value\":\"ann\"},"
+          "{\"op\":\"add\",\"path\":\"/players/0/pos\",\"value\":{\"x\":0,\"y\":0}},"
+          "{\"op\":\"add\",\"path\":\"/players/0/a~1b~0c\",\"value\":7},"
+          "{\"op\":\"add\",\"path\":\"/players/1/name\",\"value\":\"cy\"}]");
+    CHECK(json.getJson().isValid());
+    CHECK(first.getDirtyMask().isClean());
+
+    // The root object, and a stream that is not an array
+    Player root;
+    root.getDirtyMask().clean();
+    root.setHp(1);
+    ByteBuffer rootBuffer(mem, sizeof(mem));
+    JsonStream rootJson(rootBuffer, JsonDocument::Array);
+    CHECK(rootJson.writeJsonPatch(root, root.getDirtyMask()));
+    CHECK(rootJson.close());
+    CHECK(text(rootJson) == "[{\"op\":\"add\",\"path\":\"/hp\",\"value\":1}]");
+
+    root.setHp(2);
+    ByteBuffer objectBuffer(mem, sizeof(mem));
+    JsonStream objectJson(objectBuffer);
+    CHECK(!objectJson.writeJsonPatch(root, root.getDirtyMask()));
+    CHECK(root.getDirtyMask().isDirty(0));
+}
+
+// Every capacity short of the full patch fails, leaves the buffer and the
+// mask as they were, and leaves the stream usable; an exact fit succeeds
+static void testRollback() {
+    uint8_t mem[512];
+
+    Player reference;
+    ByteBuffer fullBuffer(mem, sizeof(mem));
+    JsonStream fullJson(fullBuffer);
+    CHECK(fullJson.writeMergePatch(reference, reference.getDirtyMask()));
+    const size_t mergeSize = fullBuffer.getSize();
+
+    for (size_t capacity = 2; capacity <= mergeSize; capacity++) {
+        Player player;
+        ByteBuffer buffer(mem, capacity);
+        JsonStream json(buffer);
+        if (capacity == mergeSize) {
+            CHECK(json.writeMergePatch(player, player.getDirtyMask()));
+            CHECK(player.getDirtyMask().isClean());
+            continue;
+        }
+        CHECK(!json.writeMergePatch(player, player.getDirtyMask()));
+        CHECK(buffer.getSize() == 1);
+        CHECK(player.getDirtyMask().getBits() == 0xF);
+        CHECK(json.close());
+        CHECK(text(json) == "{}");
+    }
+
+    Player patched;
+    ByteBuffer patchBuffer(mem, sizeof(mem));
+    JsonStream patchJson(patchBuffer, JsonDocument::Array);
+    CHECK(patchJson.writeJsonPatch(patched, patched.getDirtyMask(), "/p"));
+    const size_t patchSize = patchBuffer.getSize();
+
+    for (size_t capacity = 2; capacity <= patchSize; capacity++) {
+        Player player;
+        ByteBuffer buffer(mem, capacity);
+        JsonStream json(buffer, JsonDocument::Array);
+        if (capacity == patchSize) {
+            CHECK(json.writeJsonPatch(player, player.getDirtyMask(), "/p"));
+            CHECK(player.getDirtyMask().isClean());
+            continue;
+        }
+        CHECK(!json.writeJsonPatch(player, player.getDirtyMask(), "/p"));
+        CHECK(buffer.getSize() == 1);
+        CHECK(player.getDirtyMask().getBits() == 0xF);
+        CHECK(json.close());
+        CHECK(text(json) == "[]");
+    }
+}
+
+int main() {
+    testMergePatch();
+    testJsonPatch();
+    testRollback();
+
+    return test::finish("JSON patches");
+}
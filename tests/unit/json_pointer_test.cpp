@@ -0,0 +1,184 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+// The raw text `pointer` selects, or "!" when it does not resolve
+static string lookup(const string& text, const char* pointer) {
+    // An exact-size copy, so reads past the end are caught
+    vector<char> copy(text.begin(), text.end());
+    JsonBuffer json(copy.data(), copy.size());
+    JsonBuffer value;
+    if (!json.find(pointer, value)) return value.data ? "?" : "!";
+    return string(value.data, value.length);
+}
+
+static void testTokens() {
+    const string text = " { \"player\" : { \"stats\": {\"xp\": 1200, \"tags\": [\"a\", "
+                        "{\"k\": null}]} },\"a/b\":1, \"m~n\":2, \"\":3, "
+                        "\"~01\":4, \"s\":\"x\\\"y\" } ";
+
+    CHECK(lookup(text, "/player/stats/xp") == "1200");
+    CHECK(lookup(text, "/player/stats/tags/1") == "{\"k\": null}");
+    CHECK(lookup(text, "/player/stats/tags/1/k") == "null");
+    CHECK(lookup(text, "/s") == "\"x\\\"y\"");
+    CHECK(lookup(text, "") == text.substr(1, text.size() - 2));
+
+    // `~1` is `/` and `~0` is `~`, decoded left to right
+    CHECK(lookup(text, "/a~1b") == "1");
+    CHECK(lookup(text, "/m~0n") == "2");
+    CHECK(lookup(text, "/~001") == "4");
+    CHECK(lookup(text, "/~01") == "!");
+    CHECK(lookup(text, "/a/b") == "!");
+    CHECK(lookup(text, "/m~2n") == "!");
+    CHECK(lookup(text, "/m~") == "!");
+
+    // The empty key, and pointers that are not pointers
+    CHECK(lookup(text, "/") == "3");
+    CHECK(lookup(text, "player") == "!");
+    CHECK(lookup(text, "/player/stats/xp/0") == "!");
+    CHECK(lookup(text, "/missing") == "!");
+}
+
+static void testEscapedKeys() {
+    const string text = "{\"\\u0061b\":1, \"caf\\u00e9\":2, \"\\ud83d\\ude00\":3, "
+                        "\"x\\/y\":4, \"t\\tab\":5, \"q\\\"\":6, \"bad\\ud800\":7}";
+
+    CHECK(lookup(text, "/ab") == "1");
+    CHECK(lookup(text, "/caf\xc3\xa9") == "2");
+    CHECK(lookup(text, "/\xf0\x9f\x98\x80") == "3");
+    CHECK(lookup(text, "/x~1y") == "4");
+    CHECK(lookup(text, "/t\tab") == "5");
+    CHECK(lookup(text, "/q\"") == "6");
+
+    // Raw escapes are never compared as text, and a lone surrogate matches nothing
+    CHECK(lookup(text, "/\\u0061b") == "!");
+    CHECK(lookup(text, "/caf") == "!");
+    CHECK(lookup(text, "/bad") == "!");
+}
+
+static void testDuplicatesAndOverlaps() {
+    // The first occurrence of a key wins, even when only a later one has the path
+    CHECK(lookup("{\"k\":1,\"k\":2}", "/k") == "1");
+    CHECK(lookup("{\"k\":{\"a\":1},\"k\":{\"a\":2}}", "/k/a") == "1");
+    CHECK(lookup("{\"k\":{\"b\":1},\"k\":{\"a\":2}}", "/k/a") == "!");
+    CHECK(lookup("{\"k\":{\"b\":1},\"\\u006b\":{\"a\":2}}", "/k/a") == "!");
+
+    // A pointer and its own prefixes resolve together, in any order
+    const string text = "{\"a\":{\"b\":[10,{\"c\":true}]},\"z\":0}";
+    const char* pointers[] = { "/a/b/1/c", "/a", "", "/a/b", "/a/b/1", "/a/b/0",
+                               "/z", "/a" };
+    const char* expected[] = { "true", "{\"b\":[10,{\"c\":true}]}", text.c_str(),
+                               "[10,{\"c\":true}]", "{\"c\":true}", "10", "0",
+                               "{\"b\":[10,{\"c\":true}]}" };
+    const size_t count = sizeof(pointers) / sizeof(pointers[0]);
+
+    JsonBuffer json(text.data(), text.size());
+    JsonBuffer values[count];
+    CHECK(json.find(pointers, count, values) == count);
+    for (size_t i = 0; i < count; i++)
+        CHECK(string(values[i].data, values[i].length) == expected[i]);
+}
+
+static void testArrayIndices() {
+    const string text = "[\"a\", [], {}, 3, 4, 5, 6, 7, 8, 9, 10, 11]";
+
+    CHECK(lookup(text, "/0") == "\"a\"");
+    CHECK(lookup(text, "/1") == "[]");
+    CHECK(lookup(text, "/2") == "{}");
+    CHECK(lookup(text, "/10") == "10");
+    CHECK(lookup(text, "/11") == "11");
+
+    // No leading zeros, signs, the append token or indices past the end
+    const char* refused[] = { "/00", "/01", "/010", "/-", "/+1", "/-1", "/1a",
+                              "/ 1", "/12", "/", "/99999999999999999999999" };
+    for (const char* pointer : refused) CHECK(lookup(text, pointer) == "!");
+
+    CHECK(lookup("[]", "/0") == "!");
+    CHECK(lookup("[[0,[1,[2]]]]", "/0/1/1/0") == "2");
+}
+
+static void testPointerLimit() {
+    string text = "{";
+    vector<string> names;
+    for (size_t i = 0; i <= JsonBuffer::MAX_POINTERS; i++) {
+        names.push_back("/k" + to_string(i));
+        text += (i ? ",\"k" : "\"k") + to_string(i) + "\":" + to_string(i * 7);
+    }
+    text += "}";
+
+    vector<const char*> pointers;
+    for (const string& name : names) pointers.push_back(name.c_str());
+
+    JsonBuffer json(text.data(), text.size());
+    vector<JsonBuffer> values(pointers.size());
+    CHECK(json.find(pointers.data(), JsonBuffer::MAX_POINTERS, values.data()) ==
+          JsonBuffer::MAX_POINTERS);
+    for (size_t i = 0; i < JsonBuffer::MAX_POINTERS; i++)
+        CHECK(string(values[i].data, values[i].length) == to_string(i * 7));
+
+    // One more is refused as a whole
+    vector<JsonBuffer> none(pointers.size());
+    CHECK(json.find(pointers.data(), pointers.size(), none.data()) == 0);
+    for (const JsonBuffer& value : none) CHECK(value.data == nullptr);
+
+    // Missing and null pointers count as unresolved and leave an empty view
+    const char* mixed[] = { "/k1", nullptr, "/nope", "k2", "/k2" };
+    JsonBuffer mixedValues[5];
+    CHECK(json.find(mixed, 5, mixedValues) == 2);
+    CHECK(mixedValues[1].data == nullptr && mixedValues[2].data == nullptr);
+    CHECK(mixedValues[3].data == nullptr);
+    CHECK(string(mixedValues[4].data, mixedValues[4].length) == "14");
+}
+
+// Strings long enough to cross vector blocks, with escaped quotes and brackets
+// at every offset, are skipped without losing track of the value after them
+static void testSkipping(test::Random& rng) {
+    for (size_t len = 0; len < 80; len++) {
+        for (int trial = 0; trial < 4; trial++) {
+            string filler;
+            for (size_t i = 0; i < len; i++) {
+                const char* pieces[] = { "x", "\\\"", "\\\\", "{", "]", "[" };
+                filler += pieces[rng.below(6)];
+            }
+
+            const string text = "{\"skip\":\"" + filler + "\",\"nested\":[\"" + filler +
+                                "\",{\"" + filler + "\":1}],\"want\":\"" + filler + "\"}";
+            CHECK(lookup(text, "/want") == "\"" + filler + "\"");
+            CHECK(lookup(text, "/nested/1") == "{\"" + filler + "\":1}");
+        }
+    }
+
+    // Truncated documents never read past the end
+    const string text = "{\"a\":[1,\"x\\\"\",{\"b\":2}],\"c\":\"d\"}";
+    for (size_t len = 0; len < text.size(); len++) {
+        const string cut = text.substr(0, len);
+        lookup(cut, "/c");
+        lookup(cut, "/a/2/b");
+    }
+}
+
+int main() {
+    test::Random rng(113);
+
+    testTokens();
+    testEscapedKeys();
+    testDuplicatesAndOverlaps();
+    testArrayIndices();
+    testPointerLimit();
+    testSkipping(rng);
+
+    return test::finish("JSON pointers");
+}
@@ -0,0 +1,356 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+class Position: public JsonSerializable {
+public:
+    int32_t x, y;
+
+    Position(): x(0), y(0) {}
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeInt32("x", x) && s.writeInt32("y", y);
+    }
+
+    bool deserializeFromJson(JsonReader& r) override {
+        static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("x"),
+                                        SERDELITE_JSON_KEY("y") };
+        size_t field;
+        while (r.nextField(KEYS, field)) {
+            switch (field) {
+            case 0: if (!r.readInt32(x)) return false; break;
+            case 1: if (!r.readInt32(y)) return false; break;
+            }
+        }
+        return !r.hasError();
+    }
+};
+
+class Player: public JsonSerializable {
+public:
+    uint32_t hp;
+    string name;
+    Position pos;
+    vector<string> tags;
+    vector<vector<int16_t> > grid;
+    double speed;
+    bool isAlive;
+
+    Player(): hp(0), speed(0), isAlive(false) {}
+
+protected:
+    bool serializeToJson(JsonStream& s) const override {
+        return s.writeUint32("hp", hp) && s.writeString("name", name) &&
+               s.writeObject("pos", pos) && s.writeVector("tags", tags) &&
+               s.writeVector("grid", grid) && s.writeDouble("speed", speed) &&
+               s.writeBool("isAlive", isAlive);
+    }
+
+    bool deserializeFromJson(JsonReader& r) override {
+        static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("hp"),
+                                        SERDELITE_JSON_KEY("name"),
+                                        SERDELITE_JSON_KEY("pos"),
+                                        SERDELITE_JSON_KEY("tags"),
+                                        SERDELITE_JSON_KEY("grid"),
+                                        SERDELITE_JSON_KEY("speed"),
+                                        SERDELITE_JSON_KEY("isAlive") };
+        size_t field;
+        while (r.nextField(KEYS, field)) {
+            switch (field) {
+            case 0: if (!r.readUint32(hp)) return false; break;
+            case 1: if (!r.readString(name)) return false; break;
+            case 2: if (!r.readObject(pos)) return false; break;
+            case 3: if (!r.readVector(tags)) return false; break;
+            case 4: if (!r.readVector(grid)) return false; break;
+            case 5: if (!r.readDouble(speed)) return false; break;
+            case 6: if (!r.readBool(isAlive)) return false; break;
+            }
+        }
+        return !r.hasError();
+    }
+};
+
+// Decodes `text` from an exact-size copy, so reads past the end are caught
+static bool decode(const string& text, Player& player) {
+    vector<char> copy(text.begin(), text.end());
+    JsonReader reader(static_cast<const char*>(copy.data()), copy.size());
+    return player.fromJson(reader) && reader.isComplete();
+}
+
+static void testRoundTrip() {
+    Player player;
+    player.hp = 4000000000u;
+    player.name = "Ann \"the\" \\ \xc3\xa9\n";
+    player.pos.x = -7;
+    player.pos.y = 2147483647;
+    player.tags = { "", "a,b", "}]" };
+    player.grid = { {}, { -32768, 32767 } };
+    player.speed = -0.125;
+    player.isAlive = true;
+
+    uint8_t mem[512];
+    ByteBuffer buffer(mem, sizeof(mem));
+    JsonStream json(buffer);
+    CHECK(player.toJson(json));
+    CHECK(json.close());
+    JsonBuffer out = json.getJson();
+
+    Player back;
+    CHECK(decode(string(out.data, out.length), back));
+    CHECK(back.hp == player.hp);
+    CHECK(back.name == player.name);
+    CHECK(back.pos.x == player.pos.x && back.pos.y == player.pos.y);
+    CHECK(back.tags == player.tags);
+    CHECK(back.grid == player.grid);
+    CHECK(back.speed == player.speed);
+    CHECK(back.isAlive);
+
+    // Every truncation fails without reading past the end
+    for (size_t len = 0; len < out.length; len++) {
+        Player cut;
+        CHECK(!decode(string(out.data, len), cut));
+    }
+}
+
+static void testEscapedKeys() {
+    Player player;
+    CHECK(decode("{\"h\\u0070\":5,\"n\\u0061m\\u0065\":\"x\",\"\\u0070os\":{\"\\u0078\":1}}",
+                 player));
+    CHECK(player.hp == 5 && player.name == "x" && player.pos.x == 1);
+
+    // Escapes that decode to other names, or keys that only share a
+    // signature (length, first and last character), do not match
+    Player other;
+    CHECK(decode("{\"h\\u0071\":5,\"nxme\":\"x\",\"h\\\"p\":1,\"hP\":2}", other));
+    CHECK(other.hp == 0 && other.name.empty());
+
+    // Keys that need escapes themselves
+    static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("a\"b"),
+                                    SERDELITE_JSON_KEY("\xf0\x9f\x98\x80"),
+                                    SERDELITE_JSON_KEY("a/b") };
+    const string text = "{\"a\\\"b\":1,\"\\ud83d\\ude00\":2,\"a\\/b\":3}";
+
+    JsonReader reader(text.data(), text.size());
+    size_t field;
+    size_t seen = 0;
+    CHECK(reader.beginObject());
+    while (reader.nextField(KEYS, field)) {
+        uint8_t value;
+        CHECK(reader.readUint8(value) && value == field + 1);
+        seen++;
+    }
+    CHECK(!reader.hasError() && reader.isComplete());
+    CHECK(seen == 3);
+
+    // Escaped keys are matched up to 128 characters as written
+    const string shortKey(123, 'k');
+    const string longKey(124, 'k');
+    const JsonKey longKeys[] = {
+        { shortKey.c_str(), shortKey.size(), jsonKeySignature(shortKey.c_str(), shortKey.size()) },
+        { longKey.c_str(), longKey.size(), jsonKeySignature(longKey.c_str(), longKey.size()) }
+    };
+    const string longText = "{\"" + string(123, 'k') + "\\u006b\":2,\"" +
+                            string(122, 'k') + "\\u006b\":1}";
+
+    JsonReader longReader(longText.data(), longText.size());
+    uint8_t value;
+    CHECK(longReader.beginObject());
+    CHECK(longReader.nextField(longKeys, 2, field) && field == 0);
+    CHECK(longReader.readUint8(value) && value == 1);
+    CHECK(!longReader.nextField(longKeys, 2, field));
+    CHECK(longReader.isComplete());
+}
+
+static void testUnknownMembers() {
+    // Skipped values may hold brackets, quotes and commas inside strings
+    Player player;
+    CHECK(decode(" { \"junk\" : {\"a\":[1,\"]}\",{\"}\":2}],\"b\":\"\\\"}\"} ,"
+                 "\"hp\":3, \"more\":[[],[{}]], \"n\":null, \"f\":-1.5e-3,"
+                 "\"t\":true, \"name\":\"z\" } ", player));
+    CHECK(player.hp == 3 && player.name == "z");
+
+    // A matched value that is not read is skipped by the next call
+    static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("a"), SERDELITE_JSON_KEY("b") };
+    const string text = "{\"a\":{\"deep\":[1,2]},\"b\":7}";
+    JsonReader reader(text.data(), text.size());
+    size_t field;
+    uint8_t value = 0;
+    CHECK(reader.beginObject());
+    CHECK(reader.nextField(KEYS, field) && field == 0);
+    CHECK(reader.nextField(KEYS, field) && field == 1);
+    CHECK(reader.readUint8(value) && value == 7);
+    CHECK(!reader.nextField(KEYS, field));
+    CHECK(reader.isComplete());
+
+    // endObject skips whatever is left
+    JsonReader rest(text.data(), text.size());
+    CHECK(rest.beginObject() && rest.endObject() && rest.isComplete());
+
+    // Malformed separators are errors, not unknown members
+    const char* malformed[] = { "{\"hp\":1 \"name\":\"x\"}", "{\"hp\" 1}", "{hp:1}",
+                                "{\"hp\":1,}", "{,\"hp\":1}", "{\"hp\":1", "[1]" };
+    for (const char* input : malformed) {
+        Player bad;
+        CHECK(!decode(input, bad));
+    }
+}
+
+template <typename T>
+static bool readsAs(const string& text, bool (JsonReader::*read)(T&), T expected) {
+    vector<char> copy(text.begin(), text.end());
+    JsonReader reader(static_cast<const char*>(copy.data()), copy.size());
+    T value = T();
+    return (reader.*read)(value) && reader.isComplete() && value == expected;
+}
+
+template <typename T>
+static bool refuses(const string& text, bool (JsonReader::*read)(T&)) {
+    vector<char> copy(text.begin(), text.end());
+    JsonReader reader(static_cast<const char*>(copy.data()), copy.size());
+    T value = T(42);
+    return !(reader.*read)(value) && reader.hasError() && value == T(42);
+}
+
+static void testIntegerRanges() {
+    CHECK(readsAs<int8_t>("-128", &JsonReader::readInt8, -128));
+    CHECK(readsAs<int8_t>("127", &JsonReader::readInt8, 127));
+    CHECK(refuses<int8_t>("128", &JsonReader::readInt8));
+    CHECK(refuses<int8_t>("-129", &JsonReader::readInt8));
+    CHECK(readsAs<uint8_t>("255", &JsonReader::readUint8, 255));
+    CHECK(refuses<uint8_t>("256", &JsonReader::readUint8));
+    CHECK(readsAs<int16_t>("-32768", &JsonReader::readInt16, -32768));
+    CHECK(refuses<int16_t>("32768", &JsonReader::readInt16));
+    CHECK(readsAs<uint16_t>("65535", &JsonReader::readUint16, 65535));
+    CHECK(refuses<uint16_t>("65536", &JsonReader::readUint16));
+    CHECK(readsAs<int32_t>("-2147483648", &JsonReader::readInt32, INT32_MIN));
+    CHECK(refuses<int32_t>("2147483648", &JsonReader::readInt32));
+    CHECK(readsAs<uint32_t>("4294967295", &JsonReader::readUint32, UINT32_MAX));
+    CHECK(refuses<uint32_t>("4294967296", &JsonReader::readUint32));
+    CHECK(readsAs<int64_t>("-9223372036854775808", &JsonReader::readInt64, INT64_MIN));
+    CHECK(readsAs<int64_t>("9223372036854775807", &JsonReader::readInt64, INT64_MAX));
+    CHECK(refuses<int64_t>("9223372036854775808", &JsonReader::readInt64));
+    CHECK(refuses<int64_t>("-9223372036854775809", &JsonReader::readInt64));
+
+    // 64-bit overflow is caught before it wraps
+    CHECK(readsAs<uint64_t>("18446744073709551615", &JsonReader::readUint64, UINT64_MAX));
+    CHECK(refuses<uint64_t>("18446744073709551616", &JsonReader::readUint64));
+    CHECK(refuses<uint64_t>("18446744073709551620", &JsonReader::readUint64));
+    CHECK(refuses<uint64_t>("99999999999999999999", &JsonReader::readUint64));
+    CHECK(refuses<int64_t>("-18446744073709551616", &JsonReader::readInt64));
+
+    // Leading zeros, signs and non-integers
+    CHECK(readsAs<uint8_t>(" 0 ", &JsonReader::readUint8, 0));
+    CHECK(readsAs<int8_t>("-0", &JsonReader::readInt8, 0));
+    CHECK(refuses<uint8_t>("-0", &JsonReader::readUint8));
+    CHECK(refuses<uint64_t>("-1", &JsonReader::readUint64));
+    const char* refused[] = { "00", "01", "-01", "+1", "-", "", " ", "1.0", "1e2",
+                              "1E2", "0.5", "-.5", "x", "\"1\"", "true", "null" };
+    for (const char* input : refused) CHECK(refuses<int32_t>(input, &JsonReader::readInt32));
+
+    // The digits before anything else are the value; the rest is left unread
+    const string text = "12x";
+    JsonReader reader(text.data(), text.size());
+    uint8_t value;
+    CHECK(reader.readUint8(value) && value == 12);
+    CHECK(!reader.isComplete() && !reader.hasError());
+}
+
+static void testOtherValues() {
+    CHECK(readsAs<double>("-2.5e3", &JsonReader::readDouble, -2500.0));
+    CHECK(readsAs<double>("0", &JsonReader::readDouble, 0.0));
+    CHECK(readsAs<float>("0.5", &JsonReader::readFloat, 0.5f));
+    CHECK(readsAs<bool>("false", &JsonReader::readBool, false));
+    CHECK(refuses<double>("1.", &JsonReader::readDouble));
+    CHECK(refuses<double>(".5", &JsonReader::readDouble));
+    CHECK(refuses<double>("1e", &JsonReader::readDouble));
+    CHECK(refuses<double>("NaN", &JsonReader::readDouble));
+    CHECK(refuses<double>(string(200, '1'), &JsonReader::readDouble));
+
+    // null stands for the non-finite values JsonStream writes as null
+    const string nullText = "null";
+    JsonReader nullReader(nullText.data(), nullText.size());
+    double real = 0;
+    CHECK(nullReader.readDouble(real) && isnan(real));
+
+    // Fixed-size strings keep room for the terminator
+    const string text = "[\"abcd\",\"ab\\u0063d\",\"abcd\"]";
+    JsonReader reader(text.data(), text.size());
+    char dest[5];
+    bool isFirst = true;
+    CHECK(reader.beginArray());
+    CHECK(reader.nextElement(isFirst) && reader.readString(dest, 5) && strcmp(dest, "abcd") == 0);
+    CHECK(reader.nextElement(isFirst) && reader.readString(dest, 5) && strcmp(dest, "abcd") == 0);
+    CHECK(reader.nextElement(isFirst) && !reader.readString(dest, 4));
+
+    // A vector that fails part way is left unchanged
+    const string numbers = "[1,2,300]";
+    JsonReader vectorReader(numbers.data(), numbers.size());
+    vector<uint8_t> kept(1, 9);
+    CHECK(!vectorReader.readVector(kept));
+    CHECK(kept.size() == 1 && kept[0] == 9);
+}
+
+static void testStickyErrors() {
+    const string text = "{\"hp\":300,\"name\":\"x\"}";
+    static const JsonKey KEYS[] = { SERDELITE_JSON_KEY("hp"), SERDELITE_JSON_KEY("name") };
+
+    JsonReader reader(text.data(), text.size());
+    size_t field;
+    uint8_t hp = 1;
+    string name = "kept";
+    JsonBuffer raw;
+
+    CHECK(reader.beginObject());
+    CHECK(reader.nextField(KEYS, field) && field == 0);
+    CHECK(!reader.readUint8(hp));
+    CHECK(reader.hasError() && !reader.isComplete());
+
+    // Every later call fails and leaves its destination alone
+    CHECK(!reader.nextField(KEYS, field));
+    CHECK(!reader.readString(name) && name == "kept");
+    CHECK(!reader.readRawJson(raw) && raw.data == nullptr);
+    CHECK(!reader.skipValue());
+    CHECK(!reader.readNull());
+    CHECK(!reader.beginObject() && !reader.beginArray());
+    CHECK(!reader.endObject());
+    bool isFirst = true;
+    CHECK(!reader.nextElement(isFirst));
+    CHECK(hp == 1 && reader.hasError());
+
+    // A nested object that fails fails its parent
+    Player player;
+    CHECK(!decode("{\"pos\":{\"x\":1.5},\"hp\":1}", player));
+    CHECK(player.hp == 0);
+
+    // A missing document starts out in error
+    const JsonBuffer missing;
+    JsonReader empty(missing);
+    CHECK(empty.hasError() && !empty.beginObject());
+}
+
+int main() {
+    testRoundTrip();
+    testEscapedKeys();
+    testUnknownMembers();
+    testIntegerRanges();
+    testOtherValues();
+    testStickyErrors();
+
+    return test::finish("JSON reader");
+}
@@ -0,0 +1,189 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+// An escape sequence and the UTF-8 it decodes to
+struct Escape {
+    const char* escaped;
+    const char* decoded;
+    size_t decodedLength;
+};
+
+static const Escape ESCAPES[] = {
+    { "\\n", "\n", 1 },
+    { "\\\"", "\"", 1 },
+    { "\\\\", "\\", 1 },
+    { "\\/", "/", 1 },
+    { "\\t", "\t", 1 },
+    { "\\u0041", "A", 1 },
+    { "\\u0000", "\0", 1 },
+    { "\\u00e9", "\xc3\xa9", 2 },
+    { "\\u20AC", "\xe2\x82\xac", 3 },
+    { "\\ud83d\\ude00", "\xf0\x9f\x98\x80", 4 },
+    { "\\uDBFF\\uDFFF", "\xf4\x8f\xbf\xbf", 4 }
+};
+static const size_t ESCAPE_COUNT = sizeof(ESCAPES) / sizeof(ESCAPES[0]);
+
+// Decodes `escaped` from an exact-size copy, either into a separate exact-size
+// buffer or in place; returns "!" when decoding fails
+static string decode(const string& escaped, bool isInPlace) {
+    vector<char> src(escaped.begin(), escaped.end());
+    vector<char> separate(escaped.size());
+
+    // Empty vectors may have no storage, and unescape refuses null pointers
+    src.reserve(1);
+    separate.reserve(1);
+    char* dest = isInPlace ? src.data() : separate.data();
+
+    size_t len = 0;
+    if (!JsonReader::unescape(src.data(), src.size(), dest, len)) return "!";
+    return string(dest, len);
+}
+
+static string filler(test::Random& rng, size_t len) {
+    string text;
+    for (size_t i = 0; i < len; i++) text += static_cast<char>('a' + rng.below(26));
+    return text;
+}
+
+// Escapes straddling the 16- and 32-byte blocks, with clean runs on both
+// sides long enough for whole blocks before and after
+static void testBlockBoundaries(test::Random& rng) {
+    const size_t offsets[] = { 0, 1, 14, 15, 16, 17, 30, 31, 32, 33, 47, 63, 64, 65 };
+
+    for (size_t offset : offsets)
+    for (size_t i = 0; i < ESCAPE_COUNT; i++)
+    for (size_t tail = 0; tail < 70; tail += 23) {
+        const string head = filler(rng, offset);
+        const string rest = filler(rng, tail);
+        const Escape& escape = ESCAPES[i];
+        const string decoded = head + string(escape.decoded, escape.decodedLength) + rest;
+        const string escaped = head + escape.escaped + rest;
+
+        CHECK(decode(escaped, false) == decoded);
+        CHECK(decode(escaped, true) == decoded);
+    }
+}
+
+// Random mixes of clean runs and escapes; in place, blocks after the first
+// escape move down while the ones before it stay where they are
+static void testRandomText(test::Random& rng) {
+    for (int trial = 0; trial < 3000; trial++) {
+        string escaped, decoded;
+        const size_t pieces = rng.below(12);
+        for (size_t piece = 0; piece < pieces; piece++) {
+            if (rng.below(3) == 0) {
+                const Escape& escape = ESCAPES[rng.below(ESCAPE_COUNT)];
+                escaped += escape.escaped;
+                decoded.append(escape.decoded, escape.decodedLength);
+            } else {
+                const string run = filler(rng, rng.below(40));
+                escaped += run;
+                decoded += run;
+            }
+        }
+
+        CHECK(decode(escaped, false) == decoded);
+        CHECK(decode(escaped, true) == decoded);
+    }
+
+    // Nothing to decode: in place, the text is left exactly as it was
+    const string clean = filler(rng, 100);
+    CHECK(decode(clean, true) == clean);
+    CHECK(decode("", true).empty());
+}
+
+static void testMalformed(test::Random& rng) {
+    const char* inputs[] = { "\\", "\\x", "\\U0041", "\\u", "\\u12", "\\u12g4",
+                             "\\u-123", "\\ud83d", "\\ud83dx", "\\ud83d\\u0041",
+                             "\\ud83d\\n", "\\ud83d\\ud83d", "\\ud83d\\ude0",
+                             "\\ude00", "\\udfff\\ud83d" };
+
+    // At every block offset, in place or not, and with clean text after it
+    for (const char* input : inputs)
+    for (size_t offset = 0; offset < 40; offset += 13) {
+        const string head = filler(rng, offset);
+        CHECK(decode(head + input, false) == "!");
+        CHECK(decode(head + input, true) == "!");
+        if (strcmp(input, "\\") != 0) CHECK(decode(head + input + "tail", false) == "!");
+    }
+
+    size_t len = 7;
+    char dest[4];
+    CHECK(!JsonReader::unescape(nullptr, 0, dest, len));
+    CHECK(!JsonReader::unescape("a", 1, nullptr, len));
+    CHECK(len == 7);
+}
+
+static void testStringViews() {
+    string text = "[\"plain\", \"tab\\there\", \"" + string(40, 'x') + "\\u00e9" +
+                  string(40, 'y') + "\", \"\\ud83d\\ude00\", 5]";
+    const string original = text;
+
+    // A writable document is decoded in place, and later values stay readable
+    vector<char> copy(text.begin(), text.end());
+    JsonReader reader(copy.data(), copy.size());
+    JsonBuffer view;
+    bool isFirst = true;
+    CHECK(reader.beginArray());
+
+    CHECK(reader.nextElement(isFirst) && reader.readStringView(view));
+    CHECK(string(view.data, view.length) == "plain");
+    CHECK(view.data >= copy.data() && view.data < copy.data() + copy.size());
+
+    CHECK(reader.nextElement(isFirst) && reader.readStringView(view));
+    CHECK(string(view.data, view.length) == "tab\there");
+
+    CHECK(reader.nextElement(isFirst) && reader.readStringView(view));
+    CHECK(string(view.data, view.length) ==
+          string(40, 'x') + "\xc3\xa9" + string(40, 'y'));
+
+    CHECK(reader.nextElement(isFirst) && reader.readStringView(view));
+    CHECK(string(view.data, view.length) == "\xf0\x9f\x98\x80");
+
+    uint8_t number;
+    CHECK(reader.nextElement(isFirst) && reader.readUint8(number) && number == 5);
+    CHECK(!reader.nextElement(isFirst) && reader.isComplete());
+
+    // A read-only document only gives views of strings without escapes
+    const vector<char> readOnly(original.begin(), original.end());
+    JsonReader constReader(readOnly.data(), readOnly.size());
+    isFirst = true;
+    CHECK(constReader.beginArray());
+    CHECK(constReader.nextElement(isFirst) && constReader.readStringView(view));
+    CHECK(string(view.data, view.length) == "plain");
+    CHECK(constReader.nextElement(isFirst) && !constReader.readStringView(view));
+    CHECK(constReader.hasError());
+    CHECK(string(readOnly.begin(), readOnly.end()) == original);
+
+    // A malformed escape fails the read
+    string bad = "\"ok\\ud800\"";
+    vector<char> badCopy(bad.begin(), bad.end());
+    JsonReader badReader(badCopy.data(), badCopy.size());
+    CHECK(!badReader.readStringView(view) && badReader.hasError());
+}
+
+int main() {
+    test::Random rng(115);
+
+    testBlockBoundaries(rng);
+    testRandomText(rng);
+    testMalformed(rng);
+    testStringViews();
+
+    return test::finish("JSON unescaping");
+}
@@ -0,0 +1,249 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace serdelite;
+
+struct Vec2 { float x, y; };
+
+static const FieldDescriptor VEC2_FIELDS[] = {
+    SERDELITE_FIELD(Vec2, x, Float),
+    SERDELITE_FIELD(Vec2, y, Float)
+};
+static const MessageDescriptor VEC2 = SERDELITE_MESSAGE(Vec2, VEC2_FIELDS, 1);
+
+// Version 1 of an archived record
+struct PlayerV1 {
+    uint32_t id;
+    int16_t hp;
+    char name[8];
+    Vec2 pos;
+    uint8_t legacy;
+    float speed;
+    uint16_t levels[2];
+};
+
+// Version 2: renamed, widened, dropped and added fields
+struct PlayerV2 {
+    uint32_t id;
+    char nick[16];
+    Vec2 pos;
+    int32_t hp;
+    double speed;
+    uint32_t levels[2];
+    uint64_t gold;
+    char tag[4];
+    bool flag;
+};
+
+static const FieldDescriptor V1_FIELDS[] = {
+    SERDELITE_FIELD(PlayerV1, id, Uint32),
+    SERDELITE_FIELD(PlayerV1, hp, Int16),
+    SERDELITE_STRING_FIELD(PlayerV1, name),
+    SERDELITE_MESSAGE_FIELD(PlayerV1, pos, VEC2),
+    SERDELITE_FIELD(PlayerV1, legacy, Uint8),
+    SERDELITE_FIELD(PlayerV1, speed, Float),
+    SERDELITE_ARRAY_FIELD(PlayerV1, levels, Uint16)
+};
+
+static const FieldDescriptor V2_FIELDS[] = {
+    SERDELITE_FIELD(PlayerV2, id, Uint32),
+    SERDELITE_STRING_FIELD(PlayerV2, nick),
+    SERDELITE_MESSAGE_FIELD(PlayerV2, pos, VEC2),
+    SERDELITE_FIELD(PlayerV2, hp, Int32),
+    SERDELITE_FIELD(PlayerV2, speed, Double),
+    SERDELITE_ARRAY_FIELD(PlayerV2, levels, Uint32),
+    SERDELITE_FIELD(PlayerV2, gold, Uint64),
+    SERDELITE_STRING_FIELD(PlayerV2, tag),
+    SERDELITE_FIELD(PlayerV2, flag, Bool)
+};
+
+static const MessageDescriptor V1 = SERDELITE_MESSAGE(PlayerV1, V1_FIELDS, 1);
+static const MessageDescriptor V2 = SERDELITE_MESSAGE(PlayerV2, V2_FIELDS, 2);
+
+static const uint64_t DEFAULT_GOLD = 500;
+static const char DEFAULT_TAG[4] = "new";
+
+static const MigrationRule RULES[] = {
+    MigrationRule::renameField("name", "nick"),
+    MigrationRule::widenField("nick"),
+    MigrationRule::widenField("hp"),
+    MigrationRule::widenField("speed"),
+    MigrationRule::widenField("levels"),
+    MigrationRule::dropField("legacy"),
+    MigrationRule::addField("gold", &DEFAULT_GOLD),
+    MigrationRule::addField("tag", DEFAULT_TAG),
+    MigrationRule::addField("flag")
+};
+static const size_t RULE_COUNT = sizeof(RULES) / sizeof(RULES[0]);
+
+static PlayerV1 makeRecord(test::Random& rng, int index) {
+    PlayerV1 record;
+    memset(&record, 0, sizeof(record));
+    record.id = static_cast<uint32_t>(rng.next());
+    record.hp = static_cast<int16_t>(rng.next());
+    snprintf(record.name, sizeof(record.name), "p%u",
+             static_cast<unsigned>(index) % 100u);
+    record.pos.x = static_cast<float>(index) * 0.5f;
+    record.pos.y = -static_cast<float>(index);
+    record.legacy = 9;
+    record.speed = 1.25f * static_cast<float>(index);
+    record.levels[0] = 60000;
+    record.levels[1] = static_cast<uint16_t>(index);
+    return record;
+}
+
+// What the plan must produce, built field by field
+static PlayerV2 migrateByHand(const PlayerV1& old) {
+    PlayerV2 record;
+    memset(&record, 0, sizeof(record));
+    record.id = old.id;
+    memcpy(record.nick, old.name, sizeof(old.name));
+    record.pos = old.pos;
+    record.hp = old.hp;
+    record.speed = old.speed;
+    record.levels[0] = old.levels[0];
+    record.levels[1] = old.levels[1];
+    record.gold = DEFAULT_GOLD;
+    memcpy(record.tag, DEFAULT_TAG, sizeof(DEFAULT_TAG));
+    record.flag = false;
+    return record;
+}
+
+static void testMigrate(test::Random& rng, Endian order) {
+    MigrationPlan plan;
+    CHECK(plan.compile(V1, V2, RULES, RULE_COUNT, order));
+    CHECK(plan.isCompiled());
+    CHECK(plan.getFromVersion() == 1);
+    CHECK(plan.getToVersion() == 2);
+
+    uint8_t archived[1024], migrated[1024], expected[1024];
+    ByteBuffer archivedBuffer(archived, sizeof(archived), order);
+    ByteBuffer migratedBuffer(migrated, sizeof(migrated), order);
+    ByteBuffer expectedBuffer(expected, sizeof(expected), order);
+    ByteStream in(archivedBuffer), out(migratedBuffer), ref(expectedBuffer);
+
+    for (int i = 0; i < 8; i++) {
+        PlayerV1 record = makeRecord(rng, i);
+        PlayerV2 current = migrateByHand(record);
+        CHECK(in.writeMessage(&record, V1));
+        CHECK(ref.writeMessage(&current, V2));
+    }
+
+    int count = 0;
+    while (plan.apply(in, out)) count++;
+    CHECK(count == 8);
+    CHECK(in.getReadCursor() == archivedBuffer.getSize());
+
+    // Same bytes as writing the new version directly
+    CHECK(migratedBuffer.getSize() == expectedBuffer.getSize());
+    CHECK(memcmp(migrated, expected, expectedBuffer.getSize()) == 0);
+
+    // A plan for the other byte order refuses the streams
+    MigrationPlan other;
+    CHECK(other.compile(V1, V2, RULES, RULE_COUNT,
+                        order == Endian::Big ? Endian::Little : Endian::Big));
+    in.resetReadCursor();
+    CHECK(!other.apply(in, out));
+}
+
+static void testUndeclaredChanges() {
+    MigrationPlan plan;
+
+    // Dropping any single rule leaves a difference undeclared
+    for (size_t skip = 0; skip < RULE_COUNT; skip++) {
+        MigrationRule rules[RULE_COUNT];
+        size_t count = 0;
+        for (size_t i = 0; i < RULE_COUNT; i++)
+            if (i != skip) rules[count++] = RULES[i];
+
+        CHECK(!plan.compile(V1, V2, rules, count));
+        CHECK(!plan.isCompiled());
+    }
+
+    // Narrowing is not a widening
+    const MigrationRule narrow[] = {
+        MigrationRule::renameField("nick", "name"),
+        MigrationRule::widenField("name"),
+        MigrationRule::widenField("hp"),
+        MigrationRule::widenField("speed"),
+        MigrationRule::widenField("levels"),
+        MigrationRule::dropField("gold"),
+        MigrationRule::dropField("tag"),
+        MigrationRule::dropField("flag"),
+        MigrationRule::addField("legacy")
+    };
+    CHECK(!plan.compile(V2, V1, narrow, sizeof(narrow) / sizeof(narrow[0])));
+
+    // The same layout needs no rules and copies everything in one step
+    CHECK(plan.compile(V1, V1, nullptr, 0));
+    CHECK(plan.getStepCount() == 1);
+}
+
+static void testInvalidInput(test::Random& rng) {
+    MigrationPlan plan;
+    CHECK(plan.compile(V1, V2, RULES, RULE_COUNT));
+
+    uint8_t archived[256], migrated[256];
+    ByteBuffer archivedBuffer(archived, sizeof(archived));
+    ByteStream in(archivedBuffer);
+    PlayerV1 record = makeRecord(rng, 1);
+    CHECK(in.writeMessage(&record, V1));
+    const size_t fullSize = archivedBuffer.getSize();
+
+    ByteBuffer migratedBuffer(migrated, sizeof(migrated));
+    ByteStream out(migratedBuffer);
+
+    // Every truncation is rejected without consuming or writing anything
+    for (size_t len = 0; len < fullSize; len++) {
+        archivedBuffer.setLength(len);
+        in.resetReadCursor();
+        CHECK(!plan.apply(in, out));
+        CHECK(in.getReadCursor() == 0);
+        CHECK(migratedBuffer.getSize() == 0);
+    }
+    archivedBuffer.setLength(fullSize);
+
+    // A string length running past the record
+    const size_t nameLenPos = sizeof(uint32_t) + sizeof(int16_t);
+    const uint8_t savedLen = archived[nameLenPos + 1];
+    archived[nameLenPos + 1] = 200;
+    in.resetReadCursor();
+    CHECK(!plan.apply(in, out));
+    CHECK(in.getReadCursor() == 0);
+    archived[nameLenPos + 1] = savedLen;
+
+    // No room for the migrated record
+    uint8_t small[20];
+    ByteBuffer smallBuffer(small, sizeof(small));
+    ByteStream smallOut(smallBuffer);
+    in.resetReadCursor();
+    CHECK(!plan.apply(in, smallOut));
+    CHECK(in.getReadCursor() == 0);
+    CHECK(smallBuffer.getSize() == 0);
+
+    in.resetReadCursor();
+    CHECK(plan.apply(in, out));
+    CHECK(in.getReadCursor() == fullSize);
+}
+
+int main() {
+    test::Random rng(108);
+
+    testMigrate(rng, Endian::Big);
+    testMigrate(rng, Endian::Little);
+    testUndeclaredChanges();
+    testInvalidInput(rng);
+
+    return test::finish("migration");
+}
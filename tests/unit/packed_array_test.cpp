@@ -0,0 +1,144 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <algorithm>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+// Sizes around the 128-value block and the SIMD lane boundaries
+static const size_t COUNTS[] = { 0, 1, 3, 4, 5, 127, 128, 129, 255, 256, 257, 1000 };
+
+// Values spread over `range` (0 for the full width), sorted or not
+template <typename T>
+static vector<T> makeValues(test::Random& rng, size_t count,
+                            uint64_t range, bool sorted) {
+    vector<T> values(count);
+    T base = static_cast<T>(rng.next());
+    for (size_t i = 0; i < count; i++) {
+        T step = static_cast<T>(range ? rng.below(range) : rng.next());
+        values[i] = sorted ? base : static_cast<T>(base + step);
+        if (sorted) base = static_cast<T>(base + step);
+    }
+    if (count > 3) values[3] = static_cast<T>(~static_cast<T>(0));
+    return values;
+}
+
+static bool writePacked(ByteStream& s, const vector<uint32_t>& v, IntArrayCodec c) {
+    return s.writePackedUint32Array(v.data(), v.size(), c);
+}
+
+static bool writePacked(ByteStream& s, const vector<uint64_t>& v, IntArrayCodec c) {
+    return s.writePackedUint64Array(v.data(), v.size(), c);
+}
+
+static bool readPacked(ByteStream& s, vector<uint32_t>& v, size_t& n) {
+    return s.readPackedUint32Array(v.data(), v.size(), n);
+}
+
+static bool readPacked(ByteStream& s, vector<uint64_t>& v, size_t& n) {
+    return s.readPackedUint64Array(v.data(), v.size(), n);
+}
+
+template <typename T>
+static void testRoundTrip(test::Random& rng) {
+    const IntArrayCodec codecs[] = { IntArrayCodec::FrameOfReference,
+                                     IntArrayCodec::Delta };
+    const Endian orders[] = { Endian::Big, Endian::Little };
+    const uint64_t ranges[] = { 1, 2, 100, 70000, 0 };
+
+    for (size_t count : COUNTS)
+    for (IntArrayCodec codec : codecs)
+    for (Endian order : orders)
+    for (uint64_t range : ranges)
+    for (int sorted = 0; sorted < 2; sorted++) {
+        vector<T> values = makeValues<T>(rng, count, range, sorted != 0);
+
+        vector<uint8_t> mem(count * (sizeof(T) + 1) + 64);
+        ByteBuffer buffer(mem.data(), mem.size(), order);
+        ByteStream stream(buffer);
+        CHECK(writePacked(stream, values, codec));
+
+        vector<T> out(count + 1);
+        size_t outCount = 0;
+        CHECK(readPacked(stream, out, outCount));
+        CHECK(outCount == count);
+        CHECK(equal(values.begin(), values.end(), out.begin()));
+        CHECK(stream.getReadCursor() == buffer.getSize());
+    }
+}
+
+template <typename T>
+static void testInvalidInput(test::Random& rng) {
+    vector<T> values = makeValues<T>(rng, 300, 1000, false);
+
+    uint8_t mem[4096];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+    CHECK(writePacked(stream, values, IntArrayCodec::FrameOfReference));
+    const size_t fullSize = buffer.getSize();
+
+    vector<T> out(values.size());
+    size_t outCount = 0;
+
+    // Every truncation is rejected without moving the cursor
+    for (size_t len = 0; len < fullSize; len++) {
+        buffer.setLength(len);
+        stream.resetReadCursor();
+        CHECK(!readPacked(stream, out, outCount));
+        CHECK(stream.getReadCursor() == 0);
+    }
+    buffer.setLength(fullSize);
+
+    // Destination one value too small
+    vector<T> small(values.size() - 1);
+    stream.resetReadCursor();
+    CHECK(!readPacked(stream, small, outCount));
+
+    // Unknown codec
+    const uint8_t codecId = mem[0];
+    mem[0] = 3;
+    stream.resetReadCursor();
+    CHECK(!readPacked(stream, out, outCount));
+    mem[0] = codecId;
+
+    // Bit width wider than the value type: codec, count, reference, width
+    const size_t widthPos = 1 + sizeof(uint32_t) + sizeof(T);
+    const uint8_t width = mem[widthPos];
+    mem[widthPos] = sizeof(T) * 8 + 1;
+    stream.resetReadCursor();
+    CHECK(!readPacked(stream, out, outCount));
+    mem[widthPos] = width;
+
+    stream.resetReadCursor();
+    CHECK(readPacked(stream, out, outCount));
+    CHECK(equal(values.begin(), values.end(), out.begin()));
+
+    // Output overflow leaves the buffer as it was
+    uint8_t tiny[50];
+    ByteBuffer tinyBuffer(tiny, sizeof(tiny));
+    ByteStream tinyStream(tinyBuffer);
+    CHECK(tinyStream.writeUint8(7));
+    CHECK(!writePacked(tinyStream, values, IntArrayCodec::Delta));
+    CHECK(tinyBuffer.getSize() == 1);
+}
+
+int main() {
+    test::Random rng(101);
+
+    testRoundTrip<uint32_t>(rng);
+    testRoundTrip<uint64_t>(rng);
+    testInvalidInput<uint32_t>(rng);
+    testInvalidInput<uint64_t>(rng);
+
+    return test::finish("packed arrays");
+}
@@ -0,0 +1,193 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+// An object whose optional fields follow a presence header
+class Profile: public ByteSerializable {
+public:
+    uint32_t id;
+    Optional<uint16_t> level;
+    Optional<string> nickname;
+    Optional<float> rating;
+
+    Profile(): id(0) {}
+
+    bool toByteStream(ByteStream& s) const override {
+        PresenceMask mask(3);
+        mask.set(0, level.hasValue());
+        mask.set(1, nickname.hasValue());
+        mask.set(2, rating.hasValue());
+
+        return s.writeUint32(id) && s.writePresenceMask(mask) &&
+               (!level.hasValue() || s.writeUint16(level.value())) &&
+               (!nickname.hasValue() || s.writeString(nickname.value())) &&
+               (!rating.hasValue() || s.writeFloat(rating.value()));
+    }
+
+    bool fromByteStream(ByteStream& s) override {
+        PresenceMask mask(3);
+        if (!s.readUint32(id) || !s.readPresenceMask(mask)) return false;
+
+        level.reset();
+        nickname.reset();
+        rating.reset();
+        if (mask.has(0) && !s.readUint16(level.value())) return false;
+        if (mask.has(1) && !s.readString(nickname.value())) return false;
+        if (mask.has(2) && !s.readFloat(rating.value())) return false;
+
+        if (mask.has(0)) level.markPresent();
+        if (mask.has(1)) nickname.markPresent();
+        if (mask.has(2)) rating.markPresent();
+        return true;
+    }
+
+    size_t byteSize() const override {
+        return sizeof(id) + 1 +
+               (level.hasValue() ? sizeof(uint16_t) : 0) +
+               (nickname.hasValue() ? 2 + nickname.value().size() : 0) +
+               (rating.hasValue() ? sizeof(float) : 0);
+    }
+};
+
+static uint64_t fieldBits(uint8_t fieldCount) {
+    return fieldCount >= 64 ? ~0ULL : (1ULL << fieldCount) - 1;
+}
+
+static void testRoundTrip(test::Random& rng) {
+    const Endian orders[] = { Endian::Big, Endian::Little };
+
+    for (uint8_t fieldCount = 0; fieldCount <= PresenceMask::MAX_FIELDS; fieldCount++)
+    for (Endian order : orders) {
+        PresenceMask mask(fieldCount);
+        CHECK(mask.getFieldCount() == fieldCount);
+        CHECK(mask.byteSize() == (fieldCount + 7u) / 8u);
+
+        for (uint8_t i = 0; i < fieldCount; i++)
+            CHECK(mask.set(i, rng.below(2) == 0));
+
+        uint8_t mem[16];
+        ByteBuffer buffer(mem, sizeof(mem), order);
+        ByteStream stream(buffer);
+        CHECK(stream.writePresenceMask(mask));
+        CHECK(buffer.getSize() == mask.byteSize());
+
+        PresenceMask back(fieldCount);
+        CHECK(back.setBits(fieldBits(fieldCount)));
+        CHECK(stream.readPresenceMask(back));
+        CHECK(back.getBits() == mask.getBits());
+        CHECK(stream.getReadCursor() == mask.byteSize());
+
+        for (uint8_t i = 0; i < fieldCount; i++)
+            CHECK(back.has(i) == mask.has(i));
+    }
+
+    // Field counts above the limit are clamped
+    PresenceMask wide(200);
+    CHECK(wide.getFieldCount() == PresenceMask::MAX_FIELDS);
+    CHECK(wide.byteSize() == 8);
+}
+
+static void testFieldRange() {
+    PresenceMask mask(10);
+
+    // Indices at or past the field count are refused and never set
+    CHECK(mask.set(9));
+    CHECK(!mask.set(10));
+    CHECK(!mask.set(63));
+    CHECK(!mask.set(255));
+    CHECK(!mask.has(10));
+    CHECK(mask.getBits() == (1ULL << 9));
+
+    CHECK(!mask.setBits(1ULL << 10));
+    CHECK(!mask.setBits(~0ULL));
+    CHECK(mask.getBits() == (1ULL << 9));
+    CHECK(mask.setBits(0x3FF));
+
+    mask.clear();
+    CHECK(mask.getBits() == 0);
+}
+
+static void testInvalidInput() {
+    uint8_t mem[16];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+
+    // Ten fields take two bytes; bit 10 of the stored mask is stray
+    PresenceMask mask(10);
+    CHECK(stream.writeUint8(0xFF));
+    CHECK(stream.writeUint8(0x04));
+
+    CHECK(!stream.readPresenceMask(mask));
+    CHECK(stream.getReadCursor() == 0);
+    CHECK(mask.getBits() == 0);
+
+    // A truncated mask leaves the cursor in place
+    buffer.setLength(1);
+    CHECK(!stream.readPresenceMask(mask));
+    CHECK(stream.getReadCursor() == 0);
+
+    buffer.setLength(2);
+    mem[1] = 0x03;
+    CHECK(stream.readPresenceMask(mask));
+    CHECK(mask.getBits() == 0x3FF);
+    CHECK(stream.getReadCursor() == 2);
+
+    // A full buffer refuses the mask without writing part of it
+    uint8_t one[1];
+    ByteBuffer oneBuffer(one, sizeof(one));
+    ByteStream oneStream(oneBuffer);
+    CHECK(!oneStream.writePresenceMask(mask));
+    CHECK(oneBuffer.getSize() == 0);
+}
+
+static void testObjects(test::Random& rng) {
+    uint8_t mem[64];
+
+    for (int pattern = 0; pattern < 8; pattern++) {
+        Profile profile;
+        profile.id = static_cast<uint32_t>(rng.next());
+        if (pattern & 1) profile.level.set(static_cast<uint16_t>(rng.next()));
+        if (pattern & 2) profile.nickname.set("ranger");
+        if (pattern & 4) profile.rating.set(4.5f);
+
+        ByteBuffer buffer(mem, sizeof(mem));
+        ByteStream stream(buffer);
+        CHECK(stream.writeObject(profile));
+        CHECK(buffer.getSize() == profile.byteSize());
+
+        Profile back;
+        back.level.set(1);
+        CHECK(stream.readObject(back));
+        CHECK(back.id == profile.id);
+        CHECK(back.level.hasValue() == profile.level.hasValue());
+        CHECK(back.nickname.hasValue() == profile.nickname.hasValue());
+        CHECK(back.rating.hasValue() == profile.rating.hasValue());
+        CHECK(!back.level.hasValue() || back.level.value() == profile.level.value());
+        CHECK(!back.nickname.hasValue() ||
+              back.nickname.value() == profile.nickname.value());
+        CHECK(!back.rating.hasValue() || back.rating.value() == profile.rating.value());
+    }
+}
+
+int main() {
+    test::Random rng(104);
+
+    testRoundTrip(rng);
+    testFieldRange();
+    testInvalidInput();
+    testObjects(rng);
+
+    return test::finish("presence masks");
+}
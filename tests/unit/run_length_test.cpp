@@ -0,0 +1,211 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+class Tile: public ByteSerializable {
+public:
+    uint16_t id;
+    string name;
+
+    Tile(): id(0) {}
+    Tile(uint16_t _id, const string& _name): id(_id), name(_name) {}
+
+    bool operator==(const Tile& other) const {
+        return id == other.id && name == other.name;
+    }
+
+    bool toByteStream(ByteStream& s) const override {
+        return s.writeUint16(id) && s.writeString(name);
+    }
+
+    bool fromByteStream(ByteStream& s) override {
+        return s.readUint16(id) && s.readString(name);
+    }
+
+    size_t byteSize() const override {
+        return sizeof(id) + sizeof(uint16_t) + name.size();
+    }
+};
+
+// Runs of random length over a few distinct tiles
+static vector<Tile> makeTiles(test::Random& rng, size_t count, size_t maxRun) {
+    vector<Tile> tiles;
+    while (tiles.size() < count) {
+        const size_t run = 1 + rng.below(maxRun);
+        const Tile tile(static_cast<uint16_t>(rng.below(4)),
+                        rng.below(2) ? "grass" : "");
+        for (size_t i = 0; i < run && tiles.size() < count; i++)
+            tiles.push_back(tile);
+    }
+    return tiles;
+}
+
+static void testRoundTrip(test::Random& rng) {
+    const size_t counts[] = { 0, 1, 2, 17, 300 };
+    const size_t maxRuns[] = { 1, 3, 50 };
+
+    for (size_t count : counts)
+    for (size_t maxRun : maxRuns) {
+        vector<Tile> tiles = makeTiles(rng, count, maxRun);
+
+        vector<uint8_t> mem(count * 16 + 64);
+        ByteBuffer buffer(mem.data(), mem.size());
+        ByteStream stream(buffer);
+        CHECK(stream.writeRunLengthArray(tiles.data(), tiles.size()));
+
+        vector<Tile> out(count + 1);
+        size_t outCount = 0;
+        CHECK(stream.readRunLengthArray(out.data(), out.size(), outCount));
+        CHECK(outCount == count);
+        CHECK(equal(tiles.begin(), tiles.end(), out.begin()));
+        CHECK(stream.getReadCursor() == buffer.getSize());
+    }
+
+    // A uniform array is one run: count, a two-byte header and one element
+    vector<Tile> uniform(1000, Tile(7, "water"));
+    uint8_t mem[64];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+    CHECK(stream.writeRunLengthArray(uniform.data(), uniform.size()));
+    CHECK(buffer.getSize() == 4 + 2 + uniform[0].byteSize());
+}
+
+static void testUnrepeated() {
+    // No two neighbours match: one header byte per 63 elements
+    vector<Tile> tiles;
+    size_t elementBytes = 0;
+    for (size_t i = 0; i < 200; i++) {
+        tiles.push_back(Tile(static_cast<uint16_t>(i), ""));
+        elementBytes += tiles.back().byteSize();
+    }
+
+    vector<uint8_t> mem(4096);
+    ByteBuffer buffer(mem.data(), mem.size());
+    ByteStream stream(buffer);
+    CHECK(stream.writeRunLengthArray(tiles.data(), tiles.size()));
+    CHECK(buffer.getSize() == 4 + (200 + 62) / 63 + elementBytes);
+
+    vector<Tile> out(tiles.size());
+    size_t outCount = 0;
+    CHECK(stream.readRunLengthArray(out.data(), out.size(), outCount));
+    CHECK(equal(tiles.begin(), tiles.end(), out.begin()));
+}
+
+static void testExactCapacity(test::Random& rng) {
+    vector<Tile> tiles = makeTiles(rng, 60, 4);
+
+    uint8_t mem[1024];
+    ByteBuffer sized(mem, sizeof(mem));
+    ByteStream sizing(sized);
+    CHECK(sizing.writeRunLengthArray(tiles.data(), tiles.size()));
+    const size_t fullSize = sized.getSize();
+
+    // A buffer that exactly fits the encoding is enough, and every smaller
+    // one fails without keeping a partial array
+    vector<uint8_t> exact(fullSize);
+    for (size_t capacity = 1; capacity <= fullSize; capacity++) {
+        ByteBuffer buffer(exact.data(), capacity);
+        ByteStream stream(buffer);
+        const bool written = stream.writeRunLengthArray(tiles.data(), tiles.size());
+        CHECK(written == (capacity == fullSize));
+        CHECK(buffer.getSize() == (written ? fullSize : 0));
+    }
+    CHECK(memcmp(exact.data(), mem, fullSize) == 0);
+}
+
+static void testInvalidInput(test::Random& rng) {
+    vector<Tile> tiles = makeTiles(rng, 40, 6);
+
+    uint8_t mem[1024];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+    CHECK(stream.writeRunLengthArray(tiles.data(), tiles.size()));
+    const size_t fullSize = buffer.getSize();
+
+    vector<Tile> out(tiles.size());
+    size_t outCount = 0;
+
+    for (size_t len = 0; len < fullSize; len++) {
+        buffer.setLength(len);
+        stream.resetReadCursor();
+        CHECK(!stream.readRunLengthArray(out.data(), out.size(), outCount));
+        CHECK(stream.getReadCursor() == 0);
+    }
+    buffer.setLength(fullSize);
+
+    stream.resetReadCursor();
+    CHECK(!stream.readRunLengthArray(out.data(), out.size() - 1, outCount));
+
+    // The first run header follows the element count
+    uint8_t& header = mem[4];
+    const uint8_t saved = header;
+
+    // Empty runs, literal or repeated
+    const uint8_t empty[] = { 0, 1 };
+    for (uint8_t value : empty) {
+        header = value;
+        stream.resetReadCursor();
+        CHECK(!stream.readRunLengthArray(out.data(), out.size(), outCount));
+        CHECK(stream.getReadCursor() == 0);
+    }
+
+    // A run longer than the array
+    header = static_cast<uint8_t>(((tiles.size() + 1) << 1) | 1);
+    stream.resetReadCursor();
+    CHECK(!stream.readRunLengthArray(out.data(), out.size(), outCount));
+
+    header = saved;
+    stream.resetReadCursor();
+    CHECK(stream.readRunLengthArray(out.data(), out.size(), outCount));
+    CHECK(equal(tiles.begin(), tiles.end(), out.begin()));
+
+    // A header cut off by the end of the data, or overflowing 64 bits
+    uint8_t bad[16];
+    ByteBuffer badBuffer(bad, sizeof(bad));
+    ByteStream badStream(badBuffer);
+    CHECK(badStream.writeUint32(1));
+    for (size_t i = 4; i < sizeof(bad); i++) badBuffer.addByte(0x80);
+
+    badBuffer.setLength(4 + 3);
+    CHECK(!badStream.readRunLengthArray(out.data(), out.size(), outCount));
+    CHECK(badStream.getReadCursor() == 0);
+
+    badBuffer.setLength(sizeof(bad));
+    bad[4 + 9] = 0x02;
+    CHECK(!badStream.readRunLengthArray(out.data(), out.size(), outCount));
+    CHECK(badStream.getReadCursor() == 0);
+
+    // Output overflow leaves the buffer as it was
+    uint8_t tiny[24];
+    ByteBuffer tinyBuffer(tiny, sizeof(tiny));
+    ByteStream tinyStream(tinyBuffer);
+    CHECK(tinyStream.writeUint8(1));
+    CHECK(!tinyStream.writeRunLengthArray(tiles.data(), tiles.size()));
+    CHECK(tinyBuffer.getSize() == 1);
+}
+
+int main() {
+    test::Random rng(102);
+
+    testRoundTrip(rng);
+    testUnrepeated();
+    testExactCapacity(rng);
+    testInvalidInput(rng);
+
+    return test::finish("run-length arrays");
+}
@@ -0,0 +1,60 @@
+#!/bin/sh
+#
+# SerDeLite unit tests
+#
+# Builds the library and every *_test.cpp once per SIMD mode, so the vector
+# kernels and the scalar fallbacks are both checked, then runs the tests.
+# Objects and executables go to build/tests/<mode>/ at the project root.
+#
+# Usage: ./run_tests.sh            (CXX and CXXFLAGS are honoured)
+
+cd "$(dirname "$0")" || exit 1
+
+ROOT_DIR=../..
+BUILD_DIR=$ROOT_DIR/build/tests
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O2}
+
+# name:flags, with commas between flags; SSSE3 and native modes are skipped
+# where the compiler lacks them. The scalar mode takes every portable fallback
+MODES="sse2: ssse3:-mssse3 native:-march=native scalar:-DSERDELITE_NO_SIMD,-DSERDELITE_NO_HUGE_PAGES"
+
+failed=0
+
+for mode in $MODES; do
+    name=${mode%%:*}
+    flags=$(echo "${mode#*:}" | tr ',' ' ')
+
+    if ! echo "int main(){}" | $CXX $flags -x c++ - -o /dev/null 2>/dev/null; then
+        echo "== $name: not supported by $CXX, skipped"
+        continue
+    fi
+
+    echo "== $name ($flags)"
+    OUT_DIR=$BUILD_DIR/$name
+    mkdir -p "$OUT_DIR/lib"
+
+    # The library is compiled once per mode and linked into every test
+    objects=""
+    for src in "$ROOT_DIR"/src/serdelite/*.cpp; do
+        obj=$OUT_DIR/lib/$(basename "$src" .cpp).o
+        $CXX -std=c++11 $CXXFLAGS $flags -I"$ROOT_DIR/include" \
+            -c "$src" -o "$obj" || exit 1
+        objects="$objects $obj"
+    done
+
+    for test in *_test.cpp; do
+        exe=$OUT_DIR/${test%.cpp}
+
+        if ! $CXX -std=c++11 $CXXFLAGS -Wall -Wextra $flags \
+                -I"$ROOT_DIR/include" "$test" $objects -lpthread -o "$exe"; then
+            echo "[FAIL] $test: build failed"
+            failed=1
+            continue
+        fi
+
+        "$exe" || failed=1
+    done
+done
+
+exit $failed
@@ -0,0 +1,213 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+class Slot: public ByteSerializable {
+public:
+    uint32_t itemId;
+    string label;
+
+    Slot(): itemId(0) {}
+
+    bool operator==(const Slot& other) const {
+        return itemId == other.itemId && label == other.label;
+    }
+
+    bool toByteStream(ByteStream& s) const override {
+        return s.writeUint32(itemId) && s.writeString(label);
+    }
+
+    bool fromByteStream(ByteStream& s) override {
+        return s.readUint32(itemId) && s.readString(label);
+    }
+
+    size_t byteSize() const override {
+        return sizeof(itemId) + sizeof(uint16_t) + label.size();
+    }
+};
+
+// Values equal to `defaultValue` with probability 1 - density/8
+template <typename T>
+static vector<T> makeValues(test::Random& rng, size_t count,
+                            unsigned density, const T& defaultValue) {
+    vector<T> values(count, defaultValue);
+    for (size_t i = 0; i < count; i++) {
+        if (rng.below(8) >= density) continue;
+
+        // Sometimes only the first byte differs, so wide compares must
+        // check every lane of an element
+        uint64_t bits = rng.next();
+        memcpy(&values[i], &bits, rng.below(4) ? sizeof(T) : 1);
+    }
+    return values;
+}
+
+// Sets bit i for every element that differs bitwise from the default
+template <typename T>
+static vector<uint8_t> referenceBitmap(const vector<T>& values,
+                                       const T& defaultValue, size_t& present) {
+    vector<uint8_t> bitmap((values.size() + 7) / 8, 0);
+    present = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (memcmp(&values[i], &defaultValue, sizeof(T)) == 0) continue;
+
+        bitmap[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        present++;
+    }
+    return bitmap;
+}
+
+template <typename T>
+static void testScalars(test::Random& rng, const T& defaultValue) {
+    // Around the 8, 16 and 64 element steps of the SIMD compares
+    const size_t counts[] = { 0, 1, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1000 };
+    const unsigned densities[] = { 0, 1, 4, 8 };
+    const Endian orders[] = { Endian::Big, Endian::Little };
+
+    for (size_t count : counts)
+    for (unsigned density : densities)
+    for (Endian order : orders) {
+        vector<T> values = makeValues(rng, count, density, defaultValue);
+        size_t present;
+        vector<uint8_t> bitmap = referenceBitmap(values, defaultValue, present);
+
+        vector<uint8_t> mem(4 + count * (sizeof(T) + 1) + 16);
+        ByteBuffer buffer(mem.data(), mem.size(), order);
+        ByteStream stream(buffer);
+        CHECK(stream.writeSparseArray(values.data(), count, defaultValue));
+        CHECK(buffer.getSize() == 4 + bitmap.size() + present * sizeof(T));
+        CHECK(bitmap.empty() ||
+              memcmp(mem.data() + 4, bitmap.data(), bitmap.size()) == 0);
+
+        vector<T> out(count + 1);
+        size_t outCount = 0;
+        CHECK(stream.readSparseArray(out.data(), out.size(), outCount,
+                                     defaultValue));
+        CHECK(outCount == count);
+        CHECK(count == 0 ||
+              memcmp(values.data(), out.data(), count * sizeof(T)) == 0);
+    }
+}
+
+static void testObjects(test::Random& rng) {
+    vector<Slot> slots(200);
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (rng.below(4) != 0) continue;
+        slots[i].itemId = static_cast<uint32_t>(rng.next());
+        slots[i].label = (i % 2) ? "sword" : "";
+    }
+
+    uint8_t mem[4096];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+    CHECK(stream.writeSparseArray(slots.data(), slots.size()));
+
+    vector<Slot> out(slots.size());
+    size_t outCount = 0;
+    CHECK(stream.readSparseArray(out.data(), out.size(), outCount));
+    CHECK(outCount == slots.size());
+    CHECK(equal(slots.begin(), slots.end(), out.begin()));
+
+    // A buffer that exactly fits the encoding is enough, even when a large
+    // default is left out at the end, and every smaller one fails cleanly
+    Slot empty;
+    empty.label = string(20, 'x');
+    vector<Slot> mostlyDefault(16, empty);
+    mostlyDefault[3].itemId = 42;
+
+    uint8_t sized[256];
+    ByteBuffer sizedBuffer(sized, sizeof(sized));
+    ByteStream sizing(sizedBuffer);
+    CHECK(sizing.writeSparseArray(mostlyDefault.data(), mostlyDefault.size(), empty));
+    const size_t fullSize = sizedBuffer.getSize();
+    CHECK(fullSize == 4 + 2 + mostlyDefault[3].byteSize());
+
+    vector<uint8_t> exact(fullSize);
+    for (size_t capacity = 1; capacity <= fullSize; capacity++) {
+        ByteBuffer exactBuffer(exact.data(), capacity);
+        ByteStream exactStream(exactBuffer);
+        const bool written = exactStream.writeSparseArray(
+            mostlyDefault.data(), mostlyDefault.size(), empty);
+        CHECK(written == (capacity == fullSize));
+        CHECK(exactBuffer.getSize() == (written ? fullSize : 0));
+    }
+    CHECK(memcmp(exact.data(), sized, fullSize) == 0);
+
+    vector<Slot> back(mostlyDefault.size());
+    CHECK(sizing.readSparseArray(back.data(), back.size(), outCount, empty));
+    CHECK(equal(mostlyDefault.begin(), mostlyDefault.end(), back.begin()));
+}
+
+static void testInvalidInput(test::Random& rng) {
+    vector<uint32_t> values = makeValues<uint32_t>(rng, 100, 3, 0);
+
+    uint8_t mem[1024];
+    ByteBuffer buffer(mem, sizeof(mem));
+    ByteStream stream(buffer);
+    CHECK(stream.writeSparseArray(values.data(), values.size()));
+    const size_t fullSize = buffer.getSize();
+
+    vector<uint32_t> out(values.size());
+    size_t outCount = 0;
+
+    for (size_t len = 0; len < fullSize; len++) {
+        buffer.setLength(len);
+        stream.resetReadCursor();
+        CHECK(!stream.readSparseArray(out.data(), out.size(), outCount));
+        CHECK(stream.getReadCursor() == 0);
+    }
+    buffer.setLength(fullSize);
+
+    stream.resetReadCursor();
+    CHECK(!stream.readSparseArray(out.data(), out.size() - 1, outCount));
+
+    // A presence bit past the last element (100 elements use 4 bits of byte 12)
+    uint8_t& lastBitmapByte = mem[4 + 12];
+    const uint8_t saved = lastBitmapByte;
+    lastBitmapByte |= 0x80;
+    stream.resetReadCursor();
+    CHECK(!stream.readSparseArray(out.data(), out.size(), outCount));
+    lastBitmapByte = saved;
+
+    stream.resetReadCursor();
+    CHECK(stream.readSparseArray(out.data(), out.size(), outCount));
+    CHECK(values == out);
+
+    // Output overflow leaves the buffer as it was
+    uint8_t tiny[40];
+    ByteBuffer tinyBuffer(tiny, sizeof(tiny));
+    ByteStream tinyStream(tinyBuffer);
+    CHECK(tinyStream.writeUint8(1));
+    CHECK(!tinyStream.writeSparseArray(values.data(), values.size()));
+    CHECK(tinyBuffer.getSize() == 1);
+}
+
+int main() {
+    test::Random rng(103);
+
+    testScalars<uint8_t>(rng, 0);
+    testScalars<uint16_t>(rng, 0xBEEF);
+    testScalars<uint32_t>(rng, 0);
+    testScalars<uint64_t>(rng, 0xFFFFFFFF00000000ULL);
+    testScalars<float>(rng, 0.0f);
+    testScalars<double>(rng, 1.5);
+    testObjects(rng);
+    testInvalidInput(rng);
+
+    return test::finish("sparse arrays");
+}
@@ -0,0 +1,69 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file test_support.h
+ * @brief Minimal checking helpers shared by the unit tests.
+ *
+ * Every test is a standalone program: `CHECK` records a failure and carries
+ * on, and `finish()` prints the summary and gives the exit code.
+ */
+
+#ifndef SERDELITE_TEST_SUPPORT_H
+#define SERDELITE_TEST_SUPPORT_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace test {
+
+static int checks = 0;
+static int failures = 0;
+
+inline void report(bool passed, const char* expr, const char* file, int line) {
+    checks++;
+    if (passed) return;
+
+    failures++;
+    fprintf(stderr, "  FAILED: %s (%s:%d)\n", expr, file, line);
+}
+
+// Prints the summary line; returns the process exit code
+inline int finish(const char* name) {
+    printf("[%s] %s: %d checks, %d failed\n",
+           failures == 0 ? "PASS" : "FAIL", name, checks, failures);
+    return failures == 0 ? 0 : 1;
+}
+
+// Deterministic xorshift generator, so every run checks the same inputs
+class Random {
+public:
+    explicit Random(uint64_t seed) : state(seed ? seed : 1) {}
+
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Uniform in [0, bound), bound > 0
+    uint64_t below(uint64_t bound) { return next() % bound; }
+
+    uint8_t byte() { return static_cast<uint8_t>(next() >> 32); }
+
+private:
+    uint64_t state;
+};
+
+} // namespace test
+
+#define CHECK(cond) test::report((cond), #cond, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+#include <serdelite.h>
+#include "test_support.h"
+
+using namespace std;
+using namespace serdelite;
+
+// Stands for memory the buffer has not written
+static const uint8_t UNTOUCHED = 0xEE;
+
+static const ZeroPolicy POLICIES[] = { ZeroPolicy::Full, ZeroPolicy::WrittenPrefix,
+                                       ZeroPolicy::None };
+
+static bool isFilled(const vector<uint8_t>& mem, size_t from, size_t to, uint8_t value) {
+    for (size_t i = from; i < to; i++) {
+        if (mem[i] != value) return false;
+    }
+    return true;
+}
+
+static void addBytes(ByteBuffer& buffer, size_t count, uint8_t value) {
+    for (size_t i = 0; i < count; i++) buffer.addByte(value);
+}
+
+static void testConstruction() {
+    for (ZeroPolicy policy : POLICIES) {
+        vector<uint8_t> mem(64, UNTOUCHED);
+        ByteBuffer buffer(mem.data(), mem.size(), Endian::Little, policy);
+        CHECK(buffer.getZeroPolicy() == policy);
+        CHECK(buffer.getSize() == 0);
+        CHECK(buffer.getEndianOrder() == Endian::Little);
+
+        const uint8_t expected = (policy == ZeroPolicy::Full) ? 0 : UNTOUCHED;
+        CHECK(isFilled(mem, 0, mem.size(), expected));
+    }
+}
+
+// Shrinking through setLength() or clear() hides bytes from the length; the
+// prefix erased afterwards still reaches the longest length ever written
+static void testEraseAfterShrink() {
+    for (ZeroPolicy policy : POLICIES)
+    for (int shrink = 0; shrink < 3; shrink++) {
+        vector<uint8_t> mem(64, UNTOUCHED);
+        ByteBuffer buffer(mem.data(), mem.size(), Endian::Big, policy);
+        memset(mem.data(), UNTOUCHED, mem.size());     // Undo the Full zeroing
+
+        addBytes(buffer, 40, 0x11);
+        switch (shrink) {
+        case 0: CHECK(buffer.setLength(10)); break;
+        case 1: buffer.clear(); break;
+        default: CHECK(buffer.setLength(30)); CHECK(buffer.setLength(5)); break;
+        }
+        addBytes(buffer, 3, 0x22);
+        CHECK(!buffer.setLength(mem.size() + 1));
+
+        buffer.erase();
+        CHECK(buffer.getSize() == 0);
+
+        switch (policy) {
+        case ZeroPolicy::Full:
+            CHECK(isFilled(mem, 0, mem.size(), 0));
+            break;
+        case ZeroPolicy::WrittenPrefix:
+            CHECK(isFilled(mem, 0, 40, 0));
+            CHECK(isFilled(mem, 40, mem.size(), UNTOUCHED));
+            break;
+        case ZeroPolicy::None:
+            CHECK(mem[39] == 0x11 && mem[mem.size() - 1] == UNTOUCHED);
+            break;
+        }
+
+        // The erase starts the count over: only the new writes are zeroed next
+        memset(mem.data(), UNTOUCHED, mem.size());
+        addBytes(buffer, 6, 0x33);
+        buffer.clear();
+        buffer.erase();
+        if (policy == ZeroPolicy::WrittenPrefix) {
+            CHECK(isFilled(mem, 0, 6, 0));
+            CHECK(isFilled(mem, 6, mem.size(), UNTOUCHED));
+        } else if (policy == ZeroPolicy::None) {
+            CHECK(isFilled(mem, 0, 6, 0x33));
+        }
+    }
+}
+
+// Decoders that fail half way leave bytes past the length; they are erased
+static void testEraseAfterFailedDecode() {
+    for (ZeroPolicy policy : POLICIES) {
+        vector<uint8_t> mem(64, UNTOUCHED);
+        ByteBuffer buffer(mem.data(), mem.size(), Endian::Big, policy);
+
+        CHECK(!buffer.fromHex("DEADBEEFCAFEBABE00112233445566778899AABBCCDDEEFFZZ"));
+        CHECK(buffer.getSize() == 0);
+        buffer.erase();
+        if (policy != ZeroPolicy::None) CHECK(isFilled(mem, 0, 24, 0));
+        if (policy == ZeroPolicy::WrittenPrefix) CHECK(isFilled(mem, 24, mem.size(), UNTOUCHED));
+
+        memset(mem.data(), UNTOUCHED, mem.size());
+        CHECK(!buffer.fromBase64("QUJDREVGR0hJSktMTU5PUFFSU1RVVldY!!!!"));
+        CHECK(buffer.getSize() == 0);
+        buffer.erase();
+        if (policy == ZeroPolicy::None) continue;
+        for (uint8_t byte : mem) CHECK(byte == 0 || byte == UNTOUCHED);
+    }
+}
+
+// Random writes, rollbacks and shrinks: with WrittenPrefix, no written byte
+// survives the erase, whether or not the length still covers it
+static void testRandomUse(test::Random& rng) {
+    for (int trial = 0; trial < 500; trial++) {
+        vector<uint8_t> mem(16 + rng.below(200), UNTOUCHED);
+        ByteBuffer buffer(mem.data(), mem.size(), Endian::Big, ZeroPolicy::WrittenPrefix);
+        ByteStream stream(buffer);
+        size_t reached = 0;
+
+        const size_t steps = 1 + rng.below(20);
+        for (size_t step = 0; step < steps; step++) {
+            switch (rng.below(6)) {
+            case 0: stream.writeUint32(static_cast<uint32_t>(rng.next())); break;
+            case 1: stream.writeString(string(rng.below(30), 'a').c_str()); break;
+            case 2: buffer.setLength(rng.below(buffer.getSize() + 1)); break;
+            case 3: buffer.clear(); break;
+            case 4: buffer.fromHex(string(2 * rng.below(40), '1').append("x").c_str()); break;
+            default: {
+                // A JSON write that may not fit and is rolled back
+                JsonStream json(buffer);
+                json.writeString("text", string(rng.below(60), 'b'));
+                json.close();
+                break;
+            }
+            }
+            if (buffer.getSize() > reached) reached = buffer.getSize();
+        }
+
+        buffer.erase();
+        CHECK(buffer.getSize() == 0);
+        CHECK(isFilled(mem, 0, reached, 0));
+        for (uint8_t byte : mem) CHECK(byte == 0 || byte == UNTOUCHED);
+    }
+}
+
+int main() {
+    test::Random rng(123);
+
+    testConstruction();
+    testEraseAfterShrink();
+    testEraseAfterFailedDecode();
+    testRandomUse(rng);
+
+    return test::finish("zero policy");
+}
@@ -0,0 +1,683 @@
+/*
+ * SerDeLite
+ * Copyright (C) 2025 Devansh Seth
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ */
+
+/**
+ * @file sdlc.cpp
+ * @brief SerDeLite schema compiler (host tool).
+ *
+ * Reads a `.sdl` schema and emits a header with one class per message. Every
+ * class derives from `ByteSerializable` and `JsonSerializable`, but its
+ * `encode()` / `decode()` members are plain inline functions specialized for
+ * the message layout: consecutive fixed-size fields are grouped into regions
+ * whose offsets are computed here, and each region costs a single capacity
+ * check at run time. Nested messages are called directly (never virtually).
+ *
+ * Usage: `sdlc <schema.sdl> <output.h>`
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Primitive {
+    const char* name;     // schema keyword
+    const char* cppType;  // member type
+    const char* wireType; // unsigned type stored on the wire
+    size_t size;          // bytes on the wire
+    const char* jsonCall; // JsonStream writer
+};
+
+const Primitive PRIMITIVES[] = {
+    { "bool",   "bool",     "uint8_t",  1, "writeBool"   },
+    { "uint8",  "uint8_t",  "uint8_t",  1, "writeUint8"  },
+    { "uint16", "uint16_t", "uint16_t", 2, "writeUint16" },
+    { "uint32", "uint32_t", "uint32_t", 4, "writeUint32" },
+    { "uint64", "uint64_t", "uint64_t", 8, "writeUint64" },
+    { "int8",   "int8_t",   "uint8_t",  1, "writeInt8"   },
+    { "int16",  "int16_t",  "uint16_t", 2, "writeInt16"  },
+    { "int32",  "int32_t",  "uint32_t", 4, "writeInt32"  },
+    { "int64",  "int64_t",  "uint64_t", 8, "writeInt64"  },
+    { "float",  "float",    "uint32_t", 4, "writeFloat"  },
+    { "double", "double",   "uint64_t", 8, "writeDouble" },
+};
+
+// Member names used by the generated classes
+const char* const RESERVED[] = {
+    "encode", "decode", "encodeAs", "decodeAs", "encodedSize", "store", "load",
+    "toByteStream", "fromByteStream", "byteSize", "toJson", "serializeToJson",
+    "FIXED_SIZE",
+};
+
+struct Message;
+
+struct Field {
+    enum Kind { PRIMITIVE, STRING, MESSAGE };
+
+    std::string name;
+    Kind kind;
+    const Primitive* prim;  // PRIMITIVE
+    size_t maxLength;       // STRING: maximum characters
+    const Message* msg;     // MESSAGE
+    size_t arrayLength;     // 0 for a scalar field
+    int line;
+
+    bool isFixed() const;
+    size_t elementSize() const;
+    size_t fixedSize() const {
+        return elementSize() * (arrayLength ? arrayLength : 1);
+    }
+};
+
+struct Message {
+    std::string name;
+    std::vector<Field> fields;
+    bool fixed;
+    size_t fixedSize;
+};
+
+bool Field::isFixed() const {
+    if (kind == PRIMITIVE) return true;
+    if (kind == MESSAGE) return msg->fixed;
+    return false;
+}
+
+size_t Field::elementSize() const {
+    if (kind == PRIMITIVE) return prim->size;
+    if (kind == MESSAGE) return msg->fixedSize;
+    return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Parsing                                                                 */
+/* ---------------------------------------------------------------------- */
+
+struct Token {
+    std::string text;
+    int line;
+};
+
+class Parser {
+public:
+    Parser(const std::string& src, const std::string& fileName)
+        : file(fileName), pos(0) {
+        tokenize(src);
+    }
+
+    bool parse() {
+        while (pos < tokens.size()) {
+            const Token& tok = tokens[pos];
+            if (tok.text == "namespace") {
+                pos++;
+                if (!expectIdentifier(nameSpace) || !expect(";")) return false;
+            } else if (tok.text == "message") {
+                pos++;
+                if (!parseMessage()) return false;
+            } else {
+                return fail(tok.line, "expected 'message' or 'namespace', got '" +
+                                      tok.text + "'");
+            }
+        }
+        return true;
+    }
+
+    ~Parser() {
+        for (size_t i = 0; i < messages.size(); i++) delete messages[i];
+    }
+
+    std::string nameSpace;
+    std::vector<Message*> messages;
+
+private:
+    std::string file;
+    std::vector<Token> tokens;
+    size_t pos;
+    std::map<std::string, Message*> byName;
+
+    void tokenize(const std::string& src) {
+        int line = 1;
+        size_t i = 0;
+        while (i < src.size()) {
+            char c = src[i];
+            if (c == '\n') {
+                line++;
+                i++;
+            } else if (isspace(static_cast<unsigned char>(c))) {
+                i++;
+            } else if (c == '/' && i + 1 < src.size() && src[i + 1] == '/') {
+                while (i < src.size() && src[i] != '\n') i++;
+            } else if (isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                size_t start = i;
+                while (i < src.size() &&
+                       (isalnum(static_cast<unsigned char>(src[i])) ||
+                        src[i] == '_')) i++;
+                tokens.push_back(Token{ src.substr(start, i - start), line });
+            } else {
+                tokens.push_back(Token{ std::string(1, c), line });
+                i++;
+            }
+        }
+    }
+
+    int currentLine() const {
+        if (pos < tokens.size()) return tokens[pos].line;
+        return tokens.empty() ? 1 : tokens.back().line;
+    }
+
+    bool fail(int line, const std::string& what) {
+        fprintf(stderr, "%s:%d: error: %s\n", file.c_str(), line, what.c_str());
+        return false;
+    }
+
+    bool expect(const char* text) {
+        if (pos >= tokens.size() || tokens[pos].text != text)
+            return fail(currentLine(), std::string("expected '") + text + "'");
+        pos++;
+        return true;
+    }
+
+    bool expectIdentifier(std::string& out) {
+        if (pos >= tokens.size() ||
+            !(isalpha(static_cast<unsigned char>(tokens[pos].text[0])) ||
+              tokens[pos].text[0] == '_'))
+            return fail(currentLine(), "expected an identifier");
+        out = tokens[pos++].text;
+        return true;
+    }
+
+    bool expectNumber(size_t& out) {
+        if (pos >= tokens.size() ||
+            !isdigit(static_cast<unsigned char>(tokens[pos].text[0])))
+            return fail(currentLine(), "expected a number");
+
+        const std::string& text = tokens[pos].text;
+        for (size_t i = 0; i < text.size(); i++) {
+            if (!isdigit(static_cast<unsigned char>(text[i])))
+                return fail(currentLine(), "invalid number '" + text + "'");
+        }
+        out = strtoul(text.c_str(), nullptr, 10);
+        pos++;
+        return true;
+    }
+
+    bool parseMessage() {
+        Message* msg = new Message();
+        msg->fixed = true;
+        msg->fixedSize = 0;
+        messages.push_back(msg);
+
+        int line = currentLine();
+        if (!expectIdentifier(msg->name)) return false;
+        if (byName.count(msg->name))
+            return fail(line, "message '" + msg->name + "' redefined");
+        if (!expect("{")) return false;
+
+        while (pos < tokens.size() && tokens[pos].text != "}") {
+            Field field;
+            if (!parseField(field)) return false;
+
+            for (size_t i = 0; i < msg->fields.size(); i++) {
+                if (msg->fields[i].name == field.name)
+                    return fail(field.line, "field '" + field.name +
+                                            "' redefined");
+            }
+
+            if (field.isFixed()) msg->fixedSize += field.fixedSize();
+            else msg->fixed = false;
+            msg->fields.push_back(field);
+        }
+        if (!expect("}")) return false;
+
+        byName[msg->name] = msg;
+        return true;
+    }
+
+    bool parseField(Field& field) {
+        field.line = currentLine();
+        field.prim = nullptr;
+        field.msg = nullptr;
+        field.maxLength = 0;
+        field.arrayLength = 0;
+
+        std::string type;
+        if (!expectIdentifier(type)) return false;
+
+        if (type == "string") {
+            field.kind = Field::STRING;
+            if (!expect("<") || !expectNumber(field.maxLength) || !expect(">"))
+                return false;
+            if (field.maxLength == 0 || field.maxLength > 0xFFFF)
+                return fail(field.line, "string length must be 1-65535");
+        } else {
+            for (size_t i = 0; i < sizeof(PRIMITIVES) / sizeof(PRIMITIVES[0]); i++) {
+                if (type == PRIMITIVES[i].name) field.prim = &PRIMITIVES[i];
+            }
+            if (field.prim) {
+                field.kind = Field::PRIMITIVE;
+            } else if (byName.count(type)) {
+                field.kind = Field::MESSAGE;
+                field.msg = byName[type];
+            } else {
+                return fail(field.line, "unknown type '" + type +
+                                        "' (messages must be declared before use)");
+            }
+        }
+
+        if (pos < tokens.size() && tokens[pos].text == "[") {
+            pos++;
+            if (!expectNumber(field.arrayLength) || !expect("]")) return false;
+            if (field.arrayLength == 0)
+                return fail(field.line, "array length must be positive");
+            if (field.kind == Field::STRING)
+                return fail(field.line, "arrays of strings are not supported");
+        }
+
+        if (!expectIdentifier(field.name)) return false;
+        for (size_t i = 0; i < sizeof(RESERVED) / sizeof(RESERVED[0]); i++) {
+            if (field.name == RESERVED[i])
+                return fail(field.line, "field name '" + field.name +
+                                        "' is reserved");
+        }
+        return expect(";");
+    }
+};
+
+/* ---------------------------------------------------------------------- */
+/* Code generation                                                         */
+/* ---------------------------------------------------------------------- */
+
+std::string memberType(const Field& f) {
+    std::string elem;
+    if (f.kind == Field::PRIMITIVE) elem = f.prim->cppType;
+    else if (f.kind == Field::MESSAGE) elem = f.msg->name;
+    else return "char";
+
+    if (!f.arrayLength) return elem;
+    std::ostringstream os;
+    os << "std::array<" << elem << ", " << f.arrayLength << ">";
+    return os.str();
+}
+
+std::string storeExpr(const Field& f, const std::string& val,
+                      const std::string& at) {
+    if (f.kind == Field::MESSAGE)
+        return val + ".store<O>(" + at + ")";
+
+    const std::string type = f.prim->name;
+    if (type == "float")
+        return "serdelite::storeFloat<O>(" + at + ", " + val + ")";
+    if (type == "double")
+        return "serdelite::storeDouble<O>(" + at + ", " + val + ")";
+    if (type == "bool")
+        return "serdelite::storeScalar<O>(" + at + ", static_cast<uint8_t>(" +
+               val + " ? 1 : 0))";
+    return "serdelite::storeScalar<O>(" + at + ", static_cast<" +
+           f.prim->wireType + ">(" + val + "))";
+}
+
+std::string loadExpr(const Field& f, const std::string& val,
+                     const std::string& at) {
+    if (f.kind == Field::MESSAGE)
+        return val + ".load<O>(" + at + ")";
+
+    const std::string type = f.prim->name;
+    if (type == "float")
+        return val + " = serdelite::loadFloat<O>(" + at + ")";
+    if (type == "double")
+        return val + " = serdelite::loadDouble<O>(" + at + ")";
+
+    std::string load = std::string("serdelite::loadScalar<O, ") +
+                       f.prim->wireType + ">(" + at + ")";
+    if (type == "bool") return val + " = (" + load + " != 0)";
+    return val + " = static_cast<" + f.prim->cppType + ">(" + load + ")";
+}
+
+std::string offsetExpr(const std::string& base, size_t offset) {
+    if (offset == 0) return base;
+    std::ostringstream os;
+    os << base << " + " << offset;
+    return os.str();
+}
+
+/**
+ * Emits the stores (or loads) of a run of fixed-size fields starting at `p`.
+ */
+void emitFixedRun(std::ostream& out, const std::vector<const Field*>& run,
+                  bool isStore, const char* indent) {
+    size_t offset = 0;
+    for (size_t i = 0; i < run.size(); i++) {
+        const Field& f = *run[i];
+        if (!f.arrayLength) {
+            std::string at = offsetExpr("p", offset);
+            std::string val = "this->" + f.name;
+            out << indent
+                << (isStore ? storeExpr(f, val, at) : loadExpr(f, val, at))
+                << ";\n";
+        } else {
+            std::ostringstream at;
+            at << offsetExpr("p", offset) << " + i*" << f.elementSize();
+            std::string elem = "this->" + f.name + "[i]";
+            out << indent << "for (size_t i = 0; i < " << f.arrayLength
+                << "; i++)\n"
+                << indent << "    "
+                << (isStore ? storeExpr(f, elem, at.str())
+                            : loadExpr(f, elem, at.str()))
+                << ";\n";
+        }
+        offset += f.fixedSize();
+    }
+}
+
+size_t runSize(const std::vector<const Field*>& run) {
+    size_t size = 0;
+    for (size_t i = 0; i < run.size(); i++) size += run[i]->fixedSize();
+    return size;
+}
+
+/** Splits the fields of a message into maximal runs of fixed-size fields. */
+std::vector<std::vector<const Field*> > fixedRuns(const Message& msg,
+                                                  std::vector<const Field*>& order) {
+    std::vector<std::vector<const Field*> > runs;
+    std::vector<const Field*> run;
+    for (size_t i = 0; i < msg.fields.size(); i++) {
+        const Field* f = &msg.fields[i];
+        if (f->isFixed()) {
+            run.push_back(f);
+            continue;
+        }
+        if (!run.empty()) {
+            runs.push_back(run);
+            order.push_back(nullptr);   // placeholder for a region
+            run.clear();
+        }
+        order.push_back(f);
+    }
+    if (!run.empty()) {
+        runs.push_back(run);
+        order.push_back(nullptr);
+    }
+    return runs;
+}
+
+void emitVariableWrite(std::ostream& out, const Field& f) {
+    if (f.kind == Field::STRING) {
+        out << "        {\n"
+            << "            const size_t len = strnlen(this->" << f.name << ", "
+            << f.maxLength << ");\n"
+            << "            p = s.reserveBytes(2 + len);\n"
+            << "            if (!p) return false;\n"
+            << "            serdelite::storeScalar<O>(p, static_cast<uint16_t>(len));\n"
+            << "            memcpy(p + 2, this->" << f.name << ", len);\n"
+            << "        }\n";
+    } else if (!f.arrayLength) {
+        out << "        if (!this->" << f.name << ".encodeAs<O>(s)) return false;\n";
+    } else {
+        out << "        for (size_t i = 0; i < " << f.arrayLength << "; i++) {\n"
+            << "            if (!this->" << f.name
+            << "[i].encodeAs<O>(s)) return false;\n"
+            << "        }\n";
+    }
+}
+
+void emitVariableRead(std::ostream& out, const Field& f) {
+    if (f.kind == Field::STRING) {
+        out << "        if (!s.readString(this->" << f.name << ", sizeof(this->"
+            << f.name << "))) return false;\n";
+    } else if (!f.arrayLength) {
+        out << "        if (!this->" << f.name << ".decodeAs<O>(s)) return false;\n";
+    } else {
+        out << "        for (size_t i = 0; i < " << f.arrayLength << "; i++) {\n"
+            << "            if (!this->" << f.name
+            << "[i].decodeAs<O>(s)) return false;\n"
+            << "        }\n";
+    }
+}
+
+void emitMessage(std::ostream& out, const Message& msg) {
+    std::vector<const Field*> order;
+    std::vector<std::vector<const Field*> > runs = fixedRuns(msg, order);
+
+    out << "class " << msg.name << " : public serdelite::ByteSerializable,\n"
+        << std::string(msg.name.size() + 9, ' ')
+        << "public serdelite::JsonSerializable {\n"
+        << "public:\n";
+
+    for (size_t i = 0; i < msg.fields.size(); i++) {
+        const Field& f = msg.fields[i];
+        out << "    " << memberType(f) << " " << f.name;
+        if (f.kind == Field::STRING) out << "[" << f.maxLength + 1 << "]";
+        out << ";\n";
+    }
+    out << "\n";
+
+    if (msg.fixed)
+        out << "    /** @brief Encoded size of every instance, in bytes. */\n"
+            << "    static const size_t FIXED_SIZE = " << msg.fixedSize << ";\n\n";
+
+    // Constructor: value-initialize every member
+    out << "    " << msg.name << "()";
+    for (size_t i = 0; i < msg.fields.size(); i++)
+        out << (i == 0 ? "\n        : " : ",\n          ")
+            << msg.fields[i].name << "()";
+    out << " {}\n\n";
+
+    // Public entry points
+    out << "    /** @brief Encodes the message in the byte order of the stream. */\n"
+        << "    inline bool encode(serdelite::ByteStream& s) const {\n"
+        << "        return s.getEndianOrder() == serdelite::Endian::Big\n"
+        << "               ? encodeAs<serdelite::Endian::Big>(s)\n"
+        << "               : encodeAs<serdelite::Endian::Little>(s);\n"
+        << "    }\n\n"
+        << "    /** @brief Decodes the message in the byte order of the stream. */\n"
+        << "    inline bool decode(serdelite::ByteStream& s) {\n"
+        << "        return s.getEndianOrder() == serdelite::Endian::Big\n"
+        << "               ? decodeAs<serdelite::Endian::Big>(s)\n"
+        << "               : decodeAs<serdelite::Endian::Little>(s);\n"
+        << "    }\n\n";
+
+    // encodedSize
+    out << "    /** @brief Number of bytes `encode()` writes. */\n"
+        << "    inline size_t encodedSize() const {\n";
+    if (msg.fixed) {
+        out << "        return FIXED_SIZE;\n";
+    } else {
+        size_t constant = 0;
+        for (size_t r = 0; r < runs.size(); r++) constant += runSize(runs[r]);
+        out << "        size_t size = " << constant << ";\n";
+        for (size_t i = 0; i < order.size(); i++) {
+            const Field* f = order[i];
+            if (!f) continue;
+            if (f->kind == Field::STRING) {
+                out << "        size += 2 + strnlen(this->" << f->name << ", "
+                    << f->maxLength << ");\n";
+            } else if (!f->arrayLength) {
+                out << "        size += this->" << f->name << ".encodedSize();\n";
+            } else {
+                out << "        for (size_t i = 0; i < " << f->arrayLength
+                    << "; i++) size += this->" << f->name << "[i].encodedSize();\n";
+            }
+        }
+        out << "        return size;\n";
+    }
+    out << "    }\n\n";
+
+    // encodeAs / decodeAs
+    out << "    template <serdelite::Endian O>\n"
+        << "    inline bool encodeAs(serdelite::ByteStream& s) const {\n";
+    if (msg.fixed) {
+        out << "        uint8_t* p = s.reserveBytes(FIXED_SIZE);\n"
+            << "        if (!p) return false;\n"
+            << "        store<O>(p);\n";
+    } else {
+        out << "        uint8_t* p;\n";
+        size_t r = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            if (order[i]) {
+                emitVariableWrite(out, *order[i]);
+                continue;
+            }
+            out << "        p = s.reserveBytes(" << runSize(runs[r]) << ");\n"
+                << "        if (!p) return false;\n";
+            emitFixedRun(out, runs[r++], true, "        ");
+        }
+    }
+    out << "        return true;\n"
+        << "    }\n\n";
+
+    out << "    template <serdelite::Endian O>\n"
+        << "    inline bool decodeAs(serdelite::ByteStream& s) {\n";
+    if (msg.fixed) {
+        out << "        const uint8_t* p = s.consumeBytes(FIXED_SIZE);\n"
+            << "        if (!p) return false;\n"
+            << "        load<O>(p);\n";
+    } else {
+        out << "        const uint8_t* p;\n";
+        size_t r = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            if (order[i]) {
+                emitVariableRead(out, *order[i]);
+                continue;
+            }
+            out << "        p = s.consumeBytes(" << runSize(runs[r]) << ");\n"
+                << "        if (!p) return false;\n";
+            emitFixedRun(out, runs[r++], false, "        ");
+        }
+    }
+    out << "        return true;\n"
+        << "    }\n\n";
+
+    // Unchecked stores for messages embedded in a parent region
+    if (msg.fixed) {
+        out << "    /** @brief Writes `FIXED_SIZE` bytes at `p` without bounds checks. */\n"
+            << "    template <serdelite::Endian O>\n"
+            << "    inline void store(uint8_t* p) const {\n";
+        if (!runs.empty()) emitFixedRun(out, runs[0], true, "        ");
+        else out << "        (void)p;\n";
+        out << "    }\n\n"
+            << "    /** @brief Reads `FIXED_SIZE` bytes at `p` without bounds checks. */\n"
+            << "    template <serdelite::Endian O>\n"
+            << "    inline void load(const uint8_t* p) {\n";
+        if (!runs.empty()) emitFixedRun(out, runs[0], false, "        ");
+        else out << "        (void)p;\n";
+        out << "    }\n\n";
+    }
+
+    // Serializable interface
+    out << "    bool toByteStream(serdelite::ByteStream& s) const override {\n"
+        << "        return encode(s);\n"
+        << "    }\n\n"
+        << "    bool fromByteStream(serdelite::ByteStream& s) override {\n"
+        << "        return decode(s);\n"
+        << "    }\n\n"
+        << "    size_t byteSize() const override {\n"
+        << "        return encodedSize();\n"
+        << "    }\n\n"
+        << "protected:\n"
+        << "    bool serializeToJson(serdelite::JsonStream& s) const override {\n";
+    if (msg.fields.empty()) {
+        out << "        (void)s;\n"
+            << "        return true;\n";
+    } else {
+        out << "        return ";
+        for (size_t i = 0; i < msg.fields.size(); i++) {
+            const Field& f = msg.fields[i];
+            if (i) out << " &&\n               ";
+
+            const std::string key = "\"" + f.name + "\"";
+            const std::string val = "this->" + f.name;
+            if (f.arrayLength)
+                out << "s.writeArray(" << key << ", " << val << ")";
+            else if (f.kind == Field::STRING)
+                out << "s.writeString(" << key << ", " << val << ")";
+            else if (f.kind == Field::MESSAGE)
+                out << "s.writeObject(" << key << ", " << val << ")";
+            else
+                out << "s." << f.prim->jsonCall << "(" << key << ", "
+                    << val << ")";
+        }
+        out << ";\n";
+    }
+    out << "    }\n"
+        << "};\n\n";
+}
+
+std::string guardFor(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string base = (slash == std::string::npos) ? path : path.substr(slash + 1);
+
+    std::string guard = "SERDELITE_GEN_";
+    for (size_t i = 0; i < base.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(base[i]);
+        guard += isalnum(c) ? static_cast<char>(toupper(c)) : '_';
+    }
+    return guard;
+}
+
+void emitHeader(std::ostream& out, const Parser& parser,
+                const std::string& input, const std::string& output) {
+    const std::string guard = guardFor(output);
+
+    out << "/*\n"
+        << " * Generated by sdlc from " << input << ". Do not edit.\n"
+        << " */\n\n"
+        << "#ifndef " << guard << "\n"
+        << "#define " << guard << "\n\n"
+        << "#include <serdelite.h>\n"
+        << "#include <array>\n"
+        << "#include <stddef.h>\n"
+        << "#include <stdint.h>\n"
+        << "#include <string.h>\n\n";
+
+    if (!parser.nameSpace.empty())
+        out << "namespace " << parser.nameSpace << " {\n\n";
+
+    for (size_t i = 0; i < parser.messages.size(); i++)
+        emitMessage(out, *parser.messages[i]);
+
+    if (!parser.nameSpace.empty())
+        out << "} // namespace " << parser.nameSpace << "\n\n";
+
+    out << "#endif\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <schema.sdl> <output.h>\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        fprintf(stderr, "%s: error: cannot open file\n", argv[1]);
+        return 1;
+    }
+    std::stringstream src;
+    src << in.rdbuf();
+
+    Parser parser(src.str(), argv[1]);
+    if (!parser.parse()) return 1;
+
+    std::ostringstream code;
+    emitHeader(code, parser, argv[1], argv[2]);
+
+    std::ofstream out(argv[2]);
+    if (!out || !(out << code.str())) {
+        fprintf(stderr, "%s: error: cannot write file\n", argv[2]);
+        return 1;
+    }
+    return 0;
+}